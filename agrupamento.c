@@ -0,0 +1,479 @@
+#include "agrupamento.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Maior lista de um processo considerada por dimensão (as listas do arquivo têm poucos itens)
+#define MAX_VALORES_DIMENSAO 64
+
+// Tabela hash de grupos (endereçamento aberto com sondagem linear)
+typedef struct {
+    int *chaves;                    // MAX_DIMENSOES inteiros por posição
+    long unsigned int *contagens;   // 0 marca posição livre
+    long unsigned int capacidade;   // Potência de 2
+    long unsigned int tamanho;
+} TabelaGrupos;
+
+// Disposição do array da agregação densa
+typedef struct {
+    int minimo[MAX_DIMENSOES];
+    long unsigned int passo[MAX_DIMENSOES];
+    long unsigned int celulas;
+} LayoutDenso;
+
+// Parcial calculada por uma thread
+typedef struct {
+    const Processo *processos;
+    long unsigned int inicio;
+    long unsigned int fim;
+    const Dimensao *dimensoes;
+    int num_dimensoes;
+    const LayoutDenso *layout;      // NULL para agregação com tabela hash
+    long unsigned int *celulas;     // Agregação densa
+    TabelaGrupos tabela;            // Agregação com tabela hash
+    int erro;
+} ParcialAgrupamento;
+
+/**
+ * dimensao_nome - Nome da coluna usada na exportação.
+ */
+const char *dimensao_nome(Dimensao dimensao) {
+    switch (dimensao) {
+        case DIM_CLASSE: return "id_classe";
+        case DIM_ASSUNTO: return "id_assunto";
+        case DIM_ANO_ELEICAO: return "ano_eleicao";
+        case DIM_MES: return "mes_ajuizamento";
+        default: return "ano_ajuizamento";
+    }
+}
+
+/**
+ * valores_dimensao - Obtém os valores distintos de uma dimensão para um processo.
+ * 
+ * Um processo com a mesma classe repetida conta uma única vez no grupo, como em `count_id`.
+ * 
+ * Retorna o número de valores escritos em `valores`.
+ */
+static int valores_dimensao(const Processo *processo, Dimensao dimensao, int *valores) {
+    const int *lista;
+    int tamanho;
+
+    switch (dimensao) {
+        case DIM_ANO_ELEICAO:
+            valores[0] = processo->ano_eleicao;
+            return 1;
+        case DIM_MES:
+            valores[0] = processo->data->tm_year * 100 + processo->data->tm_mon;
+            return 1;
+        case DIM_ANO:
+            valores[0] = processo->data->tm_year;
+            return 1;
+        case DIM_CLASSE:
+            lista = processo->classe;
+            tamanho = processo->classe_len;
+            break;
+        default:
+            lista = processo->assunto;
+            tamanho = processo->assunto_len;
+            break;
+    }
+
+    int n = 0;
+    for (int i = 0; i < tamanho && n < MAX_VALORES_DIMENSAO; i++) {
+        int repetido = 0;
+        for (int j = 0; j < n && !repetido; j++) {
+            repetido = valores[j] == lista[i];
+        }
+        if (!repetido) {
+            valores[n++] = lista[i];
+        }
+    }
+    return n;
+}
+
+static unsigned long long hash_chave(const int *chave) {
+    unsigned long long h = 0x9E3779B97F4A7C15ULL;
+    for (int d = 0; d < MAX_DIMENSOES; d++) {
+        h = (h ^ (unsigned int)chave[d]) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+    }
+    return h;
+}
+
+static int tabela_inicializa(TabelaGrupos *tabela, long unsigned int capacidade) {
+    tabela->capacidade = capacidade;
+    tabela->tamanho = 0;
+    tabela->chaves = malloc(capacidade * MAX_DIMENSOES * sizeof(int));
+    tabela->contagens = calloc(capacidade, sizeof(long unsigned int));
+    if (tabela->chaves == NULL || tabela->contagens == NULL) {
+        free(tabela->chaves);
+        free(tabela->contagens);
+        tabela->chaves = NULL;
+        tabela->contagens = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static void tabela_libera(TabelaGrupos *tabela) {
+    free(tabela->chaves);
+    free(tabela->contagens);
+    tabela->chaves = NULL;
+    tabela->contagens = NULL;
+}
+
+static int tabela_soma(TabelaGrupos *tabela, const int *chave, long unsigned int quantidade);
+
+/**
+ * tabela_cresce - Dobra a capacidade da tabela e reinsere os grupos.
+ */
+static int tabela_cresce(TabelaGrupos *tabela) {
+    TabelaGrupos maior;
+    if (tabela_inicializa(&maior, tabela->capacidade * 2) != 0) {
+        return -1;
+    }
+    for (long unsigned int i = 0; i < tabela->capacidade; i++) {
+        if (tabela->contagens[i] != 0) {
+            tabela_soma(&maior, &tabela->chaves[i * MAX_DIMENSOES], tabela->contagens[i]);
+        }
+    }
+    tabela_libera(tabela);
+    *tabela = maior;
+    return 0;
+}
+
+/**
+ * tabela_soma - Soma `quantidade` à contagem do grupo `chave`, criando-o se necessário.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+static int tabela_soma(TabelaGrupos *tabela, const int *chave, long unsigned int quantidade) {
+    long unsigned int mascara = tabela->capacidade - 1;
+    long unsigned int i = (long unsigned int)hash_chave(chave) & mascara;
+
+    while (tabela->contagens[i] != 0) {
+        if (memcmp(&tabela->chaves[i * MAX_DIMENSOES], chave, MAX_DIMENSOES * sizeof(int)) == 0) {
+            tabela->contagens[i] += quantidade;
+            return 0;
+        }
+        i = (i + 1) & mascara;
+    }
+
+    // Mantém a ocupação abaixo de 50%
+    if ((tabela->tamanho + 1) * 2 > tabela->capacidade) {
+        if (tabela_cresce(tabela) != 0) {
+            return -1;
+        }
+        return tabela_soma(tabela, chave, quantidade);
+    }
+    memcpy(&tabela->chaves[i * MAX_DIMENSOES], chave, MAX_DIMENSOES * sizeof(int));
+    tabela->contagens[i] = quantidade;
+    tabela->tamanho++;
+    return 0;
+}
+
+/**
+ * agrega_trecho - Soma os processos de [inicio, fim) na parcial (combinações de todos os valores).
+ */
+static void *agrega_trecho(void *arg) {
+    ParcialAgrupamento *parcial = arg;
+    int valores[MAX_DIMENSOES][MAX_VALORES_DIMENSAO];
+    int quantidades[MAX_DIMENSOES];
+
+    for (long unsigned int r = parcial->inicio; r < parcial->fim && !parcial->erro; r++) {
+        int vazio = 0;
+        for (int d = 0; d < MAX_DIMENSOES; d++) {
+            quantidades[d] = d < parcial->num_dimensoes ?
+                             valores_dimensao(&parcial->processos[r], parcial->dimensoes[d], valores[d]) : 1;
+            if (d >= parcial->num_dimensoes) {
+                valores[d][0] = 0;
+            }
+            vazio |= quantidades[d] == 0;
+        }
+        if (vazio) {
+            continue;
+        }
+
+        // Percorre o produto cartesiano dos valores das dimensões
+        int posicao[MAX_DIMENSOES] = {0};
+        for (;;) {
+            int chave[MAX_DIMENSOES];
+            for (int d = 0; d < MAX_DIMENSOES; d++) {
+                chave[d] = valores[d][posicao[d]];
+            }
+            if (parcial->layout != NULL) {
+                long unsigned int celula = 0;
+                for (int d = 0; d < parcial->num_dimensoes; d++) {
+                    celula += (long unsigned int)((long)chave[d] - parcial->layout->minimo[d]) *
+                              parcial->layout->passo[d];
+                }
+                parcial->celulas[celula]++;
+            } else if (tabela_soma(&parcial->tabela, chave, 1) != 0) {
+                parcial->erro = 1;
+                break;
+            }
+
+            int d = 0;
+            while (d < MAX_DIMENSOES && ++posicao[d] == quantidades[d]) {
+                posicao[d++] = 0;
+            }
+            if (d == MAX_DIMENSOES) {
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * calcula_layout - Decide se a agregação cabe em um array e calcula sua disposição.
+ * 
+ * Uma varredura de mínimo/máximo por dimensão; o array é usado quando o produto das faixas
+ * não passa de `LIMITE_AGRUPAMENTO_DENSO` células.
+ * 
+ * Retorna 1 se a agregação densa deve ser usada ou 0 caso contrário.
+ */
+static int calcula_layout(const Processo *processos, long unsigned int n, const Dimensao *dimensoes,
+                          int num_dimensoes, LayoutDenso *layout) {
+    int valores[MAX_VALORES_DIMENSAO];
+    long unsigned int celulas = 1;
+
+    for (int d = 0; d < num_dimensoes; d++) {
+        int minimo = INT_MAX;
+        int maximo = INT_MIN;
+        for (long unsigned int r = 0; r < n; r++) {
+            int quantidade = valores_dimensao(&processos[r], dimensoes[d], valores);
+            for (int i = 0; i < quantidade; i++) {
+                minimo = valores[i] < minimo ? valores[i] : minimo;
+                maximo = valores[i] > maximo ? valores[i] : maximo;
+            }
+        }
+        if (minimo > maximo) {
+            minimo = maximo = 0;
+        }
+        long unsigned int faixa = (long unsigned int)((long)maximo - minimo) + 1;
+        if (faixa > LIMITE_AGRUPAMENTO_DENSO || celulas * faixa > LIMITE_AGRUPAMENTO_DENSO) {
+            return 0;
+        }
+        layout->minimo[d] = minimo;
+        layout->passo[d] = celulas;
+        celulas *= faixa;
+    }
+    layout->celulas = celulas;
+    return 1;
+}
+
+static int compara_grupos(const void *a, const void *b) {
+    const GrupoContagem *ga = a;
+    const GrupoContagem *gb = b;
+    for (int d = 0; d < MAX_DIMENSOES; d++) {
+        if (ga->chave[d] != gb->chave[d]) {
+            return ga->chave[d] < gb->chave[d] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * agrupa - Conta os processos por combinação de valores de até `MAX_DIMENSOES` atributos.
+ * 
+ * @agrupamento: Estrutura que receberá os grupos.
+ * @processos: Array de processos.
+ * @processos_size: Número de processos.
+ * @dimensoes: Atributos de agrupamento (por exemplo, {DIM_CLASSE, DIM_ANO}).
+ * @num_dimensoes: Número de atributos (1 a `MAX_DIMENSOES`).
+ * @num_threads: Número de threads; se menor ou igual a 0, usa o número de núcleos disponíveis.
+ * 
+ * Todos os grupos são calculados em uma única passagem sobre os processos, em vez de uma
+ * chamada de `count_id` por chave. Nas dimensões de lista (classe e assunto), um processo
+ * entra no grupo de cada valor distinto da lista; em combinações, no de cada par de valores.
+ * Quando as faixas de valores cabem em `LIMITE_AGRUPAMENTO_DENSO` células, cada thread soma em
+ * um array; caso contrário, em uma tabela hash. As parciais das threads são somadas no final.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+int agrupa(Agrupamento *agrupamento, const Processo *processos, long unsigned int processos_size,
+           const Dimensao *dimensoes, int num_dimensoes, int num_threads) {
+    double inicio = agora_segundos();
+
+    memset(agrupamento, 0, sizeof(Agrupamento));
+    if (num_dimensoes < 1 || num_dimensoes > MAX_DIMENSOES) {
+        return -1;
+    }
+    memcpy(agrupamento->dimensoes, dimensoes, (size_t)num_dimensoes * sizeof(Dimensao));
+    agrupamento->num_dimensoes = num_dimensoes;
+
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_threads <= 0) {
+            num_threads = 1;
+        }
+    }
+    if ((long unsigned int)num_threads > processos_size) {
+        num_threads = processos_size > 0 ? (int)processos_size : 1;
+    }
+
+    LayoutDenso layout;
+    agrupamento->denso = calcula_layout(processos, processos_size, dimensoes, num_dimensoes, &layout);
+
+    ParcialAgrupamento *parciais = calloc((size_t)num_threads, sizeof(ParcialAgrupamento));
+    pthread_t *threads = malloc((size_t)num_threads * sizeof(pthread_t));
+    int erro = parciais == NULL || threads == NULL;
+
+    for (int t = 0; t < num_threads && !erro; t++) {
+        ParcialAgrupamento *parcial = &parciais[t];
+        parcial->processos = processos;
+        parcial->inicio = processos_size / (long unsigned int)num_threads * (long unsigned int)t;
+        parcial->fim = t == num_threads - 1 ? processos_size :
+                       processos_size / (long unsigned int)num_threads * (long unsigned int)(t + 1);
+        parcial->dimensoes = dimensoes;
+        parcial->num_dimensoes = num_dimensoes;
+        if (agrupamento->denso) {
+            parcial->layout = &layout;
+            parcial->celulas = calloc(layout.celulas, sizeof(long unsigned int));
+            erro = parcial->celulas == NULL;
+        } else {
+            erro = tabela_inicializa(&parcial->tabela, 1024) != 0;
+        }
+    }
+    if (!erro) {
+        // Se uma thread não puder ser criada, ela e as seguintes rodam na thread atual
+        int criadas = 0;
+        for (int t = 0; t < num_threads; t++) {
+            if (criadas == t && pthread_create(&threads[t], NULL, agrega_trecho, &parciais[t]) == 0) {
+                criadas++;
+            } else {
+                agrega_trecho(&parciais[t]);
+            }
+        }
+        for (int t = 0; t < num_threads; t++) {
+            if (t < criadas) {
+                pthread_join(threads[t], NULL);
+            }
+            erro |= parciais[t].erro;
+        }
+    }
+
+    // Soma as parciais na primeira e extrai os grupos
+    if (!erro && agrupamento->denso) {
+        long unsigned int *total = parciais[0].celulas;
+        for (int t = 1; t < num_threads; t++) {
+            for (long unsigned int c = 0; c < layout.celulas; c++) {
+                total[c] += parciais[t].celulas[c];
+            }
+        }
+        long unsigned int num_grupos = 0;
+        for (long unsigned int c = 0; c < layout.celulas; c++) {
+            num_grupos += total[c] != 0;
+        }
+        agrupamento->grupos = malloc((num_grupos > 0 ? num_grupos : 1) * sizeof(GrupoContagem));
+        erro = agrupamento->grupos == NULL;
+
+        // As células estão em ordem crescente da última dimensão para a primeira; ordena depois
+        for (long unsigned int c = 0; c < layout.celulas && !erro; c++) {
+            if (total[c] == 0) {
+                continue;
+            }
+            GrupoContagem *g = &agrupamento->grupos[agrupamento->num_grupos++];
+            memset(g->chave, 0, sizeof(g->chave));
+            long unsigned int resto = c;
+            for (int d = num_dimensoes - 1; d >= 0; d--) {
+                g->chave[d] = (int)((long)layout.minimo[d] + (long)(resto / layout.passo[d]));
+                resto %= layout.passo[d];
+            }
+            g->contagem = total[c];
+        }
+    } else if (!erro) {
+        TabelaGrupos *total = &parciais[0].tabela;
+        for (int t = 1; t < num_threads && !erro; t++) {
+            for (long unsigned int i = 0; i < parciais[t].tabela.capacidade && !erro; i++) {
+                if (parciais[t].tabela.contagens[i] != 0) {
+                    erro = tabela_soma(total, &parciais[t].tabela.chaves[i * MAX_DIMENSOES],
+                                       parciais[t].tabela.contagens[i]) != 0;
+                }
+            }
+        }
+        agrupamento->grupos = malloc((total->tamanho > 0 ? total->tamanho : 1) * sizeof(GrupoContagem));
+        erro |= agrupamento->grupos == NULL;
+        for (long unsigned int i = 0; i < total->capacidade && !erro; i++) {
+            if (total->contagens[i] != 0) {
+                GrupoContagem *g = &agrupamento->grupos[agrupamento->num_grupos++];
+                memcpy(g->chave, &total->chaves[i * MAX_DIMENSOES], sizeof(g->chave));
+                g->contagem = total->contagens[i];
+            }
+        }
+    }
+    if (!erro) {
+        qsort(agrupamento->grupos, agrupamento->num_grupos, sizeof(GrupoContagem), compara_grupos);
+    }
+
+    for (int t = 0; parciais != NULL && t < num_threads; t++) {
+        free(parciais[t].celulas);
+        tabela_libera(&parciais[t].tabela);
+    }
+    free(parciais);
+    free(threads);
+    if (erro) {
+        agrupamento_libera(agrupamento);
+        return -1;
+    }
+    agrupamento->segundos = agora_segundos() - inicio;
+    return 0;
+}
+
+/**
+ * agrupamento_libera - Libera os grupos de um agrupamento.
+ */
+void agrupamento_libera(Agrupamento *agrupamento) {
+    free(agrupamento->grupos);
+    agrupamento->grupos = NULL;
+    agrupamento->num_grupos = 0;
+}
+
+/**
+ * agrupamento_busca - Obtém a contagem de um grupo por busca binária.
+ * 
+ * @chave: Valores das `num_dimensoes` dimensões, na ordem usada em `agrupa`.
+ * 
+ * Retorna o número de processos do grupo (0 se o grupo não existir).
+ */
+long unsigned int agrupamento_busca(const Agrupamento *agrupamento, const int *chave) {
+    GrupoContagem alvo;
+    memset(alvo.chave, 0, sizeof(alvo.chave));
+    memcpy(alvo.chave, chave, (size_t)agrupamento->num_dimensoes * sizeof(int));
+
+    const GrupoContagem *g = bsearch(&alvo, agrupamento->grupos, agrupamento->num_grupos, sizeof(GrupoContagem),
+                                     compara_grupos);
+    return g != NULL ? g->contagem : 0;
+}
+
+/**
+ * agrupamento_exporta_csv - Grava os grupos em um CSV separado por `;` (uma coluna por dimensão e a contagem).
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+int agrupamento_exporta_csv(const Agrupamento *agrupamento, const char *nome_arquivo) {
+    FILE *arquivo = fopen(nome_arquivo, "w");
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o arquivo para escrita.\n");
+        return -1;
+    }
+
+    for (int d = 0; d < agrupamento->num_dimensoes; d++) {
+        fprintf(arquivo, "%s;", dimensao_nome(agrupamento->dimensoes[d]));
+    }
+    fprintf(arquivo, "quantidade\n");
+    for (long unsigned int i = 0; i < agrupamento->num_grupos; i++) {
+        for (int d = 0; d < agrupamento->num_dimensoes; d++) {
+            fprintf(arquivo, "%d;", agrupamento->grupos[i].chave[d]);
+        }
+        fprintf(arquivo, "%lu\n", agrupamento->grupos[i].contagem);
+    }
+
+    if (fclose(arquivo) != 0) {
+        printf("Erro ao escrever o arquivo %s.\n", nome_arquivo);
+        return -1;
+    }
+    return 0;
+}
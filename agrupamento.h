@@ -0,0 +1,43 @@
+#ifndef AGRUPAMENTO_H
+#define AGRUPAMENTO_H
+
+#include "processo.h"
+
+// Maior número de dimensões combinadas em um agrupamento
+#define MAX_DIMENSOES 3
+
+// Até esse número de células, a agregação usa arrays em vez de tabela hash
+#define LIMITE_AGRUPAMENTO_DENSO ((long unsigned int)1 << 20)
+
+// Atributo pelo qual os processos são agrupados
+typedef enum {
+    DIM_CLASSE = 0,         // Cada id_classe do processo
+    DIM_ASSUNTO = 1,        // Cada id_assunto do processo
+    DIM_ANO_ELEICAO = 2,    // ano_eleicao
+    DIM_MES = 3,            // Mês de data_ajuizamento, como AAAAMM
+    DIM_ANO = 4             // Ano de data_ajuizamento
+} Dimensao;
+
+// Contagem de processos de um grupo
+typedef struct {
+    int chave[MAX_DIMENSOES];       // Valor de cada dimensão (posições além de num_dimensoes valem 0)
+    long unsigned int contagem;     // Número de processos no grupo
+} GrupoContagem;
+
+// Resultado de um agrupamento, com os grupos em ordem crescente de chave
+typedef struct {
+    Dimensao dimensoes[MAX_DIMENSOES];
+    int num_dimensoes;
+    GrupoContagem *grupos;
+    long unsigned int num_grupos;
+    int denso;                      // 1 se a agregação usou arrays, 0 se usou tabela hash
+    double segundos;                // Tempo gasto em `agrupa`
+} Agrupamento;
+
+int agrupa(Agrupamento *agrupamento, const Processo *processos, long unsigned int processos_size,
+           const Dimensao *dimensoes, int num_dimensoes, int num_threads);
+void agrupamento_libera(Agrupamento *agrupamento);
+long unsigned int agrupamento_busca(const Agrupamento *agrupamento, const int *chave);
+int agrupamento_exporta_csv(const Agrupamento *agrupamento, const char *nome_arquivo);
+const char *dimensao_nome(Dimensao dimensao);
+#endif
@@ -0,0 +1,112 @@
+#include "arena.h"
+
+#include <stdlib.h>
+
+// Alinhamento garantido para todas as alocações da arena
+#define ARENA_ALINHAMENTO 8
+
+/**
+ * arena_inicializa - Prepara uma arena vazia.
+ * 
+ * @arena: Ponteiro para a arena a ser inicializada.
+ * @tamanho_bloco: Tamanho de cada bloco em bytes; se 0, usa `ARENA_BLOCO_PADRAO`.
+ * 
+ * Nenhuma memória é reservada até a primeira chamada de `arena_aloca`.
+ */
+void arena_inicializa(Arena *arena, size_t tamanho_bloco) {
+    arena->blocos = NULL;
+    arena->tamanho_bloco = tamanho_bloco > 0 ? tamanho_bloco : ARENA_BLOCO_PADRAO;
+    arena->alocacoes = 0;
+    arena->num_blocos = 0;
+    arena->bytes_reservados = 0;
+}
+
+/**
+ * arena_aloca - Reserva `tamanho` bytes na arena.
+ * 
+ * @arena: Arena de onde a memória será obtida.
+ * @tamanho: Quantidade de bytes.
+ * 
+ * A memória é entregue a partir do bloco atual, alinhada a 8 bytes. Quando o bloco não comporta
+ * o pedido, um novo bloco é obtido com `malloc`; pedidos maiores que o tamanho do bloco recebem
+ * um bloco exclusivo. A memória não pode ser liberada individualmente, apenas com `arena_libera`.
+ * 
+ * Retorna o ponteiro para a memória reservada ou NULL se não houver memória.
+ */
+void *arena_aloca(Arena *arena, size_t tamanho) {
+    size_t alinhado = (tamanho + (ARENA_ALINHAMENTO - 1)) & ~(size_t)(ARENA_ALINHAMENTO - 1);
+    BlocoArena *bloco = arena->blocos;
+
+    if (bloco == NULL || bloco->tamanho - bloco->usado < alinhado) {
+        size_t capacidade = alinhado > arena->tamanho_bloco ? alinhado : arena->tamanho_bloco;
+        BlocoArena *novo = malloc(sizeof(BlocoArena) + capacidade);
+        if (novo == NULL) {
+            return NULL;
+        }
+        novo->tamanho = capacidade;
+        novo->usado = 0;
+
+        if (bloco != NULL && capacidade == alinhado && capacidade != arena->tamanho_bloco) {
+            // Bloco exclusivo: insere após o atual para não desperdiçar o espaço restante dele
+            novo->proximo = bloco->proximo;
+            bloco->proximo = novo;
+        } else {
+            novo->proximo = bloco;
+            arena->blocos = novo;
+        }
+        arena->num_blocos++;
+        arena->bytes_reservados += capacidade;
+        bloco = novo;
+    }
+
+    void *ptr = bloco->dados + bloco->usado;
+    bloco->usado += alinhado;
+    arena->alocacoes++;
+    return ptr;
+}
+
+/**
+ * arena_absorve - Transfere todos os blocos de `origem` para `destino`.
+ * 
+ * @destino: Arena que passa a ser dona da memória.
+ * @origem: Arena que será esvaziada (pode continuar sendo usada depois).
+ * 
+ * Os ponteiros já entregues por `origem` continuam válidos e passam a ser liberados junto com `destino`.
+ */
+void arena_absorve(Arena *destino, Arena *origem) {
+    if (origem->blocos == NULL) {
+        return;
+    }
+
+    // Encadeia os blocos de origem após o bloco atual de destino
+    BlocoArena *ultimo = origem->blocos;
+    while (ultimo->proximo != NULL) {
+        ultimo = ultimo->proximo;
+    }
+    if (destino->blocos != NULL) {
+        ultimo->proximo = destino->blocos->proximo;
+        destino->blocos->proximo = origem->blocos;
+    } else {
+        destino->blocos = origem->blocos;
+    }
+
+    destino->alocacoes += origem->alocacoes;
+    destino->num_blocos += origem->num_blocos;
+    destino->bytes_reservados += origem->bytes_reservados;
+    arena_inicializa(origem, origem->tamanho_bloco);
+}
+
+/**
+ * arena_libera - Libera de uma só vez toda a memória reservada pela arena.
+ * 
+ * @arena: Arena a ser liberada. Fica vazia e pode ser reutilizada.
+ */
+void arena_libera(Arena *arena) {
+    BlocoArena *bloco = arena->blocos;
+    while (bloco != NULL) {
+        BlocoArena *proximo = bloco->proximo;
+        free(bloco);
+        bloco = proximo;
+    }
+    arena_inicializa(arena, arena->tamanho_bloco);
+}
@@ -0,0 +1,30 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include<stddef.h>
+
+// Tamanho padrão de cada bloco da arena (1 MB)
+#define ARENA_BLOCO_PADRAO ((size_t)1 << 20)
+
+// Bloco contíguo de memória de onde as alocações são servidas sequencialmente
+typedef struct BlocoArena {
+    struct BlocoArena *proximo; // Próximo bloco da lista
+    size_t tamanho;             // Capacidade de `dados` em bytes
+    size_t usado;               // Bytes já entregues
+    char dados[];               // Área de alocação
+} BlocoArena;
+
+// Alocador por incremento (bump allocator): libera tudo de uma só vez
+typedef struct {
+    BlocoArena *blocos;             // Lista de blocos (o primeiro é o bloco atual)
+    size_t tamanho_bloco;           // Tamanho dos novos blocos
+    long unsigned int alocacoes;    // Número de alocações atendidas
+    long unsigned int num_blocos;   // Número de blocos obtidos com malloc
+    size_t bytes_reservados;        // Total de bytes reservados em blocos
+} Arena;
+
+void arena_inicializa(Arena *arena, size_t tamanho_bloco);
+void *arena_aloca(Arena *arena, size_t tamanho);
+void arena_absorve(Arena *destino, Arena *origem);
+void arena_libera(Arena *arena);
+#endif
@@ -0,0 +1,543 @@
+/**
+ * bench_suite.c - Mede cada etapa do pipeline sobre bases sintéticas e emite o resultado em JSON.
+ *
+ * Para cada tamanho pedido, gera com `gera_csv_sintetico` um CSV no formato de
+ * processo_043_202409032338.csv e mede: leitura (`read_csv`, `read_csv_paralelo` e a mescla de dois
+ * exportes com os mesmos ids em `read_csv_multiplos`), análise linha
+ * a linha (`parse_line` e `parse_registro`), ordenação (`quicksort` e radix sort de índices),
+ * exportação (`export_csv`), as consultas `count_*` nas formas de registros e colunar e as
+ * consultas por intervalo de datas do índice temporal.
+ * Cada etapa informa tempo de parede, registros/s, alocações e pico de memória residente.
+ * Os contadores da biblioteca (`metricas.h`) ficam ligados e são incluídos por tamanho.
+ *
+ * As alocações são contadas envolvendo malloc/calloc/realloc no link, por isso o programa
+ * precisa ser ligado com `-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc` (ver o Makefile).
+ *
+ * Compilação: make bench_suite
+ * Uso: ./bench_suite [-o saida.json] [-t threads] [-s semente] [-d diretorio] [registros ...]
+ *      (padrão: 10000 e 100000 registros; o JSON vai para a saída padrão)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "processo.h"
+#include "ordenacao.h"
+#include "colunar.h"
+#include "simd.h"
+#include "metricas.h"
+#include "gerador.h"
+#include "indice_temporal.h"
+#include "ingestao.h"
+
+// Indica uma etapa sem resultado numérico a conferir
+#define SEM_RESULTADO (-1L)
+
+// Consultas por intervalo de datas medidas sobre o índice temporal
+#define CONSULTAS_INTERVALO 100000
+
+// Contadores das alocações feitas pelo programa e pela biblioteca
+static long unsigned int total_alocacoes = 0;
+static long unsigned int total_bytes_alocados = 0;
+
+void *__real_malloc(size_t tamanho);
+void *__real_calloc(size_t quantidade, size_t tamanho);
+void *__real_realloc(void *ponteiro, size_t tamanho);
+
+void *__wrap_malloc(size_t tamanho) {
+    __atomic_fetch_add(&total_alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&total_bytes_alocados, tamanho, __ATOMIC_RELAXED);
+    return __real_malloc(tamanho);
+}
+
+void *__wrap_calloc(size_t quantidade, size_t tamanho) {
+    __atomic_fetch_add(&total_alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&total_bytes_alocados, quantidade * tamanho, __ATOMIC_RELAXED);
+    return __real_calloc(quantidade, tamanho);
+}
+
+void *__wrap_realloc(void *ponteiro, size_t tamanho) {
+    __atomic_fetch_add(&total_alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&total_bytes_alocados, tamanho, __ATOMIC_RELAXED);
+    return __real_realloc(ponteiro, tamanho);
+}
+
+// Estado de uma etapa em medição
+typedef struct {
+    double inicio;
+    long unsigned int alocacoes;
+    long unsigned int bytes_alocados;
+} Medicao;
+
+// Saída JSON em construção
+typedef struct {
+    FILE *arquivo;
+    int etapas_escritas;    // Etapas já escritas no conjunto atual (para as vírgulas)
+} SaidaJson;
+
+/**
+ * zera_pico_rss - Reinicia o pico de memória residente do processo (Linux 4.0 ou posterior).
+ *
+ * Retorna 0 em caso de sucesso ou -1 se o pico não puder ser reiniciado; nesse caso o pico
+ * informado passa a ser o do processo inteiro.
+ */
+static int zera_pico_rss(void) {
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f == NULL) {
+        return -1;
+    }
+    int ok = fputs("5", f) >= 0;
+    return fclose(f) == 0 && ok ? 0 : -1;
+}
+
+/**
+ * pico_rss_mb - Retorna o pico de memória residente desde o último `zera_pico_rss`, em MB.
+ */
+static double pico_rss_mb(void) {
+    FILE *f = fopen("/proc/self/status", "r");
+    if (f != NULL) {
+        char linha[256];
+        long unsigned int kb;
+        while (fgets(linha, sizeof(linha), f) != NULL) {
+            if (sscanf(linha, "VmHWM: %lu kB", &kb) == 1) {
+                fclose(f);
+                return (double)kb / 1024.0;
+            }
+        }
+        fclose(f);
+    }
+
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return (double)uso.ru_maxrss / 1024.0;
+}
+
+/**
+ * inicia_etapa - Registra o estado dos contadores e o instante de início de uma etapa.
+ */
+static void inicia_etapa(Medicao *medicao) {
+    zera_pico_rss();
+    medicao->alocacoes = __atomic_load_n(&total_alocacoes, __ATOMIC_RELAXED);
+    medicao->bytes_alocados = __atomic_load_n(&total_bytes_alocados, __ATOMIC_RELAXED);
+    medicao->inicio = agora_segundos();
+}
+
+/**
+ * termina_etapa - Escreve no JSON o tempo, a vazão, as alocações e o pico de memória de uma etapa.
+ *
+ * @saida: Saída JSON.
+ * @medicao: Estado registrado por `inicia_etapa`.
+ * @nome: Nome da etapa.
+ * @registros: Registros processados pela etapa.
+ * @resultado: Resultado da etapa (para conferência entre tamanhos e versões) ou `SEM_RESULTADO`.
+ */
+static void termina_etapa(SaidaJson *saida, const Medicao *medicao, const char *nome, long unsigned int registros,
+                          long int resultado) {
+    double segundos = agora_segundos() - medicao->inicio;
+    long unsigned int alocacoes = __atomic_load_n(&total_alocacoes, __ATOMIC_RELAXED) - medicao->alocacoes;
+    long unsigned int bytes = __atomic_load_n(&total_bytes_alocados, __ATOMIC_RELAXED) - medicao->bytes_alocados;
+
+    fprintf(saida->arquivo, "%s\n        {\"etapa\": \"%s\", \"segundos\": %.6f, \"registros\": %lu, "
+            "\"registros_por_segundo\": %.0f, \"alocacoes\": %lu, \"bytes_alocados\": %lu, \"pico_rss_mb\": %.1f",
+            saida->etapas_escritas > 0 ? "," : "", nome, segundos, registros,
+            (double)registros / (segundos > 0 ? segundos : 1e-9), alocacoes, bytes, pico_rss_mb());
+    if (resultado != SEM_RESULTADO) {
+        fprintf(saida->arquivo, ", \"resultado\": %ld", resultado);
+    }
+    fprintf(saida->arquivo, "}");
+    saida->etapas_escritas++;
+}
+
+/**
+ * separa_linhas - Lê o corpo de um CSV e termina cada linha em '\0', para uso com `parse_line`.
+ *
+ * @nome_arquivo: Arquivo a ser lido.
+ * @conteudo: Receberá o buffer com o arquivo (liberar com `free`).
+ * @linhas: Receberá o array de ponteiros para as linhas (liberar com `free`).
+ *
+ * Retorna o número de linhas ou 0 em caso de erro.
+ */
+static long unsigned int separa_linhas(const char *nome_arquivo, char **conteudo, char ***linhas) {
+    FILE *entrada = fopen(nome_arquivo, "rb");
+    if (entrada == NULL) {
+        return 0;
+    }
+    fseek(entrada, 0, SEEK_END);
+    long tamanho = ftell(entrada);
+    rewind(entrada);
+
+    *conteudo = malloc((size_t)tamanho + 1);
+    if (*conteudo == NULL || fread(*conteudo, 1, (size_t)tamanho, entrada) != (size_t)tamanho) {
+        free(*conteudo);
+        *conteudo = NULL;
+        fclose(entrada);
+        return 0;
+    }
+    fclose(entrada);
+    (*conteudo)[tamanho] = '\0';
+
+    long unsigned int n = 0;
+    for (long i = 0; i < tamanho; i++) {
+        n += (*conteudo)[i] == '\n';
+    }
+    *linhas = malloc((n + 1) * sizeof(char *));
+    if (*linhas == NULL) {
+        free(*conteudo);
+        *conteudo = NULL;
+        return 0;
+    }
+
+    // Pula o cabeçalho
+    char *p = strchr(*conteudo, '\n');
+    p = p != NULL ? p + 1 : *conteudo + tamanho;
+    long unsigned int count = 0;
+    while (*p != '\0') {
+        char *nl = strchr(p, '\n');
+        (*linhas)[count++] = p;
+        if (nl == NULL) {
+            break;
+        }
+        *nl = '\0';
+        p = nl + 1;
+    }
+    return count;
+}
+
+/**
+ * bench_analise - Mede `parse_line` e `parse_registro` sobre as mesmas linhas já em memória.
+ */
+static void bench_analise(SaidaJson *saida, const char *nome_arquivo) {
+    char *conteudo = NULL;
+    char **linhas = NULL;
+    long unsigned int n = separa_linhas(nome_arquivo, &conteudo, &linhas);
+    if (n == 0) {
+        free(linhas);
+        free(conteudo);
+        return;
+    }
+
+    for (int caminho = 0; caminho < 2; caminho++) {
+        Arena arena;
+        Processo processo;
+        Medicao medicao;
+        long int validas = 0;
+
+        arena_inicializa(&arena, 0);
+        inicia_etapa(&medicao);
+        for (long unsigned int i = 0; i < n; i++) {
+            int campos = caminho == 0 ? parse_line(linhas[i], &processo, &arena)
+                                      : parse_registro(linhas[i], linhas[i] + strlen(linhas[i]), &processo, &arena);
+            validas += campos == 6;
+        }
+        termina_etapa(saida, &medicao, caminho == 0 ? "parse_line" : "parse_registro", n, validas);
+        arena_libera(&arena);
+    }
+
+    free(linhas);
+    free(conteudo);
+}
+
+/**
+ * bench_quicksort - Mede o `quicksort` de uma cópia dos registros com o comparador dado.
+ */
+static void bench_quicksort(SaidaJson *saida, const char *nome, const Processo *processos, long unsigned int n,
+                            int (*compara)(const Processo *, const Processo *)) {
+    Processo *copia = malloc(n * sizeof(Processo));
+    if (copia == NULL) {
+        return;
+    }
+    memcpy(copia, processos, n * sizeof(Processo));
+
+    Medicao medicao;
+    inicia_etapa(&medicao);
+    quicksort(copia, 0, (int)n - 1, compara);
+    termina_etapa(saida, &medicao, nome, n, SEM_RESULTADO);
+    free(copia);
+}
+
+/**
+ * bench_intervalos - Mede a construção do índice temporal e consultas de 30 dias em posições aleatórias.
+ *
+ * Na etapa de consulta, `registros` é o número de consultas e `resultado` a soma das contagens.
+ */
+static void bench_intervalos(SaidaJson *saida, const Processo *processos, long unsigned int n, unsigned int semente) {
+    const long long largura = 30 * 86400000LL;
+    IndiceTemporal indice;
+    Medicao medicao;
+
+    inicia_etapa(&medicao);
+    if (n == 0 || indice_temporal_constroi(&indice, processos, n) != 0) {
+        return;
+    }
+    termina_etapa(saida, &medicao, "indice_temporal_constroi", n, SEM_RESULTADO);
+
+    long long menor = indice.timestamps[0];
+    unsigned long long faixa = (unsigned long long)(indice.timestamps[n - 1] - menor) + 1;
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL ^ semente;
+    long int total = 0;
+
+    inicia_etapa(&medicao);
+    for (int q = 0; q < CONSULTAS_INTERVALO; q++) {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        long long inicio = menor + (long long)((estado >> 16) % faixa);
+        total += (long int)indice_temporal_conta(&indice, inicio, inicio + largura);
+    }
+    termina_etapa(saida, &medicao, "indice_temporal_conta_30_dias", CONSULTAS_INTERVALO, total);
+
+    indice_temporal_libera(&indice);
+}
+
+/**
+ * bench_multiplos - Mede a leitura concorrente de dois exportes com os mesmos ids.
+ *
+ * O segundo exporte é gerado com outra semente (mesmos ids, demais campos diferentes) e tem
+ * carimbo mais recente no nome, de modo que todos os seus registros vencem a mescla. Na etapa,
+ * `registros` é o total lido dos dois arquivos e `resultado` o tamanho da base mesclada.
+ */
+static void bench_multiplos(SaidaJson *saida, const char *nome_csv, const char *diretorio, long unsigned int registros,
+                            unsigned int semente, int num_threads) {
+    char nome_recente[512];
+    EstatisticasIngestao stats;
+    Medicao medicao;
+    Processo *processos;
+    Arena arena;
+
+    snprintf(nome_recente, sizeof(nome_recente), "%s/bench_sintetico_%lu_202409032338.csv", diretorio, registros);
+    if (gera_csv_sintetico(nome_recente, registros, semente + 1) != 0) {
+        return;
+    }
+
+    const char *nomes[] = {nome_csv, nome_recente};
+    arena_inicializa(&arena, 0);
+    inicia_etapa(&medicao);
+    long int n = read_csv_multiplos(nomes, 2, &processos, &arena, DUPLICADOS_MAIS_RECENTE, num_threads, &stats);
+    termina_etapa(saida, &medicao, "read_csv_multiplos", stats.linhas, n);
+
+    ingestao_libera_estatisticas(&stats);
+    free(processos);
+    arena_libera(&arena);
+    unlink(nome_recente);
+}
+
+/**
+ * fecha_conjunto - Encerra no JSON o objeto de um conjunto, com os contadores da biblioteca.
+ */
+static void fecha_conjunto(SaidaJson *saida, int erro) {
+    fprintf(saida->arquivo, "\n      ],\n      \"erro\": %s,\n      \"metricas\": ", erro ? "true" : "false");
+    metricas_imprime_json(saida->arquivo);
+    fprintf(saida->arquivo, "    }");
+}
+
+/**
+ * bench_conjunto - Gera uma base sintética de `registros` linhas e mede todas as etapas sobre ela.
+ *
+ * Retorna 0 em caso de sucesso ou -1 se a base não puder ser gerada ou lida.
+ */
+static int bench_conjunto(SaidaJson *saida, const char *diretorio, long unsigned int registros,
+                          unsigned int semente, int num_threads) {
+    char nome_csv[512], nome_exportado[512];
+    Medicao medicao;
+    Processo *processos = NULL;
+    Arena arena;
+
+    snprintf(nome_csv, sizeof(nome_csv), "%s/bench_sintetico_%lu.csv", diretorio, registros);
+    snprintf(nome_exportado, sizeof(nome_exportado), "%s/bench_sintetico_%lu_exportado.csv", diretorio, registros);
+    fprintf(stderr, "Base sintética de %lu registros...\n", registros);
+
+    fprintf(saida->arquivo, "    {\"registros\": %lu, \"etapas\": [", registros);
+    saida->etapas_escritas = 0;
+    metricas_zera();
+
+    inicia_etapa(&medicao);
+    if (gera_csv_sintetico(nome_csv, registros, semente) != 0) {
+        fecha_conjunto(saida, 1);
+        return -1;
+    }
+    termina_etapa(saida, &medicao, "gera_csv_sintetico", registros, SEM_RESULTADO);
+
+    // Leitura sequencial e paralela (a base paralela é descartada)
+    arena_inicializa(&arena, 0);
+    inicia_etapa(&medicao);
+    long unsigned int n = read_csv_paralelo(nome_csv, &processos, &arena, num_threads, NULL);
+    termina_etapa(saida, &medicao, "read_csv_paralelo", n, (long int)n);
+    int lida = processos != NULL && n == registros;
+    free(processos);
+    arena_libera(&arena);
+    if (!lida) {
+        unlink(nome_csv);
+        fecha_conjunto(saida, 1);
+        return -1;
+    }
+
+    arena_inicializa(&arena, 0);
+    inicia_etapa(&medicao);
+    n = read_csv(nome_csv, &processos, &arena);
+    termina_etapa(saida, &medicao, "read_csv", n, (long int)n);
+    if (processos == NULL || n != registros) {
+        free(processos);
+        arena_libera(&arena);
+        unlink(nome_csv);
+        fecha_conjunto(saida, 1);
+        return -1;
+    }
+
+    bench_multiplos(saida, nome_csv, diretorio, registros, semente, num_threads);
+    bench_analise(saida, nome_csv);
+
+    // Ordenação
+    bench_quicksort(saida, "quicksort_id", processos, n, compara_id);
+    bench_quicksort(saida, "quicksort_data", processos, n, compara_data);
+
+    long unsigned int *indices = malloc(n * sizeof(long unsigned int));
+    if (indices != NULL) {
+        inicia_etapa(&medicao);
+        ordena_indices_por_data(processos, n, indices, ORDEM_DECRESCENTE);
+        termina_etapa(saida, &medicao, "ordena_indices_por_data", n, SEM_RESULTADO);
+        free(indices);
+    }
+
+    inicia_etapa(&medicao);
+    ordena_paralelo(processos, n, compara_id, num_threads);
+    termina_etapa(saida, &medicao, "ordena_paralelo_id", n, SEM_RESULTADO);
+
+    // Exportação
+    inicia_etapa(&medicao);
+    export_csv(nome_exportado, &processos, 0, n);
+    termina_etapa(saida, &medicao, "export_csv", n, SEM_RESULTADO);
+    unlink(nome_exportado);
+
+    // Consultas sobre os registros (o último id exige percorrer a base inteira em count_dias)
+    int id_classe = 12553;
+    int id_processo = processos[n - 1].id;
+
+    inicia_etapa(&medicao);
+    int resultado = count_id(processos, n, id_classe);
+    termina_etapa(saida, &medicao, "count_id", n, resultado);
+
+    inicia_etapa(&medicao);
+    long unsigned int assuntos = count_assuntos(processos, n);
+    termina_etapa(saida, &medicao, "count_assuntos", n, (long int)assuntos);
+
+    inicia_etapa(&medicao);
+    resultado = mais_de_um_assunto(processos, n);
+    termina_etapa(saida, &medicao, "mais_de_um_assunto", n, resultado);
+
+    // O número de dias depende da data atual; só o código de erro é comparável entre execuções
+    inicia_etapa(&medicao);
+    resultado = count_dias(processos, n, id_processo);
+    termina_etapa(saida, &medicao, "count_dias", n, resultado >= 0 ? 0 : resultado);
+
+    // Consultas sobre a forma colunar
+    ProcessosColunar colunar;
+    inicia_etapa(&medicao);
+    if (colunar_constroi(processos, n, &colunar) == 0) {
+        termina_etapa(saida, &medicao, "colunar_constroi", n, SEM_RESULTADO);
+
+        inicia_etapa(&medicao);
+        resultado = count_id_colunar(&colunar, id_classe);
+        termina_etapa(saida, &medicao, "count_id_colunar", n, resultado);
+
+        inicia_etapa(&medicao);
+        assuntos = count_assuntos_colunar(&colunar);
+        termina_etapa(saida, &medicao, "count_assuntos_colunar", n, (long int)assuntos);
+
+        inicia_etapa(&medicao);
+        resultado = mais_de_um_assunto_colunar(&colunar);
+        termina_etapa(saida, &medicao, "mais_de_um_assunto_colunar", n, resultado);
+
+        colunar_libera(&colunar);
+    }
+
+    bench_intervalos(saida, processos, n, semente);
+
+    fecha_conjunto(saida, 0);
+    free(processos);
+    arena_libera(&arena);
+    unlink(nome_csv);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *nome_saida = NULL;
+    const char *diretorio = ".";
+    unsigned int semente = 42;
+    int num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    long unsigned int tamanhos_padrao[] = {10000, 100000};
+    long unsigned int *tamanhos = NULL;
+    int num_tamanhos = 0;
+    int opcao;
+
+    while ((opcao = getopt(argc, argv, "o:t:s:d:")) != -1) {
+        switch (opcao) {
+        case 'o':
+            nome_saida = optarg;
+            break;
+        case 't':
+            num_threads = atoi(optarg);
+            break;
+        case 's':
+            semente = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'd':
+            diretorio = optarg;
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-o saida.json] [-t threads] [-s semente] [-d diretorio] [registros ...]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (num_threads <= 0) {
+        num_threads = 1;
+    }
+
+    if (optind < argc) {
+        tamanhos = malloc((size_t)(argc - optind) * sizeof(long unsigned int));
+        if (tamanhos == NULL) {
+            return 1;
+        }
+        for (int i = optind; i < argc; i++) {
+            long unsigned int registros = strtoul(argv[i], NULL, 10);
+            if (registros > 0) {
+                tamanhos[num_tamanhos++] = registros;
+            }
+        }
+    } else {
+        num_tamanhos = (int)(sizeof(tamanhos_padrao) / sizeof(tamanhos_padrao[0]));
+    }
+
+    SaidaJson saida = { .arquivo = stdout, .etapas_escritas = 0 };
+    if (nome_saida != NULL) {
+        saida.arquivo = fopen(nome_saida, "w");
+        if (saida.arquivo == NULL) {
+            fprintf(stderr, "Erro ao abrir o arquivo %s.\n", nome_saida);
+            free(tamanhos);
+            return 1;
+        }
+    }
+
+    metricas_ativa(1);
+    fprintf(saida.arquivo, "{\n  \"semente\": %u,\n  \"threads\": %d,\n  \"simd\": \"%s\",\n  \"conjuntos\": [\n",
+            semente, num_threads, simd_nome(simd_detecta()));
+
+    int erro = 0;
+    for (int i = 0; i < num_tamanhos && !erro; i++) {
+        if (i > 0) {
+            fprintf(saida.arquivo, ",\n");
+        }
+        long unsigned int registros = tamanhos != NULL ? tamanhos[i] : tamanhos_padrao[i];
+        if (bench_conjunto(&saida, diretorio, registros, semente, num_threads) != 0) {
+            fprintf(stderr, "Erro ao medir a base de %lu registros.\n", registros);
+            erro = 1;
+        }
+    }
+    fprintf(saida.arquivo, "\n  ]\n}\n");
+
+    if (saida.arquivo != stdout) {
+        fclose(saida.arquivo);
+    }
+    free(tamanhos);
+    return erro;
+}
@@ -0,0 +1,1691 @@
+/**
+ * benchmark.c - Mede o desempenho das etapas da base de processos.
+ * 
+ * O arquivo de entrada é replicado até atingir o tamanho desejado e lido com
+ * `read_csv_paralelo` usando de 1 até N threads (dobrando a cada passo). A base
+ * carregada é então usada para medir as ordenações. Antes da carga, as consultas agregadas
+ * são respondidas em fluxo (`fluxo_executa`) para medir o pico de memória sem a base.
+ * 
+ * Compilação: make benchmark (ou gcc -O2 -pthread -o benchmark benchmark.c processo.c arena.c ordenacao.c \
+ *             conjunto.c fluxo.c ordenacao_externa.c colunar.c simd.c agrupamento.c incremental.c indice.c \
+ *             snapshot.c metricas.c indice_temporal.c ingestao.c -lm)
+ * Uso: ./benchmark [arquivo.csv] [tamanho_mb] [max_threads]
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "processo.h"
+#include "ordenacao.h"
+#include "fluxo.h"
+#include "ordenacao_externa.h"
+#include "colunar.h"
+#include "conjunto.h"
+#include "simd.h"
+#include "agrupamento.h"
+#include "incremental.h"
+#include "indice_temporal.h"
+#include "indice.h"
+#include "ingestao.h"
+
+/**
+ * replica_csv - Gera um CSV com o cabeçalho de `origem` e o corpo repetido até `tamanho_alvo` bytes.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int replica_csv(const char *origem, const char *destino, long unsigned int tamanho_alvo) {
+    FILE *entrada = fopen(origem, "rb");
+    if (entrada == NULL) {
+        return -1;
+    }
+
+    fseek(entrada, 0, SEEK_END);
+    long tamanho = ftell(entrada);
+    rewind(entrada);
+    char *conteudo = malloc((size_t)tamanho);
+    if (conteudo == NULL || fread(conteudo, 1, (size_t)tamanho, entrada) != (size_t)tamanho) {
+        free(conteudo);
+        fclose(entrada);
+        return -1;
+    }
+    fclose(entrada);
+
+    FILE *saida = fopen(destino, "wb");
+    if (saida == NULL) {
+        free(conteudo);
+        return -1;
+    }
+
+    // Separa o cabeçalho do corpo
+    char *corpo = memchr(conteudo, '\n', (size_t)tamanho);
+    corpo = corpo != NULL ? corpo + 1 : conteudo + tamanho;
+    size_t tamanho_cabecalho = (size_t)(corpo - conteudo);
+    size_t tamanho_corpo = (size_t)tamanho - tamanho_cabecalho;
+
+    fwrite(conteudo, 1, tamanho_cabecalho, saida);
+    long unsigned int escrito = tamanho_cabecalho;
+    while (escrito < tamanho_alvo && tamanho_corpo > 0) {
+        fwrite(corpo, 1, tamanho_corpo, saida);
+        escrito += tamanho_corpo;
+    }
+
+    fclose(saida);
+    free(conteudo);
+    return 0;
+}
+
+/**
+ * pico_rss_mb - Retorna o pico de memória residente do processo, em MB.
+ */
+static double pico_rss_mb(void) {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return (double)uso.ru_maxrss / 1024.0;
+}
+
+/**
+ * agora - Retorna o instante atual de um relógio monotônico, em segundos.
+ */
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * processos_iguais - Compara todos os campos preenchidos pela análise de uma linha.
+ */
+static int processos_iguais(const Processo *a, const Processo *b) {
+    if (a->id != b->id || a->ano_eleicao != b->ano_eleicao || a->timestamp != b->timestamp ||
+        !numero_iguais(&a->numero, &b->numero) || strcmp(a->data_string, b->data_string) != 0 ||
+        strcmp(a->classe_string, b->classe_string) != 0 || strcmp(a->assunto_string, b->assunto_string) != 0 ||
+        a->classe_len != b->classe_len || a->assunto_len != b->assunto_len ||
+        memcmp(a->data, b->data, sizeof(struct tm)) != 0) {
+        return 0;
+    }
+    return memcmp(a->classe, b->classe, (size_t)a->classe_len * sizeof(int)) == 0 &&
+           memcmp(a->assunto, b->assunto, (size_t)a->assunto_len * sizeof(int)) == 0;
+}
+
+/**
+ * confere_linha - Analisa `linha` com `parse_line` e `parse_registro` e compara os resultados.
+ * 
+ * Retorna 1 se ambos aceitarem a linha com os mesmos valores ou ambos a rejeitarem.
+ */
+static int confere_linha(const char *linha, size_t tamanho, Arena *arena) {
+    Processo referencia, rapido;
+    int campos_referencia = parse_line(linha, &referencia, arena);
+    int campos_rapido = parse_registro(linha, linha + tamanho, &rapido, arena);
+
+    if (campos_referencia != 6 || campos_rapido != 6) {
+        return (campos_referencia == 6) == (campos_rapido == 6);
+    }
+    return processos_iguais(&referencia, &rapido);
+}
+
+/**
+ * aleatorio - Gerador xorshift64 (determinístico, para que o fuzz seja reproduzível).
+ */
+static unsigned long long aleatorio(void) {
+    static unsigned long long estado = 0x9E3779B97F4A7C15ULL;
+    estado ^= estado << 13;
+    estado ^= estado >> 7;
+    estado ^= estado << 17;
+    return estado;
+}
+
+/**
+ * gera_lista - Escreve uma lista de 1 a 4 itens, com ou sem aspas e, às vezes, com espaços.
+ */
+static char *gera_lista(char *p) {
+    int aspas = aleatorio() % 2;
+    int itens = 1 + (int)(aleatorio() % 4);
+
+    p += aspas ? sprintf(p, "\"{") : sprintf(p, "{");
+    for (int i = 0; i < itens; i++) {
+        const char *separador = i == 0 ? "" : aleatorio() % 16 == 0 ? ", " : ",";
+        p += sprintf(p, "%s%u", separador, (unsigned int)(aleatorio() % 100000));
+    }
+    p += aspas ? sprintf(p, "}\"") : sprintf(p, "}");
+    return p;
+}
+
+/**
+ * gera_linha_fuzz - Gera uma linha válida com variações de formato.
+ * 
+ * A maioria das linhas segue o formato fixo do arquivo (caminho rápido); algumas têm id
+ * negativo ou longo, espaços nas listas ou data sem milissegundos (caminho geral).
+ */
+static size_t gera_linha_fuzz(char *linha) {
+    char *p = linha;
+    unsigned long long variacao = aleatorio() % 32;
+    int digitos_id = 1 + (int)(aleatorio() % 10);
+    long long id = 0;
+
+    for (int i = 0; i < digitos_id; i++) {
+        id = id * 10 + (long long)(aleatorio() % 10);
+    }
+    if (id > 2147483647LL) {
+        id %= 2147483647LL;
+    }
+    p += sprintf(p, "%s%lld,\"", variacao == 0 ? "-" : "", id);
+    for (int i = 0; i < 20; i++) {
+        *p++ = (char)('0' + aleatorio() % 10);
+    }
+    p += sprintf(p, "\",%04u-%02u-%02u %02u:%02u:%02u", (unsigned int)(1990 + aleatorio() % 40),
+                 (unsigned int)(1 + aleatorio() % 12), (unsigned int)(1 + aleatorio() % 28),
+                 (unsigned int)(aleatorio() % 24), (unsigned int)(aleatorio() % 60),
+                 (unsigned int)(aleatorio() % 60));
+    if (variacao != 1) {
+        p += sprintf(p, ".%03u", (unsigned int)(aleatorio() % 1000));
+    }
+    *p++ = ',';
+    p = gera_lista(p);
+    *p++ = ',';
+    p = gera_lista(p);
+    p += sprintf(p, ",%u\r", aleatorio() % 2 ? 0u : (unsigned int)(1990 + aleatorio() % 40));
+    *p = '\0';
+    return (size_t)(p - linha);
+}
+
+/**
+ * bench_parser - Confere `parse_registro` contra `parse_line` e compara a vazão dos dois.
+ * 
+ * Faz as vezes do teste de equivalência: toda linha do arquivo original e linhas geradas
+ * aleatoriamente (`AMOSTRA_FUZZ`) devem produzir os mesmos valores de `Processo` nos dois caminhos.
+ */
+static void bench_parser(const char *arquivo) {
+    const long unsigned int AMOSTRA_FUZZ = 200000;
+    FILE *f = fopen(arquivo, "rb");
+    if (f == NULL) {
+        printf("Erro ao abrir o arquivo.\n");
+        return;
+    }
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *texto = malloc((size_t)tamanho + 1);
+    size_t lido = fread(texto, 1, (size_t)tamanho, f);
+    fclose(f);
+    texto[lido] = '\0';
+
+    // Separa as linhas (sem o cabeçalho), terminando cada uma em '\0' para `parse_line`
+    long unsigned int num_linhas = 0;
+    char **linhas = malloc((lido / 32 + 1) * sizeof(char *));
+    size_t *tamanhos = malloc((lido / 32 + 1) * sizeof(size_t));
+    char *p = strchr(texto, '\n');
+    while (p != NULL && *++p != '\0') {
+        char *nl = strchr(p, '\n');
+        linhas[num_linhas] = p;
+        tamanhos[num_linhas] = nl != NULL ? (size_t)(nl - p) : strlen(p);
+        num_linhas++;
+        if (nl != NULL) {
+            *nl = '\0';
+        }
+        p = nl;
+    }
+
+    Arena arena;
+    arena_inicializa(&arena, 0);
+    long unsigned int divergencias = 0;
+    for (long unsigned int i = 0; i < num_linhas; i++) {
+        divergencias += !confere_linha(linhas[i], tamanhos[i], &arena);
+    }
+    long unsigned int divergencias_fuzz = 0;
+    char linha[256];
+    for (long unsigned int i = 0; i < AMOSTRA_FUZZ; i++) {
+        size_t n = gera_linha_fuzz(linha);
+        divergencias_fuzz += !confere_linha(linha, n, &arena);
+        if (i % 10000 == 0) {
+            arena_libera(&arena);
+            arena_inicializa(&arena, 0);
+        }
+    }
+
+    printf("\nAnálise de linhas (%lu linhas do arquivo, %lu linhas aleatórias)\n", num_linhas, AMOSTRA_FUZZ);
+    printf("  divergências em relação a parse_line: %lu no arquivo, %lu no fuzz\n", divergencias,
+        divergencias_fuzz);
+
+    printf("%-16s | %-10s | %-14s | %-8s\n", "Analisador", "Tempo (s)", "Linhas/s", "Speedup");
+    printf("---------------------------------------------------------\n");
+    Processo processo;
+    double segundos_referencia = 0.0;
+    for (int caminho = 0; caminho < 2; caminho++) {
+        arena_libera(&arena);
+        arena_inicializa(&arena, 0);
+        double inicio = agora();
+        for (long unsigned int i = 0; i < num_linhas; i++) {
+            if (caminho == 0) {
+                parse_line(linhas[i], &processo, &arena);
+            } else {
+                parse_registro(linhas[i], linhas[i] + tamanhos[i], &processo, &arena);
+            }
+        }
+        double segundos = agora() - inicio;
+        if (caminho == 0) {
+            segundos_referencia = segundos;
+        }
+        printf("%-16s | %-10.3f | %-14.0f | %-8.1f\n", caminho == 0 ? "parse_line" : "parse_registro", segundos,
+            (double)num_linhas / segundos, segundos_referencia / segundos);
+    }
+
+    arena_libera(&arena);
+    free(linhas);
+    free(tamanhos);
+    free(texto);
+}
+
+/**
+ * bench_leitura - Lê o arquivo com 1, 2, 4, ... até `max_threads` threads e imprime a vazão.
+ */
+static void bench_leitura(const char *arquivo, int max_threads) {
+    printf("%-8s | %-12s | %-10s | %-14s | %-10s | %-7s | %-10s | %-8s\n",
+        "Threads", "Registros", "Tempo (s)", "Registros/s", "MB/s", "Speedup", "Alocações", "Blocos");
+    printf("--------------------------------------------------------------------------------------------------\n");
+
+    double tempo_base = 0;
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > max_threads) {
+            threads = max_threads;
+        }
+
+        Processo *processos;
+        EstatisticasLeitura stats;
+        Arena arena;
+        arena_inicializa(&arena, 0);
+        long unsigned int qnt_processos = read_csv_paralelo(arquivo, &processos, &arena, threads, &stats);
+        if (threads == 1) {
+            tempo_base = stats.segundos;
+        }
+
+        printf("%-8d | %-12lu | %-10.3f | %-14.0f | %-10.1f | %-7.2f | %-10lu | %-8lu\n",
+            threads,
+            qnt_processos,
+            stats.segundos,
+            (double)stats.linhas / stats.segundos,
+            (double)stats.bytes / stats.segundos / (1024.0 * 1024.0),
+            tempo_base / stats.segundos,
+            arena.alocacoes,
+            arena.num_blocos);
+
+        arena_libera(&arena);
+        free(processos);
+        if (threads == max_threads) {
+            break;
+        }
+    }
+}
+
+/**
+ * compara_data_mktime - Comparador de data anterior ao timestamp pré-calculado.
+ * 
+ * Converte as duas datas com `mktime` a cada comparação; mantido apenas como referência.
+ */
+static int compara_data_mktime(const Processo *a, const Processo *b) {
+    struct tm ta = *a->data;
+    struct tm tb = *b->data;
+
+    ta.tm_year -= 1900;
+    ta.tm_mon -= 1;
+    ta.tm_isdst = -1;
+    tb.tm_year -= 1900;
+    tb.tm_mon -= 1;
+    tb.tm_isdst = -1;
+
+    return (int) difftime(mktime(&tb), mktime(&ta));
+}
+
+/**
+ * tempo_quicksort - Ordena uma cópia de `processos` com `compara` e retorna o tempo em segundos.
+ */
+static double tempo_quicksort(const Processo *processos, long unsigned int n,
+                              int (*compara)(const Processo *, const Processo *)) {
+    Processo *copia = malloc(n * sizeof(Processo));
+    memcpy(copia, processos, n * sizeof(Processo));
+
+    double inicio = agora();
+    quicksort(copia, 0, (int)n - 1, compara);
+    double segundos = agora() - inicio;
+
+    free(copia);
+    return segundos;
+}
+
+/**
+ * bench_ordenacao_data - Compara a ordenação por data com `mktime` e com o timestamp pré-calculado.
+ */
+static void bench_ordenacao_data(const Processo *processos, long unsigned int n) {
+    double t_mktime = tempo_quicksort(processos, n, compara_data_mktime);
+    double t_timestamp = tempo_quicksort(processos, n, compara_data);
+
+    printf("\nOrdenação por data (quicksort, %lu registros)\n", n);
+    printf("%-22s | %-10s\n", "Comparador", "Tempo (s)");
+    printf("-------------------------------------\n");
+    printf("%-22s | %-10.3f\n", "mktime por comparação", t_mktime);
+    printf("%-22s | %-10.3f\n", "timestamp", t_timestamp);
+    printf("Speedup: %.1fx\n", t_mktime / t_timestamp);
+}
+
+/**
+ * tempo_radix - Ordena uma cópia de `processos` com o radix sort de índices.
+ * 
+ * @t_indices: Recebe o tempo (s) da extração das chaves e da ordenação dos índices.
+ * @t_permutacao: Recebe o tempo (s) da aplicação da permutação aos registros.
+ */
+static void tempo_radix(const Processo *processos, long unsigned int n,
+                        int (*ordena)(const Processo *, long unsigned int, long unsigned int *, Ordem), Ordem ordem,
+                        double *t_indices, double *t_permutacao) {
+    Processo *copia = malloc(n * sizeof(Processo));
+    long unsigned int *indices = malloc(n * sizeof(long unsigned int));
+    memcpy(copia, processos, n * sizeof(Processo));
+
+    double inicio = agora();
+    ordena(copia, n, indices, ordem);
+    *t_indices = agora() - inicio;
+
+    inicio = agora();
+    aplica_permutacao(copia, indices, n);
+    *t_permutacao = agora() - inicio;
+
+    free(indices);
+    free(copia);
+}
+
+/**
+ * bench_radix - Compara o quicksort com o radix sort de índices nas chaves usadas por `main.c`.
+ */
+static void bench_radix(const Processo *processos, long unsigned int n) {
+    const char *nomes[2] = { "id", "data" };
+    int (*comparadores[2])(const Processo *, const Processo *) = { compara_id, compara_data };
+    int (*ordenadores[2])(const Processo *, long unsigned int, long unsigned int *, Ordem) = {
+        ordena_indices_por_id,
+        ordena_indices_por_data
+    };
+    Ordem ordens[2] = { ORDEM_CRESCENTE, ORDEM_DECRESCENTE };
+
+    printf("\nQuicksort x radix sort (%lu registros)\n", n);
+    printf("%-6s | %-13s | %-13s | %-15s | %-7s\n",
+        "Chave", "Quicksort (s)", "Índices (s)", "Permutação (s)", "Speedup");
+    printf("---------------------------------------------------------------------\n");
+    for (int k = 0; k < 2; k++) {
+        double t_quicksort = tempo_quicksort(processos, n, comparadores[k]);
+        double t_indices, t_permutacao;
+        tempo_radix(processos, n, ordenadores[k], ordens[k], &t_indices, &t_permutacao);
+
+        // O speedup compara apenas a ordenação: o radix sort não precisa mover os registros
+        printf("%-6s | %-13.3f | %-13.3f | %-15.3f | %-7.1f\n",
+            nomes[k], t_quicksort, t_indices, t_permutacao, t_quicksort / t_indices);
+    }
+}
+
+/**
+ * bench_ordenacao_paralela - Mede a escalabilidade de `ordena_paralelo` e confere o resultado.
+ * 
+ * A referência é o radix sort de índices, que também é estável: as duas ordenações devem
+ * produzir exatamente a mesma sequência de registros.
+ */
+static void bench_ordenacao_paralela(const Processo *processos, long unsigned int n, int max_threads) {
+    long unsigned int *referencia = malloc(n * sizeof(long unsigned int));
+    Processo *copia = malloc(n * sizeof(Processo));
+
+    ordena_indices_por_data(processos, n, referencia, ORDEM_DECRESCENTE);
+
+    printf("\nOrdenação paralela por data (merge sort, %lu registros)\n", n);
+    printf("%-8s | %-10s | %-14s | %-7s | %-9s\n", "Threads", "Tempo (s)", "Registros/s", "Speedup", "Resultado");
+    printf("-------------------------------------------------------------\n");
+
+    double tempo_base = 0;
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > max_threads) {
+            threads = max_threads;
+        }
+
+        memcpy(copia, processos, n * sizeof(Processo));
+        double inicio = agora();
+        ordena_paralelo(copia, n, compara_data, threads);
+        double segundos = agora() - inicio;
+        if (threads == 1) {
+            tempo_base = segundos;
+        }
+
+        // Confere registro a registro contra a ordenação estável de referência
+        int identico = 1;
+        for (long unsigned int i = 0; i < n && identico; i++) {
+            identico = memcmp(&copia[i], &processos[referencia[i]], sizeof(Processo)) == 0;
+        }
+
+        printf("%-8d | %-10.3f | %-14.0f | %-7.2f | %-9s\n",
+            threads, segundos, (double)n / segundos, tempo_base / segundos, identico ? "idêntico" : "DIFERENTE");
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    free(copia);
+    free(referencia);
+}
+
+/**
+ * export_csv_fprintf - Exportação anterior, com um `fprintf` por registro (referência).
+ */
+static void export_csv_fprintf(const char *nome_arquivo, const Processo *processos, long unsigned int n) {
+    FILE *file = fopen(nome_arquivo, "w");
+    if (file == NULL) {
+        return;
+    }
+    fprintf(file, "id;numero;data_ajuizamento;id_classe;id_assunto;ano_eleicao\n");
+    for (long unsigned int i = 0; i < n; i++) {
+        char numero[NUMERO_MAX_TEXTO + 1];
+        numero_para_texto(&processos[i].numero, numero);
+        fprintf(file, "%d,\"%s\",%s,\"{%s}\",\"{%s}\",%d\n",
+                processos[i].id,
+                numero,
+                processos[i].data_string,
+                processos[i].classe_string,
+                processos[i].assunto_string,
+                processos[i].ano_eleicao);
+    }
+    fclose(file);
+}
+
+/**
+ * tamanho_arquivo - Retorna o tamanho de um arquivo em bytes (0 se não existir).
+ */
+static long unsigned int tamanho_arquivo(const char *nome_arquivo) {
+    struct stat st;
+    return stat(nome_arquivo, &st) == 0 ? (long unsigned int)st.st_size : 0;
+}
+
+/**
+ * arquivos_iguais - Compara dois arquivos byte a byte.
+ */
+static int arquivos_iguais(const char *a, const char *b) {
+    FILE *fa = fopen(a, "rb");
+    FILE *fb = fopen(b, "rb");
+    int iguais = fa != NULL && fb != NULL;
+    char ba[65536], bb[65536];
+
+    while (iguais) {
+        size_t na = fread(ba, 1, sizeof(ba), fa);
+        size_t nb = fread(bb, 1, sizeof(bb), fb);
+        iguais = na == nb && memcmp(ba, bb, na) == 0;
+        if (na == 0) {
+            break;
+        }
+    }
+    if (fa != NULL) {
+        fclose(fa);
+    }
+    if (fb != NULL) {
+        fclose(fb);
+    }
+    return iguais;
+}
+
+/**
+ * bench_exportacao - Mede a vazão (MB/s) da exportação com `fprintf`, `export_csv` e `export_csv_indices`.
+ */
+static void bench_exportacao(Processo *processos, long unsigned int n) {
+    const char *referencia = "benchmark_exportacao_fprintf.csv";
+    const char *saida = "benchmark_exportacao.csv";
+    long unsigned int *indices = malloc(n * sizeof(long unsigned int));
+
+    printf("\nExportação CSV (%lu registros)\n", n);
+    printf("%-20s | %-10s | %-10s | %-9s\n", "Método", "Tempo (s)", "MB/s", "Resultado");
+    printf("--------------------------------------------------------\n");
+
+    double inicio = agora();
+    export_csv_fprintf(referencia, processos, n);
+    double segundos = agora() - inicio;
+    double mb = (double)tamanho_arquivo(referencia) / (1024.0 * 1024.0);
+    printf("%-20s | %-10.3f | %-10.1f | %-9s\n", "fprintf", segundos, mb / segundos, "-");
+
+    inicio = agora();
+    export_csv(saida, &processos, 0, n);
+    segundos = agora() - inicio;
+    printf("%-20s | %-10.3f | %-10.1f | %-9s\n", "export_csv", segundos, mb / segundos,
+        arquivos_iguais(referencia, saida) ? "idêntico" : "DIFERENTE");
+
+    // Exporta pela permutação identidade para comparar o resultado byte a byte
+    for (long unsigned int i = 0; i < n; i++) {
+        indices[i] = i;
+    }
+    inicio = agora();
+    export_csv_indices(saida, processos, indices, n);
+    segundos = agora() - inicio;
+    printf("%-20s | %-10.3f | %-10.1f | %-9s\n", "export_csv_indices", segundos, mb / segundos,
+        arquivos_iguais(referencia, saida) ? "idêntico" : "DIFERENTE");
+
+    unlink(referencia);
+    unlink(saida);
+    free(indices);
+}
+
+/**
+ * bench_top_k - Compara a ordenação completa por data com `top_k` e `top_k_paralelo`.
+ * 
+ * O resultado de ambos deve coincidir com os K primeiros da ordenação estável por radix sort.
+ */
+static void bench_top_k(const Processo *processos, long unsigned int n, int max_threads) {
+    const long unsigned int valores_k[] = {5, 100, 10000};
+    long unsigned int *ordenados = malloc(n * sizeof(long unsigned int));
+    long unsigned int *selecionados = malloc(10000 * sizeof(long unsigned int));
+
+    double inicio = agora();
+    ordena_indices_por_data(processos, n, ordenados, ORDEM_DECRESCENTE);
+    double segundos_ordenacao = agora() - inicio;
+
+    printf("\nTop-K por data (%lu registros, ordenação completa: %.3f s)\n", n, segundos_ordenacao);
+    printf("%-6s | %-8s | %-10s | %-8s | %-9s\n", "K", "Threads", "Tempo (s)", "Speedup", "Resultado");
+    printf("--------------------------------------------------------\n");
+
+    for (size_t i = 0; i < sizeof(valores_k) / sizeof(valores_k[0]); i++) {
+        long unsigned int k = valores_k[i];
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            inicio = agora();
+            long unsigned int obtidos = threads == 1 ? top_k(processos, n, k, compara_data, selecionados)
+                                                     : top_k_paralelo(processos, n, k, compara_data, selecionados,
+                                                                      threads);
+            double segundos = agora() - inicio;
+            int iguais = obtidos == (k < n ? k : n) &&
+                         memcmp(selecionados, ordenados, obtidos * sizeof(long unsigned int)) == 0;
+            printf("%-6lu | %-8d | %-10.4f | %-8.1f | %-9s\n", k, threads, segundos, segundos_ordenacao / segundos,
+                iguais ? "idêntico" : "DIFERENTE");
+        }
+    }
+
+    free(ordenados);
+    free(selecionados);
+}
+
+// Kernels medidos por `bench_simd`
+typedef enum {
+    KERNEL_IGUAIS,
+    KERNEL_CONTEM_DENSO,
+    KERNEL_CONTEM_ESPARSO,
+    KERNEL_TAMANHO
+} KernelSimd;
+
+/**
+ * mede_kernel - Imprime uma linha da tabela de `bench_simd` e devolve o resultado do kernel.
+ * 
+ * O kernel é repetido `repeticoes` vezes; a vazão é dada em elementos examinados por segundo.
+ */
+static long unsigned int mede_kernel(KernelSimd kernel, NivelSimd nivel, const ProcessosColunar *colunar,
+                                     int repeticoes, double *referencia) {
+    static const char *nomes[] = {"iguais (classe)", "contém 4 (denso)", "contém 4 (esparso)", "tamanho > 1"};
+    // 11778 aparece em quase todos os registros; os demais assuntos são raros
+    const int denso[] = {11778, 10602, 3628, 11514};
+    const int esparso[] = {3533, 11514, 11513, 11700};
+    long unsigned int n = colunar->tamanho;
+    long unsigned int elementos = kernel == KERNEL_IGUAIS ? colunar->classe_offset[n] :
+                                  kernel == KERNEL_TAMANHO ? n : colunar->assunto_offset[n];
+    long unsigned int resultado = 0;
+
+    double inicio = agora();
+    for (int r = 0; r < repeticoes; r++) {
+        switch (kernel) {
+            case KERNEL_IGUAIS:
+                resultado = simd_conta_iguais(colunar->classe_valores, elementos, 11528, nivel);
+                break;
+            case KERNEL_CONTEM_DENSO:
+            case KERNEL_CONTEM_ESPARSO:
+                resultado = simd_conta_registros_com(colunar->assunto_offset, n, colunar->assunto_valores,
+                                                     kernel == KERNEL_CONTEM_DENSO ? denso : esparso, 4, nivel);
+                break;
+            case KERNEL_TAMANHO:
+                resultado = simd_conta_tamanho_maior(colunar->assunto_offset, n, 1, nivel);
+                break;
+        }
+    }
+    double segundos = (agora() - inicio) / repeticoes;
+    double por_segundo = (double)elementos / segundos;
+    if (nivel == SIMD_ESCALAR) {
+        *referencia = por_segundo;
+    }
+
+    printf("%-22s | %-8s | %-12lu | %-14.0f | %-7.2f\n", nomes[kernel], simd_nome(nivel), resultado, por_segundo,
+        por_segundo / *referencia);
+    return resultado;
+}
+
+/**
+ * bench_simd - Compara os kernels de varredura escalares e vetoriais sobre a base colunar.
+ * 
+ * Todos os níveis suportados pela CPU devem produzir o mesmo resultado, igual ao das
+ * funções que percorrem os registros (`count_id`, `mais_de_um_assunto`). A memória das colunas
+ * (`colunar_bytes`) é impressa ao lado da do array de registros.
+ */
+static void bench_simd(Processo *processos, long unsigned int n) {
+    const int repeticoes = 20;
+    ProcessosColunar colunar;
+    if (colunar_constroi(processos, n, &colunar) != 0) {
+        printf("Erro ao construir a base colunar.\n");
+        return;
+    }
+
+    printf("\nBase colunar: %.1f MB (%.1f bytes/registro); array de Processo: %.1f MB (%zu bytes/registro)\n",
+           (double)colunar_bytes(&colunar) / (1024.0 * 1024.0),
+           n > 0 ? (double)colunar_bytes(&colunar) / (double)n : 0.0,
+           (double)(n * sizeof(Processo)) / (1024.0 * 1024.0), sizeof(Processo));
+    printf("\nKernels de varredura (%lu registros, CPU: %s)\n", n, simd_nome(simd_detecta()));
+    printf("%-22s | %-8s | %-12s | %-14s | %-7s\n", "Kernel", "Nível", "Resultado", "Elementos/s", "Speedup");
+    printf("-------------------------------------------------------------------------\n");
+
+    int consistente = 1;
+    for (int kernel = KERNEL_IGUAIS; kernel <= KERNEL_TAMANHO; kernel++) {
+        double referencia = 1.0;
+        long unsigned int esperado = 0;
+        for (int nivel = SIMD_ESCALAR; nivel <= (int)simd_detecta(); nivel++) {
+            long unsigned int resultado = mede_kernel((KernelSimd)kernel, (NivelSimd)nivel, &colunar, repeticoes,
+                                                      &referencia);
+            if (nivel == SIMD_ESCALAR) {
+                esperado = resultado;
+            }
+            consistente &= resultado == esperado;
+        }
+    }
+
+    consistente &= count_id_colunar(&colunar, 11528) == count_id(processos, n, 11528) &&
+                   mais_de_um_assunto_colunar(&colunar) == mais_de_um_assunto(processos, n);
+    printf("  resultados %s entre os níveis e as funções sobre registros\n", consistente ? "iguais" : "DIFERENTES");
+    colunar_libera(&colunar);
+}
+
+/**
+ * estimativa_proxima - Diz se a estimativa do HyperLogLog está a até 3 erros padrão do valor exato.
+ */
+static int estimativa_proxima(double estimativa, long unsigned int exato, int precisao) {
+    double erro_padrao = 1.04 / sqrt((double)((long unsigned int)1 << precisao));
+    return fabs(estimativa - (double)exato) <= 3.0 * erro_padrao * (double)exato + 1.0;
+}
+
+/**
+ * bench_distintos - Compara a contagem aproximada de distintos (HyperLogLog) com a exata.
+ * 
+ * Os assuntos são contados por `count_assuntos` e `count_assuntos_aproximado`; os ids, que têm
+ * cardinalidade bem maior, por `conta_distintos` e por um estimador alimentado diretamente. A
+ * estimativa de dois estimadores juntados com `hll_junta`, um para cada metade da base, deve ser
+ * idêntica à de um único estimador sobre a base inteira.
+ */
+static void bench_distintos(Processo *processos, long unsigned int n) {
+    const int precisoes[] = {10, 14};
+    int *ids = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (ids == NULL) {
+        return;
+    }
+    for (long unsigned int i = 0; i < n; i++) {
+        ids[i] = processos[i].id;
+    }
+
+    double inicio = agora();
+    long unsigned int assuntos = count_assuntos(processos, n);
+    double segundos_assuntos = agora() - inicio;
+    inicio = agora();
+    long unsigned int distintos_ids = conta_distintos(ids, n);
+    double segundos_ids = agora() - inicio;
+
+    printf("\nContagem de distintos (%lu registros)\n", n);
+    printf("%-8s | %-9s | %-10s | %-12s | %-10s | %-9s\n", "Campo", "Precisão", "Exato", "Estimativa",
+           "Tempo (s)", "Resultado");
+    printf("---------------------------------------------------------------------\n");
+    printf("%-8s | %-9s | %-10lu | %-12s | %-10.4f | %-9s\n", "assuntos", "exata", assuntos, "-",
+           segundos_assuntos, "-");
+    printf("%-8s | %-9s | %-10lu | %-12s | %-10.4f | %-9s\n", "ids", "exata", distintos_ids, "-", segundos_ids, "-");
+
+    int consistente = 1;
+    for (size_t p = 0; p < sizeof(precisoes) / sizeof(precisoes[0]); p++) {
+        int precisao = precisoes[p];
+
+        inicio = agora();
+        long unsigned int aproximado = count_assuntos_aproximado(processos, n, precisao);
+        double segundos = agora() - inicio;
+        int proximo = estimativa_proxima((double)aproximado, assuntos, precisao);
+        consistente &= proximo;
+        printf("%-8s | %-9d | %-10lu | %-12lu | %-10.4f | %-9s\n", "assuntos", precisao, assuntos, aproximado,
+               segundos, proximo ? "ok" : "DIFERENTE");
+
+        // Um estimador para a base inteira e um para cada metade, juntados no final
+        HyperLogLog inteiro = {0}, metade_a = {0}, metade_b = {0};
+        if (hll_inicializa(&inteiro, precisao) != 0 || hll_inicializa(&metade_a, precisao) != 0 ||
+            hll_inicializa(&metade_b, precisao) != 0) {
+            hll_libera(&inteiro);
+            hll_libera(&metade_a);
+            consistente = 0;
+            break;
+        }
+        inicio = agora();
+        for (long unsigned int i = 0; i < n; i++) {
+            hll_adiciona(&inteiro, ids[i]);
+        }
+        double estimativa = hll_estimativa(&inteiro);
+        segundos = agora() - inicio;
+        for (long unsigned int i = 0; i < n; i++) {
+            hll_adiciona(i < n / 2 ? &metade_a : &metade_b, ids[i]);
+        }
+        hll_junta(&metade_a, &metade_b);
+        proximo = estimativa_proxima(estimativa, distintos_ids, precisao) &&
+                  hll_estimativa(&metade_a) == estimativa;
+        consistente &= proximo;
+        printf("%-8s | %-9d | %-10lu | %-12.0f | %-10.4f | %-9s\n", "ids", precisao, distintos_ids, estimativa,
+               segundos, proximo ? "ok" : "DIFERENTE");
+        hll_libera(&inteiro);
+        hll_libera(&metade_a);
+        hll_libera(&metade_b);
+    }
+    printf("  estimativas %s (até 3 erros padrão; junção das metades igual à base inteira)\n",
+           consistente ? "dentro do esperado" : "FORA DO ESPERADO");
+    free(ids);
+}
+
+/**
+ * bench_agrupamento - Mede `agrupa` para vários conjuntos de dimensões e confere as contagens.
+ * 
+ * O histograma por classe é comparado com uma chamada de `count_id` por classe (o que os
+ * relatórios faziam antes); os demais agrupamentos são conferidos pela soma das contagens.
+ */
+static void bench_agrupamento(Processo *processos, long unsigned int n, int max_threads) {
+    const Dimensao combinacoes[][MAX_DIMENSOES] = {
+        {DIM_CLASSE}, {DIM_ASSUNTO}, {DIM_ANO_ELEICAO}, {DIM_MES},
+        {DIM_CLASSE, DIM_ANO}, {DIM_ASSUNTO, DIM_MES}, {DIM_CLASSE, DIM_ASSUNTO, DIM_ANO_ELEICAO}
+    };
+    const int num_dimensoes[] = {1, 1, 1, 1, 2, 2, 3};
+    const char *saida = "benchmark_agrupamento.csv";
+    Agrupamento agrupamento;
+
+    printf("\nAgrupamentos (%lu registros)\n", n);
+    printf("%-44s | %-7s | %-7s | %-8s | %-10s | %-9s\n", "Dimensões", "Threads", "Tabela", "Grupos", "Tempo (s)",
+        "Resultado");
+    printf("--------------------------------------------------------------------------------------------------\n");
+
+    for (size_t c = 0; c < sizeof(num_dimensoes) / sizeof(num_dimensoes[0]); c++) {
+        char nome[128] = "";
+        for (int d = 0; d < num_dimensoes[c]; d++) {
+            strcat(nome, d > 0 ? " x " : "");
+            strcat(nome, dimensao_nome(combinacoes[c][d]));
+        }
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            if (agrupa(&agrupamento, processos, n, combinacoes[c], num_dimensoes[c], threads) != 0) {
+                printf("Erro ao agrupar por %s.\n", nome);
+                continue;
+            }
+
+            // Dimensões de valor único somam exatamente o número de registros
+            long unsigned int soma = 0;
+            for (long unsigned int g = 0; g < agrupamento.num_grupos; g++) {
+                soma += agrupamento.grupos[g].contagem;
+            }
+            int lista = 0;
+            for (int d = 0; d < num_dimensoes[c]; d++) {
+                lista |= combinacoes[c][d] == DIM_CLASSE || combinacoes[c][d] == DIM_ASSUNTO;
+            }
+            int correto = lista ? soma >= n : soma == n;
+            printf("%-44s | %-7d | %-7s | %-8lu | %-10.4f | %-9s\n", nome, threads,
+                agrupamento.denso ? "array" : "hash", agrupamento.num_grupos, agrupamento.segundos,
+                correto ? "ok" : "DIFERENTE");
+
+            if (threads == 1) {
+                agrupamento_exporta_csv(&agrupamento, saida);
+            }
+            agrupamento_libera(&agrupamento);
+        }
+    }
+
+    // Histograma por classe: um agrupamento x uma chamada de `count_id` por classe
+    Dimensao classe = DIM_CLASSE;
+    agrupa(&agrupamento, processos, n, &classe, 1, 1);
+    int iguais = 1;
+    double inicio = agora();
+    for (long unsigned int g = 0; g < agrupamento.num_grupos; g++) {
+        iguais &= (long unsigned int)count_id(processos, n, agrupamento.grupos[g].chave[0]) ==
+                  agrupamento.grupos[g].contagem;
+    }
+    double segundos = agora() - inicio;
+    printf("  histograma por classe: agrupa %.4f s x count_id por classe (%lu chamadas) %.3f s; contagens %s\n",
+        agrupamento.segundos, agrupamento.num_grupos, segundos, iguais ? "iguais" : "DIFERENTES");
+    agrupamento_libera(&agrupamento);
+    unlink(saida);
+}
+
+/**
+ * conta_intervalo_linear - Referência para `indice_temporal_conta`: percorre todos os registros.
+ */
+static long unsigned int conta_intervalo_linear(const Processo *processos, long unsigned int n, long long inicio,
+                                                long long fim) {
+    long unsigned int count = 0;
+    for (long unsigned int i = 0; i < n; i++) {
+        count += processos[i].timestamp >= inicio && processos[i].timestamp < fim;
+    }
+    return count;
+}
+
+/**
+ * bench_indice_temporal - Mede a latência das consultas por intervalo de datas no índice temporal.
+ * 
+ * Os intervalos têm início aleatório entre a menor e a maior data da base e larguras de um dia,
+ * um mês e um ano. As primeiras consultas de cada largura são conferidas com uma varredura
+ * linear, e os índices construídos sobre os registros e sobre a base colunar devem coincidir.
+ */
+static void bench_indice_temporal(const Processo *processos, long unsigned int n) {
+    const long long MS_DIA = 86400000LL;
+    const long long larguras[] = {MS_DIA, 30 * MS_DIA, 365 * MS_DIA};
+    const char *nomes[] = {"1 dia", "30 dias", "365 dias"};
+    const int CONSULTAS = 100000;
+    const int CONFERIDAS = 20;
+    IndiceTemporal indice, indice_colunar;
+    ProcessosColunar colunar;
+    ContagemBalde baldes[64];
+
+    if (n == 0 || indice_temporal_constroi(&indice, processos, n) != 0) {
+        return;
+    }
+    int colunar_igual = 0;
+    if (colunar_constroi(processos, n, &colunar) == 0) {
+        if (indice_temporal_constroi_colunar(&indice_colunar, &colunar) == 0) {
+            colunar_igual = memcmp(indice.linhas, indice_colunar.linhas, n * sizeof(long unsigned int)) == 0 &&
+                            memcmp(indice.timestamps, indice_colunar.timestamps, n * sizeof(long long)) == 0;
+            indice_temporal_libera(&indice_colunar);
+        }
+        colunar_libera(&colunar);
+    }
+
+    long long menor = indice.timestamps[0];
+    long long maior = indice.timestamps[n - 1];
+    printf("\nÍndice temporal (%lu registros, construção: %.3f s, %.1f MB, %lu dias, %lu meses, %lu anos, "
+           "colunar %s)\n", n, indice.segundos_construcao, (double)indice_temporal_bytes(&indice) / (1024.0 * 1024.0),
+           indice.histogramas[GRANULARIDADE_DIA].num_baldes, indice.histogramas[GRANULARIDADE_MES].num_baldes,
+           indice.histogramas[GRANULARIDADE_ANO].num_baldes, colunar_igual ? "idêntico" : "DIFERENTE");
+    printf("%-9s | %-12s | %-12s | %-14s | %-12s | %-11s | %-9s\n", "Intervalo", "Média linhas", "conta (ns)",
+           "lista+soma (ns)", "mensal (ns)", "linear (ms)", "Resultado");
+    printf("--------------------------------------------------------------------------------------------------\n");
+
+    long long *inicios = malloc((size_t)CONSULTAS * sizeof(long long));
+    for (size_t l = 0; l < sizeof(larguras) / sizeof(larguras[0]); l++) {
+        for (int q = 0; q < CONSULTAS; q++) {
+            inicios[q] = menor + (long long)(aleatorio() % (unsigned long long)(maior - menor + 1));
+        }
+
+        long unsigned int total = 0;
+        double inicio = agora();
+        for (int q = 0; q < CONSULTAS; q++) {
+            total += indice_temporal_conta(&indice, inicios[q], inicios[q] + larguras[l]);
+        }
+        double ns_conta = (agora() - inicio) * 1e9 / CONSULTAS;
+
+        // Percorre as linhas devolvidas, como faria quem lista os processos do intervalo
+        volatile long unsigned int soma = 0;
+        inicio = agora();
+        for (int q = 0; q < CONSULTAS; q++) {
+            long unsigned int tamanho;
+            const long unsigned int *linhas = indice_temporal_lista(&indice, inicios[q], inicios[q] + larguras[l],
+                                                                    &tamanho);
+            long unsigned int soma_consulta = 0;
+            for (long unsigned int i = 0; i < tamanho; i++) {
+                soma_consulta += linhas[i];
+            }
+            soma += soma_consulta;
+        }
+        double ns_lista = (agora() - inicio) * 1e9 / CONSULTAS;
+
+        long unsigned int total_baldes = 0;
+        inicio = agora();
+        for (int q = 0; q < CONSULTAS; q++) {
+            total_baldes += indice_temporal_histograma_intervalo(&indice, GRANULARIDADE_MES, inicios[q],
+                                                                 inicios[q] + larguras[l], baldes, 64);
+        }
+        double ns_mensal = (agora() - inicio) * 1e9 / CONSULTAS;
+
+        // Confere algumas consultas com a varredura linear, inclusive a soma do histograma mensal
+        int iguais = 1;
+        inicio = agora();
+        for (int q = 0; q < CONFERIDAS; q++) {
+            long unsigned int esperado = conta_intervalo_linear(processos, n, inicios[q], inicios[q] + larguras[l]);
+            long unsigned int num_baldes = indice_temporal_histograma_intervalo(&indice, GRANULARIDADE_MES, inicios[q],
+                                                                                inicios[q] + larguras[l], baldes, 64);
+            long unsigned int soma_baldes = 0;
+            for (long unsigned int b = 0; b < num_baldes && b < 64; b++) {
+                soma_baldes += baldes[b].contagem;
+            }
+            iguais &= esperado == indice_temporal_conta(&indice, inicios[q], inicios[q] + larguras[l]) &&
+                      esperado == soma_baldes;
+        }
+        double ms_linear = (agora() - inicio) * 1e3 / CONFERIDAS;
+
+        printf("%-9s | %-12.1f | %-12.0f | %-14.0f | %-12.0f | %-11.3f | %-9s\n", nomes[l],
+               (double)total / CONSULTAS, ns_conta, ns_lista, ns_mensal, ms_linear,
+               iguais && total_baldes > 0 ? "idêntico" : "DIFERENTE");
+    }
+
+    free(inicios);
+    indice_temporal_libera(&indice);
+}
+
+/**
+ * pontua_numero - Escreve um número de 20 dígitos no padrão CNJ (NNNNNNN-DD.AAAA.J.TR.OOOO).
+ */
+static void pontua_numero(const NumeroProcesso *numero, char *saida) {
+    char digitos[NUMERO_MAX_TEXTO + 1];
+    numero_para_texto(numero, digitos);
+    sprintf(saida, "%.7s-%.2s.%.4s.%.1s.%.2s.%.4s", digitos, digitos + 7, digitos + 9, digitos + 13, digitos + 14,
+            digitos + 16);
+}
+
+/**
+ * busca_numero_linear - Referência para `indice_numero_busca`: primeira linha com o número.
+ */
+static long int busca_numero_linear(const Processo *processos, long unsigned int n, const NumeroProcesso *numero) {
+    for (long unsigned int i = 0; i < n; i++) {
+        if (numero_iguais(&processos[i].numero, numero)) {
+            return (long int)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * contem_id - Diz se o campo (classe ou assunto) de um processo contém o id.
+ */
+static int contem_id(const Processo *processo, CampoIndice campo, int id) {
+    const int *lista = campo == CAMPO_CLASSE ? processo->classe : processo->assunto;
+    int tamanho = campo == CAMPO_CLASSE ? processo->classe_len : processo->assunto_len;
+
+    for (int j = 0; j < tamanho; j++) {
+        if (lista[j] == id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * confere_combinacao - Compara a interseção e a união das listas de dois ids com uma varredura.
+ * 
+ * Retorna 1 se as duas combinações forem idênticas às da varredura.
+ */
+static int confere_combinacao(const IndiceInvertido *indice, const Processo *processos, long unsigned int n,
+                              CampoIndice campo, int id_a, int id_b, long unsigned int *saida) {
+    long unsigned int na, nb;
+    const long unsigned int *a = indice_lista(indice, id_a, &na);
+    const long unsigned int *b = indice_lista(indice, id_b, &nb);
+    long unsigned int n_e = intersecao_linhas(a, na, b, nb, saida);
+    long unsigned int n_ou = uniao_linhas(a, na, b, nb, saida + n_e);
+    long unsigned int e = 0, ou = 0;
+    int iguais = 1;
+
+    for (long unsigned int i = 0; i < n && iguais; i++) {
+        int tem_a = contem_id(&processos[i], campo, id_a);
+        int tem_b = contem_id(&processos[i], campo, id_b);
+        if (tem_a && tem_b) {
+            iguais = e < n_e && saida[e++] == i;
+        }
+        if (iguais && (tem_a || tem_b)) {
+            iguais = ou < n_ou && saida[n_e + ou++] == i;
+        }
+    }
+    return iguais && e == n_e && ou == n_ou;
+}
+
+/**
+ * bench_indice_invertido - Mede a construção e as consultas dos índices invertidos de classes e assuntos.
+ * 
+ * Para cada campo são impressos o tempo de construção e a memória do índice. A contagem de todas as
+ * classes (`count_id_indice`) é comparada com `count_id`, as listas de todos os ids com uma
+ * varredura, e a interseção (E) e a união (OU) de pares de ids, incluindo o par da menor com a
+ * maior lista, com a mesma varredura. Um id inexistente deve devolver lista vazia.
+ */
+static void bench_indice_invertido(Processo *processos, long unsigned int n) {
+    const CampoIndice campos[] = {CAMPO_CLASSE, CAMPO_ASSUNTO};
+    const char *nomes[] = {"classe", "assunto"};
+    long unsigned int *saida = malloc(2 * (n > 0 ? n : 1) * sizeof(long unsigned int));
+    if (saida == NULL) {
+        return;
+    }
+
+    printf("\nÍndices invertidos (%lu registros)\n", n);
+    printf("%-8s | %-6s | %-14s | %-10s | %-14s | %-14s | %-9s\n", "Campo", "Ids", "Construção (s)", "MB",
+           "Consulta (ns)", "Varredura (ms)", "Resultado");
+    printf("-----------------------------------------------------------------------------------------------\n");
+
+    for (int c = 0; c < 2; c++) {
+        IndiceInvertido indice;
+        if (indice_invertido_constroi(&indice, processos, n, campos[c]) != 0) {
+            printf("Erro ao construir o índice invertido.\n");
+            break;
+        }
+
+        // Listas de todos os ids: tamanho, ordem e conteúdo iguais aos da varredura
+        int iguais = 1;
+        long unsigned int menor = 0, maior = 0;
+        double segundos_varredura = 0.0;
+        for (long unsigned int k = 0; k < indice.num_chaves; k++) {
+            int id = indice.chaves[k];
+            long unsigned int tamanho;
+            const long unsigned int *lista = indice_lista(&indice, id, &tamanho);
+            long unsigned int pos = 0;
+            double inicio = agora();
+            for (long unsigned int i = 0; i < n && iguais; i++) {
+                if (contem_id(&processos[i], campos[c], id)) {
+                    iguais = pos < tamanho && lista[pos++] == i;
+                }
+            }
+            segundos_varredura += agora() - inicio;
+            iguais &= pos == tamanho;
+            if (campos[c] == CAMPO_CLASSE) {
+                iguais &= count_id_indice(&indice, id) == count_id(processos, n, id);
+            }
+            menor = tamanho < indice.offset[menor + 1] - indice.offset[menor] ? k : menor;
+            maior = tamanho > indice.offset[maior + 1] - indice.offset[maior] ? k : maior;
+        }
+
+        long unsigned int tamanho;
+        iguais &= indice_lista(&indice, -1, &tamanho) == NULL && tamanho == 0 && count_id_indice(&indice, -1) == 0;
+
+        // Consultas E/OU: pares vizinhos e o par da menor com a maior lista (busca exponencial)
+        for (long unsigned int k = 0; k + 1 < indice.num_chaves && k < 8 && iguais; k++) {
+            iguais = confere_combinacao(&indice, processos, n, campos[c], indice.chaves[k], indice.chaves[k + 1],
+                                        saida);
+        }
+        if (iguais && indice.num_chaves > 1) {
+            iguais = confere_combinacao(&indice, processos, n, campos[c], indice.chaves[menor], indice.chaves[maior],
+                                        saida);
+        }
+
+        // Tempo médio de uma contagem pelo índice
+        const int CONSULTAS = 1000000;
+        double inicio = agora();
+        for (int q = 0; q < CONSULTAS && indice.num_chaves > 0; q++) {
+            indice_lista(&indice, indice.chaves[(long unsigned int)q % indice.num_chaves], &tamanho);
+        }
+        double ns_consulta = (agora() - inicio) * 1e9 / CONSULTAS;
+
+        printf("%-8s | %-6lu | %-14.4f | %-10.2f | %-14.1f | %-14.3f | %-9s\n", nomes[c], indice.num_chaves,
+               indice.segundos_construcao, (double)indice_invertido_bytes(&indice) / (1024.0 * 1024.0), ns_consulta,
+               indice.num_chaves > 0 ? segundos_varredura * 1e3 / (double)indice.num_chaves : 0.0,
+               iguais ? "idêntico" : "DIFERENTE");
+        indice_invertido_libera(&indice);
+    }
+    free(saida);
+}
+
+/**
+ * bench_indice_primario - Mede o cálculo de dias em tramitação pelo índice de chave primária.
+ * 
+ * Os ids consultados são sorteados da própria base, e o último é um id inexistente (maior que
+ * todos). `count_dias_lote` deve devolver, para os primeiros ids, o mesmo que `count_dias` (busca
+ * linear) e, para todos, o mesmo que `count_dias_indice`; para o id inexistente, -1.
+ */
+static void bench_indice_primario(Processo *processos, long unsigned int n) {
+    const int CONSULTAS = 100000;
+    const int CONFERIDAS = 200;
+    IndicePrimario indice;
+
+    if (n == 0 || indice_primario_constroi(&indice, processos, n) != 0) {
+        return;
+    }
+    int *ids = malloc((size_t)CONSULTAS * sizeof(int));
+    int *dias = malloc((size_t)CONSULTAS * sizeof(int));
+    if (ids == NULL || dias == NULL) {
+        free(ids);
+        free(dias);
+        indice_primario_libera(&indice);
+        return;
+    }
+
+    int maior_id = processos[0].id;
+    for (long unsigned int i = 1; i < n; i++) {
+        maior_id = processos[i].id > maior_id ? processos[i].id : maior_id;
+    }
+    for (int q = 0; q < CONSULTAS - 1; q++) {
+        ids[q] = processos[aleatorio() % n].id;
+    }
+    ids[CONSULTAS - 1] = maior_id + 1;
+
+    double inicio = agora();
+    count_dias_lote(processos, &indice, ids, (long unsigned int)CONSULTAS, dias);
+    double ns_lote = (agora() - inicio) * 1e9 / CONSULTAS;
+
+    int iguais = dias[CONSULTAS - 1] == -1;
+    inicio = agora();
+    for (int q = 0; q < CONSULTAS; q++) {
+        iguais &= count_dias_indice(processos, &indice, ids[q]) == dias[q];
+    }
+    double ns_indice = (agora() - inicio) * 1e9 / CONSULTAS;
+
+    inicio = agora();
+    for (int q = 0; q < CONFERIDAS; q++) {
+        iguais &= count_dias(processos, n, ids[q]) == dias[q];
+    }
+    double ms_linear = (agora() - inicio) * 1e3 / CONFERIDAS;
+    iguais &= count_dias(processos, n, ids[CONSULTAS - 1]) == -1;
+
+    printf("\nDias em tramitação (%lu registros, índice primário construído em %.3f s)\n", n,
+           indice.segundos_construcao);
+    printf("%-10s | %-12s | %-11s | %-9s\n", "lote (ns)", "índice (ns)", "linear (ms)", "Resultado");
+    printf("--------------------------------------------------\n");
+    printf("%-10.0f | %-12.0f | %-11.3f | %-9s\n", ns_lote, ns_indice, ms_linear, iguais ? "idêntico" : "DIFERENTE");
+
+    free(ids);
+    free(dias);
+    indice_primario_libera(&indice);
+}
+
+/**
+ * bench_indice_numero - Mede a busca de processos pelo número CNJ no índice de numeração.
+ * 
+ * Os números consultados são sorteados da própria base; metade das consultas de texto usa a
+ * pontuação do CNJ. As primeiras consultas são conferidas com uma varredura linear, e números
+ * inexistentes (último dígito alterado) devem devolver -1.
+ */
+static void bench_indice_numero(const Processo *processos, long unsigned int n) {
+    const int CONSULTAS = 100000;
+    const int CONFERIDAS = 20;
+    IndiceNumero indice;
+
+    if (n == 0 || indice_numero_constroi(&indice, processos, n) != 0) {
+        return;
+    }
+    printf("\nÍndice de numeração (%lu registros, %lu números distintos, construção: %.3f s, %.1f MB, "
+           "Processo: %zu bytes, NumeroProcesso: %zu bytes)\n", n, indice.tamanho, indice.segundos_construcao,
+           (double)indice_numero_bytes(&indice) / (1024.0 * 1024.0), sizeof(Processo), sizeof(NumeroProcesso));
+
+    long unsigned int *linhas = malloc((size_t)CONSULTAS * sizeof(long unsigned int));
+    for (int q = 0; q < CONSULTAS; q++) {
+        linhas[q] = (long unsigned int)(aleatorio() % n);
+    }
+
+    // Todas as buscas devem achar um processo com o mesmo número, na primeira ocorrência
+    int iguais = 1;
+    double inicio = agora();
+    for (int q = 0; q < CONSULTAS; q++) {
+        long int linha = indice_numero_busca(&indice, &processos[linhas[q]].numero);
+        iguais &= linha != -1 && (long unsigned int)linha <= linhas[q];
+    }
+    double ns_compacto = (agora() - inicio) * 1e9 / CONSULTAS;
+
+    char (*textos)[NUMERO_MAX_TEXTO + 1] = malloc((size_t)CONSULTAS * sizeof(*textos));
+    for (int q = 0; q < CONSULTAS; q++) {
+        const NumeroProcesso *numero = &processos[linhas[q]].numero;
+        if (q % 2 == 0 && numero->prefixo != NUMERO_TEXTO) {
+            pontua_numero(numero, textos[q]);
+        } else {
+            numero_para_texto(numero, textos[q]);
+        }
+    }
+    inicio = agora();
+    for (int q = 0; q < CONSULTAS; q++) {
+        long int linha = indice_numero_busca_texto(&indice, textos[q]);
+        iguais &= linha != -1 && numero_iguais(&processos[linha].numero, &processos[linhas[q]].numero);
+    }
+    double ns_texto = (agora() - inicio) * 1e9 / CONSULTAS;
+
+    inicio = agora();
+    for (int q = 0; q < CONFERIDAS; q++) {
+        const NumeroProcesso *numero = &processos[linhas[q]].numero;
+        iguais &= busca_numero_linear(processos, n, numero) == indice_numero_busca(&indice, numero);
+    }
+    double ms_linear = (agora() - inicio) * 1e3 / CONFERIDAS;
+
+    // Números inexistentes: o último dígito é alterado até sair da base
+    for (int q = 0; q < CONFERIDAS; q++) {
+        NumeroProcesso numero = processos[linhas[q]].numero;
+        unsigned long long original = numero.digitos;
+        for (int d = 1; d < 10 && numero.prefixo != NUMERO_TEXTO; d++) {
+            numero.digitos = original - original % 10 + (original + (unsigned long long)d) % 10;
+            if (busca_numero_linear(processos, n, &numero) == -1) {
+                iguais &= indice_numero_busca(&indice, &numero) == -1;
+                break;
+            }
+        }
+    }
+
+    printf("%-16s | %-16s | %-11s | %-9s\n", "compactado (ns)", "texto (ns)", "linear (ms)", "Resultado");
+    printf("-------------------------------------------------------------\n");
+    printf("%-16.0f | %-16.0f | %-11.3f | %-9s\n", ns_compacto, ns_texto, ms_linear,
+           iguais ? "idêntico" : "DIFERENTE");
+
+    free(textos);
+    free(linhas);
+    indice_numero_libera(&indice);
+}
+
+/**
+ * escreve_trecho_linhas - Copia o cabeçalho e as linhas de dados [primeira, primeira + linhas) de `origem`.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int escreve_trecho_linhas(const char *origem, const char *destino, long unsigned int primeira,
+                                 long unsigned int linhas) {
+    FILE *entrada = fopen(origem, "rb");
+    FILE *saida = fopen(destino, "wb");
+    char linha[1024];
+    long unsigned int lidas = 0;
+
+    if (entrada == NULL || saida == NULL) {
+        if (entrada != NULL) {
+            fclose(entrada);
+        }
+        if (saida != NULL) {
+            fclose(saida);
+        }
+        return -1;
+    }
+    // A linha 0 é o cabeçalho
+    while (lidas <= primeira + linhas && fgets(linha, sizeof(linha), entrada) != NULL) {
+        if (lidas == 0 || lidas > primeira) {
+            fputs(linha, saida);
+        }
+        lidas++;
+    }
+    fclose(entrada);
+    return fclose(saida) == 0 ? 0 : -1;
+}
+
+/**
+ * escreve_primeiras_linhas - Copia o cabeçalho e as `linhas` primeiras linhas de dados de `origem`.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int escreve_primeiras_linhas(const char *origem, const char *destino, long unsigned int linhas) {
+    return escreve_trecho_linhas(origem, destino, 0, linhas);
+}
+
+/**
+ * bench_incremental - Compara a carga incremental de um arquivo diário com a reconstrução completa.
+ * 
+ * O "dia anterior" é o arquivo original sem os últimos `percentual_delta`% de linhas; o arquivo do dia
+ * é o original inteiro. A reconstrução relê tudo, ordena por id e por data e recalcula os contadores.
+ */
+static void bench_incremental(const char *origem) {
+    const int percentuais_delta[] = {1, 10, 50};
+    const char *anterior = "benchmark_dia_anterior.csv";
+    Processo *processos;
+    Arena arena;
+
+    printf("\nCarga incremental (%s)\n", origem);
+    printf("%-7s | %-8s | %-16s | %-16s | %-8s | %-9s\n", "Delta", "Novos", "Incremental (s)", "Completa (s)",
+        "Speedup", "Resultado");
+    printf("-------------------------------------------------------------------------------\n");
+
+    // Reconstrução completa do arquivo do dia (igual para todos os deltas)
+    double inicio = agora();
+    arena_inicializa(&arena, 0);
+    long unsigned int n = read_csv(origem, &processos, &arena);
+    long unsigned int *por_id = malloc(n * sizeof(long unsigned int));
+    long unsigned int *por_data = malloc(n * sizeof(long unsigned int));
+    ordena_indices_por_id(processos, n, por_id, ORDEM_CRESCENTE);
+    aplica_permutacao(processos, por_id, n);
+    ordena_indices_por_data(processos, n, por_data, ORDEM_DECRESCENTE);
+    int classe_completa = count_id(processos, n, 11528);
+    long unsigned int assuntos_completa = count_assuntos(processos, n);
+    int mais_completa = mais_de_um_assunto(processos, n);
+    double segundos_completa = agora() - inicio;
+
+    for (size_t i = 0; i < sizeof(percentuais_delta) / sizeof(percentuais_delta[0]); i++) {
+        long unsigned int linhas_anterior = n - n * (long unsigned int)percentuais_delta[i] / 100;
+        BaseIncremental base;
+        EstatisticasDelta stats;
+
+        if (escreve_primeiras_linhas(origem, anterior, linhas_anterior) != 0 ||
+            base_incremental_inicializa(&base) != 0 || base_incremental_carrega(&base, anterior, NULL) < 0) {
+            printf("Erro ao preparar a base do dia anterior.\n");
+            unlink(anterior);
+            continue;
+        }
+        base_incremental_carrega(&base, origem, &stats);
+
+        // Mesmos registros, mesmas ordens (a ordem por data é comparada pelos ids) e mesmos contadores
+        int iguais = base.tamanho == n && base_incremental_count_id(&base, 11528) == (long unsigned int)classe_completa &&
+                     base_incremental_count_assuntos(&base) == assuntos_completa &&
+                     base.mais_de_um_assunto == (long unsigned int)mais_completa;
+        for (long unsigned int j = 0; j < n && iguais; j++) {
+            iguais = base.processos[base.ordem_id[j]].id == processos[j].id &&
+                     base.processos[base.ordem_data[j]].id == processos[por_data[j]].id;
+        }
+        char delta[16];
+        snprintf(delta, sizeof(delta), "%d%%", percentuais_delta[i]);
+        printf("%-7s | %-8lu | %-16.4f | %-16.4f | %-8.1f | %-9s\n", delta, stats.novos, stats.segundos,
+            segundos_completa, segundos_completa / stats.segundos, iguais ? "idêntico" : "DIFERENTE");
+
+        base_incremental_libera(&base);
+        unlink(anterior);
+    }
+
+    free(por_id);
+    free(por_data);
+    arena_libera(&arena);
+    free(processos);
+}
+
+/**
+ * resolve_duplicados_serial - Referência para `read_csv_multiplos`: lê os arquivos um a um e escolhe,
+ * para cada id, o registro do arquivo de carimbo mais recente (empates ficam com o primeiro visto).
+ * 
+ * Retorna o número de registros escritos em `*esperado`.
+ */
+static long unsigned int resolve_duplicados_serial(const char *const *nomes, int num_arquivos, Processo **esperado,
+                                                   Arena *arena) {
+    Processo **partes = malloc((size_t)num_arquivos * sizeof(Processo *));
+    long unsigned int *inicios = malloc(((size_t)num_arquivos + 1) * sizeof(long unsigned int));
+    MapaInteiros vencedores;
+
+    mapa_inicializa(&vencedores, 1024);
+    inicios[0] = 0;
+    for (int f = 0; f < num_arquivos; f++) {
+        inicios[f + 1] = inicios[f] + read_csv(nomes[f], &partes[f], arena);
+        for (long unsigned int g = inicios[f]; g < inicios[f + 1]; g++) {
+            int id = partes[f][g - inicios[f]].id;
+            long unsigned int atual;
+            if (!mapa_busca(&vencedores, id, &atual)) {
+                mapa_insere(&vencedores, id, g);
+                continue;
+            }
+            int arquivo_atual = 0;
+            while (inicios[arquivo_atual + 1] <= atual) {
+                arquivo_atual++;
+            }
+            if (carimbo_exportacao(nomes[f]) > carimbo_exportacao(nomes[arquivo_atual])) {
+                mapa_insere(&vencedores, id, g);
+            }
+        }
+    }
+
+    long unsigned int n = 0;
+    *esperado = malloc(vencedores.tamanho * sizeof(Processo));
+    for (int f = 0; f < num_arquivos; f++) {
+        for (long unsigned int g = inicios[f]; g < inicios[f + 1]; g++) {
+            long unsigned int vencedor;
+            if (mapa_busca(&vencedores, partes[f][g - inicios[f]].id, &vencedor) && vencedor == g) {
+                (*esperado)[n++] = partes[f][g - inicios[f]];
+            }
+        }
+        free(partes[f]);
+    }
+
+    mapa_libera(&vencedores);
+    free(inicios);
+    free(partes);
+    return n;
+}
+
+/**
+ * bench_ingestao - Mede a leitura concorrente e a mescla de vários exportes com ids repetidos.
+ * 
+ * O arquivo é dividido em quatro trechos, gravados com carimbos de exportação fora da ordem da
+ * lista. Cada execução de `read_csv_multiplos` é comparada com a resolução serial dos duplicados.
+ */
+static void bench_ingestao(const char *arquivo, int max_threads) {
+    const char *nomes[] = {"benchmark_ingestao_043_202409032338.csv", "benchmark_ingestao_044_202410010000.csv",
+                           "benchmark_ingestao_045_202408010000.csv", "benchmark_ingestao_046_202409150000.csv"};
+    const int NUM_ARQUIVOS = 4;
+    FILE *entrada = fopen(arquivo, "rb");
+    char linha[1024];
+    long unsigned int linhas = 0;
+
+    if (entrada == NULL) {
+        return;
+    }
+    while (fgets(linha, sizeof(linha), entrada) != NULL) {
+        linhas++;
+    }
+    fclose(entrada);
+    linhas = linhas > 0 ? linhas - 1 : 0;
+
+    int erro = 0;
+    for (int f = 0; f < NUM_ARQUIVOS && !erro; f++) {
+        long unsigned int primeira = linhas / (long unsigned int)NUM_ARQUIVOS * (long unsigned int)f;
+        long unsigned int quantidade = f == NUM_ARQUIVOS - 1 ? linhas - primeira :
+                                       linhas / (long unsigned int)NUM_ARQUIVOS;
+        erro = escreve_trecho_linhas(arquivo, nomes[f], primeira, quantidade) != 0;
+    }
+
+    Processo *esperado = NULL;
+    Arena arena_esperado;
+    arena_inicializa(&arena_esperado, 0);
+    long unsigned int n_esperado = erro ? 0 : resolve_duplicados_serial(nomes, NUM_ARQUIVOS, &esperado,
+                                                                        &arena_esperado);
+
+    printf("\nIngestão de %d arquivos (%lu linhas, %lu ids distintos)\n", NUM_ARQUIVOS, linhas, n_esperado);
+    printf("%-8s | %-11s | %-10s | %-9s | %-12s | %-8s | %-9s\n", "Threads", "Leitura (s)", "Mescla (s)", "Total (s)",
+           "Registros/s", "MB/s", "Resultado");
+    printf("--------------------------------------------------------------------------------\n");
+
+    EstatisticasIngestao stats;
+    memset(&stats, 0, sizeof(EstatisticasIngestao));
+    for (int threads = 1; threads <= max_threads && !erro; threads *= 2) {
+        Processo *processos;
+        Arena arena;
+        arena_inicializa(&arena, 0);
+        ingestao_libera_estatisticas(&stats);
+
+        long int n = read_csv_multiplos(nomes, NUM_ARQUIVOS, &processos, &arena, DUPLICADOS_MAIS_RECENTE,
+                                        threads, &stats);
+        int iguais = n == (long int)n_esperado;
+        for (long int i = 0; i < n && iguais; i++) {
+            iguais = processos_iguais(&processos[i], &esperado[i]);
+        }
+        double segundos = stats.segundos > 0 ? stats.segundos : 1e-9;
+        printf("%-8d | %-11.3f | %-10.3f | %-9.3f | %-12.0f | %-8.1f | %-9s\n", threads, stats.segundos_leitura,
+               stats.segundos_mescla, stats.segundos, (double)stats.linhas / segundos,
+               (double)stats.bytes / segundos / (1024.0 * 1024.0), iguais ? "idêntico" : "DIFERENTE");
+
+        arena_libera(&arena);
+        free(processos);
+    }
+    if (!erro) {
+        print_estatisticas_ingestao(&stats);
+    }
+
+    ingestao_libera_estatisticas(&stats);
+    arena_libera(&arena_esperado);
+    free(esperado);
+    for (int f = 0; f < NUM_ARQUIVOS; f++) {
+        unlink(nomes[f]);
+    }
+}
+
+/**
+ * escreve_numeros_texto - Copia as `linhas` primeiras linhas de dados de `origem`, trocando o número
+ * de uma a cada sete linhas por um texto fora do padrão de 20 dígitos (ex.: "0600-17").
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int escreve_numeros_texto(const char *origem, const char *destino, long unsigned int linhas) {
+    FILE *entrada = fopen(origem, "rb");
+    FILE *saida = fopen(destino, "wb");
+    char linha[1024];
+    long unsigned int lidas = 0;
+
+    if (entrada == NULL || saida == NULL) {
+        if (entrada != NULL) {
+            fclose(entrada);
+        }
+        if (saida != NULL) {
+            fclose(saida);
+        }
+        return -1;
+    }
+    while (lidas <= linhas && fgets(linha, sizeof(linha), entrada) != NULL) {
+        char *abre = strstr(linha, ",\"");
+        char *fecha = abre != NULL ? strchr(abre + 2, '"') : NULL;
+        if (lidas > 0 && lidas % 7 == 3 && fecha != NULL) {
+            fprintf(saida, "%.*s,\"0600-%lu%s", (int)(abre - linha), linha, lidas % 100, fecha);
+        } else {
+            fputs(linha, saida);
+        }
+        lidas++;
+    }
+    fclose(entrada);
+    return fclose(saida) == 0 ? 0 : -1;
+}
+
+/**
+ * confere_externa_numeros_texto - Confere `ordena_externo` com números guardados como texto.
+ * 
+ * Os registros da intercalação são analisados sem arena, então o texto do número é reservado com
+ * malloc e precisa ser liberado a cada registro. O orçamento mínimo força várias corridas.
+ * 
+ * Retorna 1 se a saída coincidir com a ordenação em memória ou 0 caso contrário.
+ */
+static int confere_externa_numeros_texto(const char *arquivo) {
+    const char *entrada = "benchmark_externa_texto.csv";
+    const char *referencia = "benchmark_externa_texto_referencia.csv";
+    const char *saida = "benchmark_externa_texto_ordenado.csv";
+    Processo *processos;
+    Arena arena;
+    int iguais = 0;
+
+    if (escreve_numeros_texto(arquivo, entrada, 60000) == 0) {
+        arena_inicializa(&arena, 0);
+        long unsigned int n = read_csv(entrada, &processos, &arena);
+        long unsigned int *indices = malloc(n * sizeof(long unsigned int));
+        long unsigned int em_texto = 0;
+        for (long unsigned int i = 0; i < n; i++) {
+            em_texto += processos[i].numero.prefixo == NUMERO_TEXTO;
+        }
+        ordena_indices_por_data(processos, n, indices, ORDEM_DECRESCENTE);
+        export_csv_indices(referencia, processos, indices, n);
+
+        iguais = em_texto > 0 && ordena_externo(entrada, saida, compara_data, ORCAMENTO_MINIMO, NULL, NULL) == 0 &&
+                 arquivos_iguais(referencia, saida);
+        free(indices);
+        free(processos);
+        arena_libera(&arena);
+    }
+
+    unlink(entrada);
+    unlink(referencia);
+    unlink(saida);
+    return iguais;
+}
+
+/**
+ * bench_ordenacao_externa - Mede `ordena_externo` com orçamentos de memória diferentes.
+ * 
+ * A referência é a exportação da ordenação estável em memória (radix sort de índices),
+ * que deve coincidir byte a byte com a saída da ordenação externa.
+ */
+static void bench_ordenacao_externa(const char *arquivo, const Processo *processos, long unsigned int n) {
+    const long unsigned int orcamentos_mb[] = {4, 16, 64, 256};
+    const char *referencia = "benchmark_externa_referencia.csv";
+    const char *saida = "benchmark_externa.csv";
+    long unsigned int *indices = malloc(n * sizeof(long unsigned int));
+    double mb = (double)tamanho_arquivo(arquivo) / (1024.0 * 1024.0);
+
+    ordena_indices_por_data(processos, n, indices, ORDEM_DECRESCENTE);
+    export_csv_indices(referencia, processos, indices, n);
+    free(indices);
+
+    printf("\nOrdenação externa por data (%lu registros, %.0f MB)\n", n, mb);
+    printf("%-10s | %-8s | %-9s | %-12s | %-15s | %-9s | %-8s | %-9s\n", "Orçamento", "Corridas", "Passagens",
+        "Corridas (s)", "Intercalação (s)", "Total (s)", "MB/s", "Resultado");
+    printf("------------------------------------------------------------------------------------------------------\n");
+
+    for (size_t i = 0; i < sizeof(orcamentos_mb) / sizeof(orcamentos_mb[0]); i++) {
+        EstatisticasOrdenacaoExterna stats;
+        double inicio = agora();
+        int erro = ordena_externo(arquivo, saida, compara_data, orcamentos_mb[i] << 20, NULL, &stats);
+        double segundos = agora() - inicio;
+        printf("%-7lu MB | %-8lu | %-9d | %-12.3f | %-15.3f | %-9.3f | %-8.1f | %-9s\n", orcamentos_mb[i],
+            stats.corridas, stats.passagens, stats.segundos_corridas, stats.segundos_intercalacao, segundos,
+            mb / segundos, erro == 0 && arquivos_iguais(referencia, saida) ? "idêntico" : "DIFERENTE");
+    }
+    printf("Números fora do padrão de 20 dígitos: %s\n",
+           confere_externa_numeros_texto(arquivo) ? "idêntico" : "DIFERENTE");
+
+    unlink(referencia);
+    unlink(saida);
+}
+
+/**
+ * bench_fluxo - Responde às consultas agregadas em fluxo e imprime tempo e pico de memória.
+ * 
+ * Deve ser chamada antes de carregar a base, para que o pico de memória reflita apenas o fluxo.
+ * Os agregadores ficam em `agregadores` (classe, assuntos distintos, mais de um assunto).
+ */
+static void bench_fluxo(const char *arquivo, Agregador agregadores[3]) {
+    EstatisticasLeitura stats;
+
+    agregador_count_id(&agregadores[0], 11528);
+    agregador_count_assuntos(&agregadores[1]);
+    agregador_mais_de_um_assunto(&agregadores[2]);
+
+    printf("\nConsultas em fluxo (lotes de %d registros):\n", FLUXO_LOTE_PADRAO);
+    fluxo_executa(arquivo, agregadores, 3, 0, &stats);
+    print_estatisticas_leitura(&stats);
+    printf("  pico de memória residente: %.1f MB\n", pico_rss_mb());
+}
+
+/**
+ * confere_fluxo - Compara os resultados do fluxo com as funções sobre a base carregada.
+ */
+static void confere_fluxo(Agregador agregadores[3], Processo *processos, long unsigned int n) {
+    int iguais = !agregadores[0].erro && !agregadores[1].erro && !agregadores[2].erro &&
+                 agregadores[0].resultado == (long unsigned int)count_id(processos, n, 11528) &&
+                 agregadores[1].resultado == (long unsigned int)count_assuntos(processos, n) &&
+                 agregadores[2].resultado == (long unsigned int)mais_de_um_assunto(processos, n);
+
+    printf("  resultados do fluxo %s aos da base carregada\n", iguais ? "iguais" : "DIFERENTES");
+    for (int i = 0; i < 3; i++) {
+        agregador_libera(&agregadores[i]);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *origem = argc > 1 ? argv[1] : "processo_043_202409032338.csv";
+    long unsigned int tamanho_mb = argc > 2 ? strtoul(argv[2], NULL, 10) : 2048;
+    int max_threads = argc > 3 ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    const char *replicado = "benchmark_replicado.csv";
+    const long unsigned int AMOSTRA_ORDENACAO = 200000;
+
+    if (max_threads <= 0) {
+        max_threads = 1;
+    }
+
+    printf("Gerando %s com %lu MB a partir de %s...\n", replicado, tamanho_mb, origem);
+    if (replica_csv(origem, replicado, tamanho_mb * 1024 * 1024) != 0) {
+        printf("Erro ao gerar o arquivo replicado.\n");
+        return 1;
+    }
+
+    bench_parser(origem);
+    bench_incremental(origem);
+
+    Agregador agregadores[3];
+    bench_fluxo(replicado, agregadores);
+
+    bench_leitura(replicado, max_threads);
+    bench_ingestao(replicado, max_threads);
+
+    // Carrega a base uma vez para os benchmarks seguintes
+    Processo *processos;
+    Arena arena;
+    arena_inicializa(&arena, 0);
+    long unsigned int qnt_processos = read_csv_paralelo(replicado, &processos, &arena, max_threads, NULL);
+    long unsigned int amostra = qnt_processos < AMOSTRA_ORDENACAO ? qnt_processos : AMOSTRA_ORDENACAO;
+
+    confere_fluxo(agregadores, processos, qnt_processos);
+    bench_ordenacao_data(processos, amostra);
+    bench_radix(processos, qnt_processos);
+    bench_ordenacao_paralela(processos, qnt_processos, max_threads);
+    bench_top_k(processos, qnt_processos, max_threads);
+    bench_exportacao(processos, qnt_processos);
+    bench_simd(processos, qnt_processos);
+    bench_distintos(processos, qnt_processos);
+    bench_agrupamento(processos, qnt_processos, max_threads);
+    bench_indice_temporal(processos, qnt_processos);
+    bench_indice_invertido(processos, qnt_processos);
+    bench_indice_primario(processos, qnt_processos);
+    bench_indice_numero(processos, qnt_processos);
+    bench_ordenacao_externa(replicado, processos, qnt_processos);
+
+    arena_libera(&arena);
+    free(processos);
+
+    printf("\nPico de memória residente: %.1f MB\n", pico_rss_mb());
+    unlink(replicado);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "colunar.h"
+#include "conjunto.h"
+#include "metricas.h"
+#include "simd.h"
+
+/**
+ * colunar_constroi - Converte um array de `Processo` para a representação colunar.
+ * 
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @processos_size: Tamanho do array de estruturas `Processo`.
+ * @colunar: Estrutura que receberá as colunas alocadas.
+ * 
+ * Cada campo usado pelas análises vira um array denso; as listas de classe e assunto são
+ * concatenadas em um único array de valores, indexado por um array de deslocamentos.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int colunar_constroi(const Processo *processos, long unsigned int processos_size, ProcessosColunar *colunar) {
+    long unsigned int total_classes = 0;
+    long unsigned int total_assuntos = 0;
+
+    // Conta o total de valores das listas para dimensionar os arrays CSR
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        total_classes += (long unsigned int)processos[i].classe_len;
+        total_assuntos += (long unsigned int)processos[i].assunto_len;
+    }
+
+    colunar->tamanho = processos_size;
+    colunar->id = malloc(processos_size * sizeof(int));
+    colunar->timestamp = malloc(processos_size * sizeof(long long));
+    colunar->ano_eleicao = malloc(processos_size * sizeof(int));
+    colunar->classe_offset = malloc((processos_size + 1) * sizeof(long unsigned int));
+    colunar->classe_valores = malloc((total_classes > 0 ? total_classes : 1) * sizeof(int));
+    colunar->assunto_offset = malloc((processos_size + 1) * sizeof(long unsigned int));
+    colunar->assunto_valores = malloc((total_assuntos > 0 ? total_assuntos : 1) * sizeof(int));
+
+    if (colunar->id == NULL || colunar->timestamp == NULL || colunar->ano_eleicao == NULL ||
+        colunar->classe_offset == NULL || colunar->classe_valores == NULL ||
+        colunar->assunto_offset == NULL || colunar->assunto_valores == NULL) {
+        colunar_libera(colunar);
+        return -1;
+    }
+
+    long unsigned int pos_classe = 0;
+    long unsigned int pos_assunto = 0;
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        const Processo *p = &processos[i];
+
+        colunar->id[i] = p->id;
+        colunar->ano_eleicao[i] = p->ano_eleicao;
+        colunar->timestamp[i] = p->timestamp;
+
+        colunar->classe_offset[i] = pos_classe;
+        memcpy(&colunar->classe_valores[pos_classe], p->classe, (size_t)p->classe_len * sizeof(int));
+        pos_classe += (long unsigned int)p->classe_len;
+
+        colunar->assunto_offset[i] = pos_assunto;
+        memcpy(&colunar->assunto_valores[pos_assunto], p->assunto, (size_t)p->assunto_len * sizeof(int));
+        pos_assunto += (long unsigned int)p->assunto_len;
+    }
+    colunar->classe_offset[processos_size] = pos_classe;
+    colunar->assunto_offset[processos_size] = pos_assunto;
+
+    return 0;
+}
+
+/**
+ * colunar_libera - Libera todas as colunas de uma base colunar.
+ */
+void colunar_libera(ProcessosColunar *colunar) {
+    free(colunar->id);
+    free(colunar->timestamp);
+    free(colunar->ano_eleicao);
+    free(colunar->classe_offset);
+    free(colunar->classe_valores);
+    free(colunar->assunto_offset);
+    free(colunar->assunto_valores);
+    memset(colunar, 0, sizeof(ProcessosColunar));
+}
+
+/**
+ * colunar_bytes - Calcula a memória ocupada pelas colunas, em bytes.
+ */
+long unsigned int colunar_bytes(const ProcessosColunar *colunar) {
+    long unsigned int n = colunar->tamanho;
+
+    return n * (sizeof(int) + sizeof(long long) + sizeof(int))
+        + 2 * (n + 1) * sizeof(long unsigned int)
+        + colunar->classe_offset[n] * sizeof(int)
+        + colunar->assunto_offset[n] * sizeof(int);
+}
+
+/**
+ * count_id_colunar - Versão colunar de `count_id`.
+ * 
+ * @colunar: Base colunar.
+ * @id_classe: ID da classe a ser buscada.
+ * 
+ * Varre o array contíguo de valores de classe com o kernel vetorial de `simd.c` (AVX2 ou SSE4.2,
+ * conforme a CPU) e converte só as posições encontradas em registros.
+ * 
+ * Retorna o número de processos que possuem a classe especificada.
+ */
+int count_id_colunar(const ProcessosColunar *colunar, int id_classe) {
+    long long medicao = metricas_inicio();
+    int count = (int)simd_conta_registros_com(colunar->classe_offset, colunar->tamanho, colunar->classe_valores,
+                                              &id_classe, 1, simd_detecta());
+    metricas_registra(METRICA_CONSULTA, medicao, colunar->tamanho);
+    return count;
+}
+
+/**
+ * count_assuntos_colunar - Versão colunar de `count_assuntos`.
+ * 
+ * @colunar: Base colunar.
+ * 
+ * Os assuntos são lidos diretamente do array de valores concatenados e contados por
+ * `conta_distintos` (bitmap para faixas densas, tabela hash nos demais casos).
+ * 
+ * Retorna o número de assuntos únicos encontrados ou 0 se não houver memória.
+ */
+long unsigned int count_assuntos_colunar(const ProcessosColunar *colunar) {
+    long long medicao = metricas_inicio();
+    long unsigned int count = conta_distintos(colunar->assunto_valores, colunar->assunto_offset[colunar->tamanho]);
+    metricas_registra(METRICA_CONSULTA, medicao, colunar->tamanho);
+    return count;
+}
+
+/**
+ * mais_de_um_assunto_colunar - Versão colunar de `mais_de_um_assunto`.
+ * 
+ * @colunar: Base colunar.
+ * 
+ * O número de assuntos de cada registro é a diferença entre deslocamentos consecutivos,
+ * calculada vários registros por vez pelo kernel vetorial de `simd.c`.
+ * 
+ * Retorna o número de processos que possuem mais de um assunto.
+ */
+int mais_de_um_assunto_colunar(const ProcessosColunar *colunar) {
+    long long medicao = metricas_inicio();
+    int count = (int)simd_conta_tamanho_maior(colunar->assunto_offset, colunar->tamanho, 1, simd_detecta());
+    metricas_registra(METRICA_CONSULTA, medicao, colunar->tamanho);
+    return count;
+}
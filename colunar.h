@@ -0,0 +1,27 @@
+#ifndef COLUNAR_H
+#define COLUNAR_H
+
+#include "processo.h"
+
+// Representação colunar (struct-of-arrays) da base de processos.
+// As listas de classe e assunto do registro i ocupam as posições
+// [offset[i], offset[i+1]) dos respectivos arrays de valores (formato CSR).
+typedef struct {
+    long unsigned int tamanho;          // Número de registros
+    int *id;                            // ID de cada registro
+    long long *timestamp;               // Data de ajuizamento em milissegundos desde 1970-01-01 (UTC)
+    int *ano_eleicao;                   // Ano da eleição de cada registro
+    long unsigned int *classe_offset;   // tamanho + 1 posições
+    int *classe_valores;                // IDs de classe concatenados
+    long unsigned int *assunto_offset;  // tamanho + 1 posições
+    int *assunto_valores;               // IDs de assunto concatenados
+} ProcessosColunar;
+
+int colunar_constroi(const Processo *processos, long unsigned int processos_size, ProcessosColunar *colunar);
+void colunar_libera(ProcessosColunar *colunar);
+long unsigned int colunar_bytes(const ProcessosColunar *colunar);
+
+int count_id_colunar(const ProcessosColunar *colunar, int id_classe);
+long unsigned int count_assuntos_colunar(const ProcessosColunar *colunar);
+int mais_de_um_assunto_colunar(const ProcessosColunar *colunar);
+#endif
@@ -0,0 +1,438 @@
+#include "conjunto.h"
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+// Valor reservado para marcar posições livres da tabela
+#define CONJUNTO_VAZIO INT_MIN
+
+// Faixa máxima de valores (max - min + 1) para a qual `conta_distintos` usa um bitmap
+#define LIMITE_BITMAP ((long unsigned int)1 << 28)
+
+/**
+ * espalha - Mistura os bits de um inteiro (finalizador do MurmurHash3 de 64 bits).
+ */
+static unsigned long long espalha(int valor) {
+    unsigned long long h = (unsigned long long)(unsigned int)valor;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * conjunto_inicializa - Cria um conjunto vazio.
+ * 
+ * @conjunto: Conjunto a ser inicializado.
+ * @capacidade_inicial: Número esperado de elementos distintos (a tabela cresce se necessário).
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int conjunto_inicializa(ConjuntoInteiros *conjunto, long unsigned int capacidade_inicial) {
+    long unsigned int capacidade = 16;
+
+    // Mantém a ocupação abaixo de 50%
+    while (capacidade < capacidade_inicial * 2) {
+        capacidade *= 2;
+    }
+
+    conjunto->chaves = malloc(capacidade * sizeof(int));
+    if (conjunto->chaves == NULL) {
+        return -1;
+    }
+    for (long unsigned int i = 0; i < capacidade; i++) {
+        conjunto->chaves[i] = CONJUNTO_VAZIO;
+    }
+    conjunto->capacidade = capacidade;
+    conjunto->tamanho = 0;
+    conjunto->contem_vazio = 0;
+    return 0;
+}
+
+/**
+ * posicao - Retorna a posição de `valor` na tabela ou a posição livre onde ele seria inserido.
+ */
+static long unsigned int posicao(const ConjuntoInteiros *conjunto, int valor) {
+    long unsigned int mascara = conjunto->capacidade - 1;
+    long unsigned int i = (long unsigned int)espalha(valor) & mascara;
+
+    while (conjunto->chaves[i] != CONJUNTO_VAZIO && conjunto->chaves[i] != valor) {
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+/**
+ * cresce - Dobra a capacidade da tabela e reinsere os elementos.
+ */
+static int cresce(ConjuntoInteiros *conjunto) {
+    ConjuntoInteiros novo;
+
+    if (conjunto_inicializa(&novo, conjunto->capacidade) != 0) {
+        return -1;
+    }
+    for (long unsigned int i = 0; i < conjunto->capacidade; i++) {
+        if (conjunto->chaves[i] != CONJUNTO_VAZIO) {
+            novo.chaves[posicao(&novo, conjunto->chaves[i])] = conjunto->chaves[i];
+        }
+    }
+    novo.tamanho = conjunto->tamanho;
+    novo.contem_vazio = conjunto->contem_vazio;
+
+    free(conjunto->chaves);
+    *conjunto = novo;
+    return 0;
+}
+
+/**
+ * conjunto_insere - Insere um valor no conjunto.
+ * 
+ * @conjunto: Conjunto onde o valor será inserido.
+ * @valor: Valor a inserir.
+ * 
+ * Retorna 1 se o valor era novo, 0 se já estava presente ou -1 se não houver memória.
+ */
+int conjunto_insere(ConjuntoInteiros *conjunto, int valor) {
+    if (valor == CONJUNTO_VAZIO) {
+        if (conjunto->contem_vazio) {
+            return 0;
+        }
+        conjunto->contem_vazio = 1;
+        conjunto->tamanho++;
+        return 1;
+    }
+
+    long unsigned int i = posicao(conjunto, valor);
+    if (conjunto->chaves[i] == valor) {
+        return 0;
+    }
+
+    if ((conjunto->tamanho + 1) * 2 > conjunto->capacidade) {
+        if (cresce(conjunto) != 0) {
+            return -1;
+        }
+        i = posicao(conjunto, valor);
+    }
+    conjunto->chaves[i] = valor;
+    conjunto->tamanho++;
+    return 1;
+}
+
+/**
+ * conjunto_contem - Verifica se um valor pertence ao conjunto.
+ * 
+ * Retorna 1 se o valor estiver presente ou 0 caso contrário.
+ */
+int conjunto_contem(const ConjuntoInteiros *conjunto, int valor) {
+    if (valor == CONJUNTO_VAZIO) {
+        return conjunto->contem_vazio;
+    }
+    return conjunto->chaves[posicao(conjunto, valor)] == valor;
+}
+
+/**
+ * conjunto_libera - Libera a tabela do conjunto.
+ */
+void conjunto_libera(ConjuntoInteiros *conjunto) {
+    free(conjunto->chaves);
+    conjunto->chaves = NULL;
+    conjunto->capacidade = 0;
+    conjunto->tamanho = 0;
+    conjunto->contem_vazio = 0;
+}
+
+/**
+ * conta_distintos - Conta os valores distintos de um array em tempo O(n).
+ * 
+ * @valores: Array de inteiros.
+ * @n: Tamanho do array.
+ * 
+ * Quando a faixa de valores (máximo - mínimo) é densa, isto é, não muito maior que `n` e
+ * abaixo de `LIMITE_BITMAP`, usa um bitmap indexado por `valor - mínimo`; caso contrário,
+ * usa um `ConjuntoInteiros`.
+ * 
+ * Retorna o número de valores distintos ou 0 se não houver memória para o conjunto.
+ */
+long unsigned int conta_distintos(const int *valores, long unsigned int n) {
+    if (n == 0) {
+        return 0;
+    }
+
+    int minimo = valores[0];
+    int maximo = valores[0];
+    for (long unsigned int i = 1; i < n; i++) {
+        if (valores[i] < minimo) {
+            minimo = valores[i];
+        }
+        if (valores[i] > maximo) {
+            maximo = valores[i];
+        }
+    }
+
+    long unsigned int faixa = (long unsigned int)((long long)maximo - (long long)minimo) + 1;
+    long unsigned int count = 0;
+
+    if (faixa <= LIMITE_BITMAP && faixa / 64 <= n) {
+        unsigned long long *bitmap = calloc((faixa + 63) / 64, sizeof(unsigned long long));
+        if (bitmap != NULL) {
+            for (long unsigned int i = 0; i < n; i++) {
+                long unsigned int bit = (long unsigned int)((long long)valores[i] - minimo);
+                unsigned long long mascara = 1ULL << (bit % 64);
+                count += (bitmap[bit / 64] & mascara) == 0;
+                bitmap[bit / 64] |= mascara;
+            }
+            free(bitmap);
+            return count;
+        }
+    }
+
+    ConjuntoInteiros conjunto;
+    if (conjunto_inicializa(&conjunto, 1024) != 0) {
+        return 0;
+    }
+    for (long unsigned int i = 0; i < n; i++) {
+        if (conjunto_insere(&conjunto, valores[i]) < 0) {
+            conjunto_libera(&conjunto);
+            return 0;
+        }
+    }
+    count = conjunto.tamanho;
+    conjunto_libera(&conjunto);
+    return count;
+}
+
+/**
+ * mapa_inicializa - Cria um mapa vazio.
+ * 
+ * @mapa: Mapa a ser inicializado.
+ * @capacidade_inicial: Número esperado de chaves (a tabela cresce se necessário).
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int mapa_inicializa(MapaInteiros *mapa, long unsigned int capacidade_inicial) {
+    long unsigned int capacidade = 16;
+
+    // Mantém a ocupação abaixo de 50%
+    while (capacidade < capacidade_inicial * 2) {
+        capacidade *= 2;
+    }
+
+    mapa->chaves = malloc(capacidade * sizeof(int));
+    mapa->valores = malloc(capacidade * sizeof(long unsigned int));
+    mapa->ocupado = calloc(capacidade, 1);
+    if (mapa->chaves == NULL || mapa->valores == NULL || mapa->ocupado == NULL) {
+        mapa_libera(mapa);
+        return -1;
+    }
+    mapa->capacidade = capacidade;
+    mapa->tamanho = 0;
+    return 0;
+}
+
+/**
+ * posicao_mapa - Retorna a posição de `chave` na tabela ou a posição livre onde ela seria inserida.
+ */
+static long unsigned int posicao_mapa(const MapaInteiros *mapa, int chave) {
+    long unsigned int mascara = mapa->capacidade - 1;
+    long unsigned int i = (long unsigned int)espalha(chave) & mascara;
+
+    while (mapa->ocupado[i] && mapa->chaves[i] != chave) {
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+/**
+ * mapa_insere - Associa `valor` a `chave`, substituindo o valor anterior se a chave já existir.
+ * 
+ * Retorna 1 se a chave era nova, 0 se já existia ou -1 se não houver memória.
+ */
+int mapa_insere(MapaInteiros *mapa, int chave, long unsigned int valor) {
+    long unsigned int i = posicao_mapa(mapa, chave);
+
+    if (mapa->ocupado[i]) {
+        mapa->valores[i] = valor;
+        return 0;
+    }
+
+    if ((mapa->tamanho + 1) * 2 > mapa->capacidade) {
+        MapaInteiros novo;
+        if (mapa_inicializa(&novo, mapa->capacidade) != 0) {
+            return -1;
+        }
+        for (long unsigned int j = 0; j < mapa->capacidade; j++) {
+            if (mapa->ocupado[j]) {
+                long unsigned int k = posicao_mapa(&novo, mapa->chaves[j]);
+                novo.chaves[k] = mapa->chaves[j];
+                novo.valores[k] = mapa->valores[j];
+                novo.ocupado[k] = 1;
+            }
+        }
+        novo.tamanho = mapa->tamanho;
+        mapa_libera(mapa);
+        *mapa = novo;
+        i = posicao_mapa(mapa, chave);
+    }
+
+    mapa->chaves[i] = chave;
+    mapa->valores[i] = valor;
+    mapa->ocupado[i] = 1;
+    mapa->tamanho++;
+    return 1;
+}
+
+/**
+ * mapa_busca - Procura uma chave no mapa.
+ * 
+ * @valor: Ponteiro que receberá o valor associado, se a chave existir (pode ser NULL).
+ * 
+ * Retorna 1 se a chave existir ou 0 caso contrário.
+ */
+int mapa_busca(const MapaInteiros *mapa, int chave, long unsigned int *valor) {
+    long unsigned int i = posicao_mapa(mapa, chave);
+
+    if (!mapa->ocupado[i]) {
+        return 0;
+    }
+    if (valor != NULL) {
+        *valor = mapa->valores[i];
+    }
+    return 1;
+}
+
+/**
+ * mapa_remove - Remove uma chave do mapa.
+ * 
+ * As chaves seguintes do mesmo agrupamento são recuadas (remoção por deslocamento), de modo que
+ * a sondagem linear continua encontrando todas sem marcas de posição removida.
+ * 
+ * Retorna 1 se a chave existia ou 0 caso contrário.
+ */
+int mapa_remove(MapaInteiros *mapa, int chave) {
+    long unsigned int mascara = mapa->capacidade - 1;
+    long unsigned int i = posicao_mapa(mapa, chave);
+
+    if (!mapa->ocupado[i]) {
+        return 0;
+    }
+    for (long unsigned int j = (i + 1) & mascara; mapa->ocupado[j]; j = (j + 1) & mascara) {
+        // A chave em `j` pode ocupar `i` se sua posição ideal não estiver no trecho (i, j]
+        long unsigned int ideal = (long unsigned int)espalha(mapa->chaves[j]) & mascara;
+        if (((j - ideal) & mascara) >= ((j - i) & mascara)) {
+            mapa->chaves[i] = mapa->chaves[j];
+            mapa->valores[i] = mapa->valores[j];
+            i = j;
+        }
+    }
+    mapa->ocupado[i] = 0;
+    mapa->tamanho--;
+    return 1;
+}
+
+/**
+ * mapa_bytes - Calcula a memória ocupada pela tabela do mapa, em bytes.
+ */
+long unsigned int mapa_bytes(const MapaInteiros *mapa) {
+    return mapa->capacidade * (sizeof(int) + sizeof(long unsigned int) + 1);
+}
+
+/**
+ * mapa_libera - Libera a tabela do mapa.
+ */
+void mapa_libera(MapaInteiros *mapa) {
+    free(mapa->chaves);
+    free(mapa->valores);
+    free(mapa->ocupado);
+    mapa->chaves = NULL;
+    mapa->valores = NULL;
+    mapa->ocupado = NULL;
+    mapa->capacidade = 0;
+    mapa->tamanho = 0;
+}
+
+/**
+ * hll_inicializa - Cria um estimador HyperLogLog vazio.
+ * 
+ * @hll: Estimador a ser inicializado.
+ * @precisao: Número de bits de índice (4 a 18). O erro padrão é cerca de 1.04 / sqrt(2^precisao)
+ *            e a memória usada é de 2^precisao bytes (ex.: precisão 14 → 16 KB, erro ~0.8%).
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se a precisão for inválida ou não houver memória.
+ */
+int hll_inicializa(HyperLogLog *hll, int precisao) {
+    if (precisao < 4 || precisao > 18) {
+        return -1;
+    }
+    hll->registradores = calloc((size_t)1 << precisao, 1);
+    if (hll->registradores == NULL) {
+        return -1;
+    }
+    hll->precisao = precisao;
+    return 0;
+}
+
+/**
+ * hll_adiciona - Registra um valor no estimador.
+ */
+void hll_adiciona(HyperLogLog *hll, int valor) {
+    unsigned long long h = espalha(valor);
+    long unsigned int indice = (long unsigned int)(h >> (64 - hll->precisao));
+    unsigned long long resto = h << hll->precisao;
+
+    // Posição do primeiro bit 1 nos bits restantes (1 a 65 - precisao)
+    unsigned char rank = resto == 0
+        ? (unsigned char)(64 - hll->precisao + 1)
+        : (unsigned char)(__builtin_clzll(resto) + 1);
+    if (rank > hll->registradores[indice]) {
+        hll->registradores[indice] = rank;
+    }
+}
+
+/**
+ * hll_junta - Acumula em `destino` os valores registrados em `origem` (mesma precisão).
+ * 
+ * Permite estimar em paralelo: cada thread mantém seu estimador e os resultados são juntados no final.
+ */
+void hll_junta(HyperLogLog *destino, const HyperLogLog *origem) {
+    long unsigned int m = (long unsigned int)1 << destino->precisao;
+
+    for (long unsigned int i = 0; i < m; i++) {
+        if (origem->registradores[i] > destino->registradores[i]) {
+            destino->registradores[i] = origem->registradores[i];
+        }
+    }
+}
+
+/**
+ * hll_estimativa - Estima o número de valores distintos registrados.
+ * 
+ * Usa a correção de contagem linear para cardinalidades pequenas.
+ */
+double hll_estimativa(const HyperLogLog *hll) {
+    long unsigned int m = (long unsigned int)1 << hll->precisao;
+    double alfa = 0.7213 / (1.0 + 1.079 / (double)m);
+    double soma = 0.0;
+    long unsigned int zeros = 0;
+
+    for (long unsigned int i = 0; i < m; i++) {
+        soma += ldexp(1.0, -hll->registradores[i]);
+        zeros += hll->registradores[i] == 0;
+    }
+
+    double estimativa = alfa * (double)m * (double)m / soma;
+    if (estimativa <= 2.5 * (double)m && zeros > 0) {
+        estimativa = (double)m * log((double)m / (double)zeros);
+    }
+    return estimativa;
+}
+
+/**
+ * hll_libera - Libera os registradores do estimador.
+ */
+void hll_libera(HyperLogLog *hll) {
+    free(hll->registradores);
+    hll->registradores = NULL;
+}
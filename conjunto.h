@@ -0,0 +1,47 @@
+#ifndef CONJUNTO_H
+#define CONJUNTO_H
+
+#include<stdlib.h>
+
+// Conjunto de inteiros com endereçamento aberto (sondagem linear)
+typedef struct {
+    int *chaves;                    // Tabela de chaves (CONJUNTO_VAZIO marca posição livre)
+    long unsigned int capacidade;   // Número de posições da tabela (potência de 2)
+    long unsigned int tamanho;      // Número de elementos distintos armazenados
+    int contem_vazio;               // Indica se o próprio valor CONJUNTO_VAZIO foi inserido
+} ConjuntoInteiros;
+
+// Mapa de inteiros para índices (endereçamento aberto com sondagem linear)
+typedef struct {
+    int *chaves;                    // Chaves armazenadas
+    long unsigned int *valores;     // Valor associado a cada chave
+    unsigned char *ocupado;         // Indica as posições em uso
+    long unsigned int capacidade;   // Número de posições da tabela (potência de 2)
+    long unsigned int tamanho;      // Número de chaves armazenadas
+} MapaInteiros;
+
+// Estimador HyperLogLog para contagem aproximada de distintos
+typedef struct {
+    unsigned char *registradores;   // 2^precisao registradores
+    int precisao;                   // Bits do hash usados para escolher o registrador (4 a 18)
+} HyperLogLog;
+
+int conjunto_inicializa(ConjuntoInteiros *conjunto, long unsigned int capacidade_inicial);
+int conjunto_insere(ConjuntoInteiros *conjunto, int valor);
+int conjunto_contem(const ConjuntoInteiros *conjunto, int valor);
+void conjunto_libera(ConjuntoInteiros *conjunto);
+long unsigned int conta_distintos(const int *valores, long unsigned int n);
+
+int mapa_inicializa(MapaInteiros *mapa, long unsigned int capacidade_inicial);
+int mapa_insere(MapaInteiros *mapa, int chave, long unsigned int valor);
+int mapa_busca(const MapaInteiros *mapa, int chave, long unsigned int *valor);
+int mapa_remove(MapaInteiros *mapa, int chave);
+long unsigned int mapa_bytes(const MapaInteiros *mapa);
+void mapa_libera(MapaInteiros *mapa);
+
+int hll_inicializa(HyperLogLog *hll, int precisao);
+void hll_adiciona(HyperLogLog *hll, int valor);
+void hll_junta(HyperLogLog *destino, const HyperLogLog *origem);
+double hll_estimativa(const HyperLogLog *hll);
+void hll_libera(HyperLogLog *hll);
+#endif
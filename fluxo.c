@@ -0,0 +1,241 @@
+#include "fluxo.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Tamanho inicial do buffer de leitura
+#define FLUXO_BUFFER_LEITURA ((size_t)4 << 20)
+
+static void consome_count_id(Agregador *agregador, const Processo *lote, long unsigned int n) {
+    for (long unsigned int i = 0; i < n; i++) {
+        for (int j = 0; j < lote[i].classe_len; j++) {
+            if (lote[i].classe[j] == agregador->parametro) {
+                agregador->resultado++;
+                break; // Evita contar várias vezes o mesmo registro
+            }
+        }
+    }
+}
+
+static void consome_count_assuntos(Agregador *agregador, const Processo *lote, long unsigned int n) {
+    ConjuntoInteiros *assuntos = agregador->estado;
+
+    for (long unsigned int i = 0; i < n; i++) {
+        for (int j = 0; j < lote[i].assunto_len; j++) {
+            if (conjunto_insere(assuntos, lote[i].assunto[j]) < 0) {
+                agregador->erro = 1;
+                return;
+            }
+        }
+    }
+    agregador->resultado = assuntos->tamanho;
+}
+
+static void libera_count_assuntos(Agregador *agregador) {
+    conjunto_libera(agregador->estado);
+    free(agregador->estado);
+    agregador->estado = NULL;
+}
+
+static void consome_mais_de_um_assunto(Agregador *agregador, const Processo *lote, long unsigned int n) {
+    for (long unsigned int i = 0; i < n; i++) {
+        agregador->resultado += lote[i].assunto_len > 1;
+    }
+}
+
+static void consome_total(Agregador *agregador, const Processo *lote, long unsigned int n) {
+    (void)lote;
+    agregador->resultado += n;
+}
+
+/**
+ * agregador_count_id - Prepara um agregador equivalente a `count_id`.
+ * 
+ * @agregador: Agregador a ser preparado.
+ * @id_classe: ID da classe a ser contada.
+ */
+void agregador_count_id(Agregador *agregador, int id_classe) {
+    memset(agregador, 0, sizeof(Agregador));
+    agregador->consome = consome_count_id;
+    agregador->parametro = id_classe;
+}
+
+/**
+ * agregador_count_assuntos - Prepara um agregador equivalente a `count_assuntos`.
+ * 
+ * O estado é um conjunto de assuntos distintos, cujo tamanho depende apenas do número de
+ * assuntos diferentes e não do tamanho do arquivo.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória (o agregador fica marcado com `erro`).
+ */
+int agregador_count_assuntos(Agregador *agregador) {
+    memset(agregador, 0, sizeof(Agregador));
+    agregador->estado = malloc(sizeof(ConjuntoInteiros));
+    if (agregador->estado == NULL || conjunto_inicializa(agregador->estado, 1024) != 0) {
+        free(agregador->estado);
+        agregador->estado = NULL;
+        agregador->erro = 1;
+        return -1;
+    }
+    agregador->consome = consome_count_assuntos;
+    agregador->libera = libera_count_assuntos;
+    return 0;
+}
+
+/**
+ * agregador_mais_de_um_assunto - Prepara um agregador equivalente a `mais_de_um_assunto`.
+ */
+void agregador_mais_de_um_assunto(Agregador *agregador) {
+    memset(agregador, 0, sizeof(Agregador));
+    agregador->consome = consome_mais_de_um_assunto;
+}
+
+/**
+ * agregador_total - Prepara um agregador que conta os registros válidos.
+ */
+void agregador_total(Agregador *agregador) {
+    memset(agregador, 0, sizeof(Agregador));
+    agregador->consome = consome_total;
+}
+
+/**
+ * agregador_libera - Libera o estado de um agregador, se houver.
+ */
+void agregador_libera(Agregador *agregador) {
+    if (agregador->libera != NULL) {
+        agregador->libera(agregador);
+    }
+}
+
+/**
+ * entrega_lote - Repassa o lote aos agregadores sem erro e descarta os registros.
+ */
+static void entrega_lote(Agregador *agregadores, int num_agregadores, const Processo *lote, long unsigned int *n,
+                         Arena *arena) {
+    for (int a = 0; a < num_agregadores; a++) {
+        if (!agregadores[a].erro) {
+            agregadores[a].consome(&agregadores[a], lote, *n);
+        }
+    }
+    *n = 0;
+    arena_libera(arena);
+}
+
+/**
+ * fluxo_executa - Responde às consultas agregadas lendo o CSV em fluxo, sem carregar a base.
+ * 
+ * @nome_arquivo: Nome do arquivo CSV.
+ * @agregadores: Agregadores preparados com `agregador_*` (ou próprios do chamador).
+ * @num_agregadores: Número de agregadores.
+ * @tamanho_lote: Registros por lote; se 0, usa `FLUXO_LOTE_PADRAO`.
+ * @stats: Estrutura que receberá linhas, bytes e tempo da leitura (pode ser NULL).
+ * 
+ * O arquivo é lido em blocos de tamanho fixo; as linhas completas de cada bloco são analisadas
+ * por `parse_registro` em um lote de `tamanho_lote` registros, cujos campos ficam em uma arena.
+ * Quando o lote enche, ele é entregue a todos os agregadores e descartado. O consumo de memória
+ * é constante (buffer de leitura + lote + estado dos agregadores), qualquer que seja o tamanho
+ * do arquivo, e os resultados são os mesmos das funções que operam sobre a base carregada.
+ * Se um agregador ficar sem memória, o erro é informado e o agregador fica marcado com `erro`.
+ * 
+ * Retorna o número de registros processados ou 1 em caso de erro ao abrir o arquivo.
+ */
+long unsigned int fluxo_executa(const char *nome_arquivo, Agregador *agregadores, int num_agregadores,
+                                long unsigned int tamanho_lote, EstatisticasLeitura *stats) {
+    double inicio = agora_segundos();
+
+    if (tamanho_lote == 0) {
+        tamanho_lote = FLUXO_LOTE_PADRAO;
+    }
+
+    int fd = open(nome_arquivo, O_RDONLY);
+    if (fd == -1) {
+        printf("Erro ao abrir o arquivo.\n");
+        return 1; // Retorna 1 em caso de erro
+    }
+
+    size_t capacidade = FLUXO_BUFFER_LEITURA;
+    char *buffer = malloc(capacidade);
+    Processo *lote = malloc(tamanho_lote * sizeof(Processo));
+    Arena arena;
+    arena_inicializa(&arena, 0);
+    if (buffer == NULL || lote == NULL) {
+        printf("Erro ao alocar memória para o processamento em fluxo.\n");
+        free(buffer);
+        free(lote);
+        close(fd);
+        return 1;
+    }
+
+    long unsigned int total = 0;
+    long unsigned int bytes = 0;
+    long unsigned int no_lote = 0;
+    size_t pendente = 0;    // Bytes de uma linha incompleta no início do buffer
+    int cabecalho = 1;      // A primeira linha ainda não foi descartada
+    ssize_t lido;
+
+    do {
+        // Uma linha maior que o buffer inteiro: dobra o buffer
+        if (pendente == capacidade) {
+            char *maior = realloc(buffer, capacidade * 2);
+            if (maior == NULL) {
+                printf("Erro ao alocar memória para o processamento em fluxo.\n");
+                break;
+            }
+            buffer = maior;
+            capacidade *= 2;
+        }
+
+        lido = read(fd, buffer + pendente, capacidade - pendente);
+        if (lido < 0) {
+            printf("Erro ao ler o arquivo.\n");
+            break;
+        }
+        bytes += (long unsigned int)lido;
+
+        const char *p = buffer;
+        const char *fim = buffer + pendente + (size_t)lido;
+        while (p < fim) {
+            const char *nl = memchr(p, '\n', (size_t)(fim - p));
+            if (nl == NULL && lido > 0) {
+                break; // Linha incompleta: aguarda o próximo bloco
+            }
+            const char *fim_linha = nl != NULL ? nl : fim;
+
+            if (cabecalho) {
+                cabecalho = 0;
+            } else if (parse_registro(p, fim_linha, &lote[no_lote], &arena) == 6) {
+                no_lote++;
+                total++;
+                if (no_lote == tamanho_lote) {
+                    entrega_lote(agregadores, num_agregadores, lote, &no_lote, &arena);
+                }
+            }
+            p = fim_linha + 1;
+        }
+
+        // Move a linha incompleta para o início do buffer
+        pendente = p < fim ? (size_t)(fim - p) : 0;
+        memmove(buffer, p, pendente);
+    } while (lido > 0);
+
+    if (no_lote > 0) {
+        entrega_lote(agregadores, num_agregadores, lote, &no_lote, &arena);
+    }
+    for (int a = 0; a < num_agregadores; a++) {
+        if (agregadores[a].erro) {
+            printf("Erro ao alocar memória para o agregador %d; o resultado dele não é válido.\n", a);
+        }
+    }
+
+    arena_libera(&arena);
+    free(lote);
+    free(buffer);
+    close(fd);
+
+    if (stats != NULL) {
+        stats->linhas = total;
+        stats->bytes = bytes;
+        stats->segundos = agora_segundos() - inicio;
+    }
+    return total;
+}
@@ -0,0 +1,31 @@
+#ifndef FLUXO_H
+#define FLUXO_H
+
+#include "processo.h"
+#include "conjunto.h"
+
+// Tamanho padrão do lote de registros do processamento em fluxo
+#define FLUXO_LOTE_PADRAO 4096
+
+// Agregador alimentado lote a lote pelo processamento em fluxo.
+// `consome` recebe cada lote de registros, que é descartado logo em seguida;
+// o agregador deve copiar o que precisar guardar. Um agregador que fica sem memória marca `erro`
+// e deixa de receber lotes; seu resultado não é válido.
+typedef struct Agregador {
+    void (*consome)(struct Agregador *agregador, const Processo *lote, long unsigned int n);
+    void (*libera)(struct Agregador *agregador);    // Libera `estado` (pode ser NULL)
+    int parametro;                                  // Parâmetro do agregador (ex.: id da classe)
+    long unsigned int resultado;                    // Resultado acumulado
+    void *estado;                                   // Estado adicional do agregador
+    int erro;                                       // Diferente de 0 se faltou memória
+} Agregador;
+
+void agregador_count_id(Agregador *agregador, int id_classe);
+int agregador_count_assuntos(Agregador *agregador);
+void agregador_mais_de_um_assunto(Agregador *agregador);
+void agregador_total(Agregador *agregador);
+void agregador_libera(Agregador *agregador);
+
+long unsigned int fluxo_executa(const char *nome_arquivo, Agregador *agregadores, int num_agregadores,
+                                long unsigned int tamanho_lote, EstatisticasLeitura *stats);
+#endif
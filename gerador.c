@@ -0,0 +1,236 @@
+#include "gerador.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Tamanho do buffer de escrita do gerador
+#define TAMANHO_BUFFER_GERADOR ((size_t)1 << 20)
+
+// Os ids são uma permutação de [ID_BASE, ID_BASE + ID_FAIXA): únicos para até ID_FAIXA registros
+#define ID_BASE 100000000u
+#define ID_FAIXA 900000000u
+#define ID_MULTIPLICADOR 2654435761u    // Ímpar e sem fatores 3 ou 5, logo coprimo com ID_FAIXA
+
+// Valor com peso relativo, usado nas distribuições abaixo
+typedef struct {
+    int valor;
+    int peso;
+} ValorPonderado;
+
+// Distribuições aproximadas de processo_043_202409032338.csv
+static const ValorPonderado CLASSES[] = {
+    {12553, 3558}, {12552, 1622}, {11531, 1471}, {12559, 1306}, {11541, 1139}, {12549, 1099},
+    {11532, 991}, {12193, 874}, {12561, 783}, {355, 652}, {261, 593}, {241, 551}, {12554, 500},
+    {12551, 450}, {12377, 400}, {11533, 300}, {1727, 250}, {279, 250}, {156, 200}, {11528, 150}
+};
+
+static const ValorPonderado ASSUNTOS[] = {
+    {11778, 17821}, {3628, 166}, {3555, 85}, {11701, 45}, {3612, 29}, {11438, 19}, {11700, 14},
+    {3568, 13}, {11472, 13}, {10602, 13}, {11731, 11}
+};
+
+static const ValorPonderado ANOS_AJUIZAMENTO[] = {
+    {2012, 25}, {2013, 65}, {2014, 232}, {2015, 1111}, {2016, 271}, {2017, 1429}, {2018, 2400},
+    {2019, 1081}, {2020, 994}, {2021, 1384}, {2022, 5497}, {2023, 2728}, {2024, 1164}
+};
+
+static const ValorPonderado ANOS_ELEICAO[] = {
+    {0, 13160}, {2022, 2888}, {2018, 1645}, {2020, 255}, {2014, 212}, {2010, 90}, {2016, 48},
+    {2024, 33}, {2008, 28}, {2012, 18}
+};
+
+// Probabilidades (em 1/10000) de uma lista ter mais de um item, como no arquivo original
+#define CHANCE_CLASSE_MULTIPLA 200
+#define CHANCE_ASSUNTO_MULTIPLO 50
+
+#define NUM_ITENS(v) ((int)(sizeof(v) / sizeof((v)[0])))
+
+/**
+ * proximo_aleatorio - Gerador xorshift64*, suficiente para dados sintéticos e reprodutível pela semente.
+ */
+static unsigned long long proximo_aleatorio(unsigned long long *estado) {
+    unsigned long long x = *estado;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *estado = x;
+    return x * 2685821657736338717ULL;
+}
+
+/**
+ * aleatorio_ate - Retorna um valor aleatório em [0, limite).
+ */
+static unsigned int aleatorio_ate(unsigned long long *estado, unsigned int limite) {
+    return (unsigned int)((proximo_aleatorio(estado) >> 32) % limite);
+}
+
+/**
+ * sorteia - Sorteia um valor de `tabela` respeitando os pesos.
+ */
+static int sorteia(unsigned long long *estado, const ValorPonderado *tabela, int tamanho) {
+    int total = 0;
+    for (int i = 0; i < tamanho; i++) {
+        total += tabela[i].peso;
+    }
+
+    int r = (int)aleatorio_ate(estado, (unsigned int)total);
+    for (int i = 0; i < tamanho; i++) {
+        if (r < tabela[i].peso) {
+            return tabela[i].valor;
+        }
+        r -= tabela[i].peso;
+    }
+    return tabela[tamanho - 1].valor;
+}
+
+/**
+ * escreve_digitos - Escreve `valor` com exatamente `largura` dígitos, completando com zeros à esquerda.
+ */
+static char *escreve_digitos(char *p, unsigned int valor, int largura) {
+    for (int i = largura - 1; i >= 0; i--) {
+        p[i] = (char)('0' + valor % 10);
+        valor /= 10;
+    }
+    return p + largura;
+}
+
+/**
+ * escreve_lista - Escreve uma lista de classes ou assuntos, entre aspas quando tiver mais de um item.
+ */
+static char *escreve_lista(char *p, unsigned long long *estado, const ValorPonderado *tabela, int tamanho,
+                           int chance_multipla) {
+    int itens = 1;
+    if ((int)aleatorio_ate(estado, 10000) < chance_multipla) {
+        itens = 2 + (aleatorio_ate(estado, 10) == 0);
+    }
+
+    if (itens > 1) {
+        *p++ = '"';
+    }
+    *p++ = '{';
+    int sorteados[3];
+    for (int i = 0; i < itens; i++) {
+        // Sorteia de novo os itens repetidos, que não ocorrem na base original
+        int valor, repetido;
+        do {
+            valor = sorteia(estado, tabela, tamanho);
+            repetido = 0;
+            for (int j = 0; j < i; j++) {
+                repetido |= sorteados[j] == valor;
+            }
+        } while (repetido);
+        sorteados[i] = valor;
+
+        if (i > 0) {
+            *p++ = ',';
+        }
+        p = formata_inteiro(valor, p);
+    }
+    *p++ = '}';
+    if (itens > 1) {
+        *p++ = '"';
+    }
+    return p;
+}
+
+/**
+ * escreve_linha - Escreve o i-ésimo registro sintético no formato de entrada (separado por vírgulas).
+ */
+static char *escreve_linha(char *p, unsigned long long *estado, long unsigned int i) {
+    unsigned int id = ID_BASE + (unsigned int)(((unsigned long long)i * ID_MULTIPLICADOR) % ID_FAIXA);
+    int ano = sorteia(estado, ANOS_AJUIZAMENTO, NUM_ITENS(ANOS_AJUIZAMENTO));
+
+    p = formata_inteiro((int)id, p);
+
+    // Numeração única no padrão NNNNNNN-DD.AAAA.J.TR.OOOO, sem pontuação
+    *p++ = ',';
+    *p++ = '"';
+    p = escreve_digitos(p, aleatorio_ate(estado, 10000000), 7);
+    p = escreve_digitos(p, aleatorio_ate(estado, 100), 2);
+    p = escreve_digitos(p, (unsigned int)ano, 4);
+    memcpy(p, "607", 3);
+    p += 3;
+    p = escreve_digitos(p, aleatorio_ate(estado, 100), 4);
+    *p++ = '"';
+    *p++ = ',';
+
+    // Data no formato AAAA-MM-DD HH:MM:SS.000
+    p = escreve_digitos(p, (unsigned int)ano, 4);
+    *p++ = '-';
+    p = escreve_digitos(p, 1 + aleatorio_ate(estado, 12), 2);
+    *p++ = '-';
+    p = escreve_digitos(p, 1 + aleatorio_ate(estado, 28), 2);
+    *p++ = ' ';
+    p = escreve_digitos(p, aleatorio_ate(estado, 24), 2);
+    *p++ = ':';
+    p = escreve_digitos(p, aleatorio_ate(estado, 60), 2);
+    *p++ = ':';
+    p = escreve_digitos(p, aleatorio_ate(estado, 60), 2);
+    memcpy(p, ".000,", 5);
+    p += 5;
+
+    p = escreve_lista(p, estado, CLASSES, NUM_ITENS(CLASSES), CHANCE_CLASSE_MULTIPLA);
+    *p++ = ',';
+    p = escreve_lista(p, estado, ASSUNTOS, NUM_ITENS(ASSUNTOS), CHANCE_ASSUNTO_MULTIPLO);
+    *p++ = ',';
+    p = formata_inteiro(sorteia(estado, ANOS_ELEICAO, NUM_ITENS(ANOS_ELEICAO)), p);
+    *p++ = '\n';
+    return p;
+}
+
+/**
+ * gera_csv_sintetico - Gera um CSV com o mesmo formato e distribuições aproximadas da base original.
+ *
+ * @nome_arquivo: Nome do arquivo a ser criado.
+ * @registros: Número de linhas de dados.
+ * @semente: Semente do gerador; a mesma semente produz o mesmo arquivo.
+ *
+ * Os ids são únicos (até 900 milhões de registros) e aparecem fora de ordem. Classes, assuntos,
+ * anos de ajuizamento e de eleição seguem as frequências de `processo_043_202409032338.csv`,
+ * inclusive as listas com mais de um item entre aspas.
+ *
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+int gera_csv_sintetico(const char *nome_arquivo, long unsigned int registros, unsigned int semente) {
+    if (registros > ID_FAIXA) {
+        printf("Número de registros sintéticos acima do limite de ids únicos.\n");
+        return -1;
+    }
+
+    int fd = open(nome_arquivo, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd == -1) {
+        printf("Erro ao abrir o arquivo para escrita.\n");
+        return -1;
+    }
+
+    char *buffer = malloc(TAMANHO_BUFFER_GERADOR);
+    if (buffer == NULL) {
+        printf("Erro ao alocar o buffer de escrita.\n");
+        close(fd);
+        return -1;
+    }
+
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL ^ semente;
+    char *p = buffer;
+    int erro = 0;
+
+    memcpy(p, CABECALHO_CSV, strlen(CABECALHO_CSV));
+    p += strlen(CABECALHO_CSV);
+    for (long unsigned int i = 0; i < registros && !erro; i++) {
+        if ((size_t)(p - buffer) > TAMANHO_BUFFER_GERADOR - MAX_LINHA_CSV) {
+            erro = escreve_tudo(fd, buffer, (size_t)(p - buffer)) != 0;
+            p = buffer;
+        }
+        p = escreve_linha(p, &estado, i);
+    }
+    if (!erro) {
+        erro = escreve_tudo(fd, buffer, (size_t)(p - buffer)) != 0;
+    }
+    if (close(fd) != 0 || erro) {
+        printf("Erro ao escrever o arquivo %s.\n", nome_arquivo);
+        erro = 1;
+    }
+
+    free(buffer);
+    return erro ? -1 : 0;
+}
@@ -0,0 +1,7 @@
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include "processo.h"
+
+int gera_csv_sintetico(const char *nome_arquivo, long unsigned int registros, unsigned int semente);
+#endif
@@ -0,0 +1,381 @@
+#include "incremental.h"
+#include "ordenacao.h"
+#include "snapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * base_incremental_inicializa - Prepara uma base vazia.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int base_incremental_inicializa(BaseIncremental *base) {
+    memset(base, 0, sizeof(BaseIncremental));
+    arena_inicializa(&base->arena, 0);
+    if (mapa_inicializa(&base->ids.mapa, 1024) != 0 || mapa_inicializa(&base->contagem_classe, 256) != 0 ||
+        mapa_inicializa(&base->contagem_assunto, 256) != 0) {
+        base_incremental_libera(base);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * base_incremental_libera - Libera os registros, as ordens e os contadores.
+ */
+void base_incremental_libera(BaseIncremental *base) {
+    free(base->processos);
+    free(base->ordem_id);
+    free(base->ordem_data);
+    indice_primario_libera(&base->ids);
+    mapa_libera(&base->contagem_classe);
+    mapa_libera(&base->contagem_assunto);
+    arena_libera(&base->arena);
+    base->processos = NULL;
+    base->ordem_id = NULL;
+    base->ordem_data = NULL;
+    base->tamanho = 0;
+    base->capacidade = 0;
+}
+
+// Estado inicial do checksum (mesmo valor usado pelo snapshot)
+#define CHECKSUM_INICIAL 0xcbf29ce484222325ULL
+
+/**
+ * id_da_linha - Lê só o id no início da linha, sem analisar os demais campos.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se a linha não começar por um inteiro seguido de ','.
+ */
+static int id_da_linha(const char *p, const char *fim, int *id) {
+    int negativo = p < fim && *p == '-';
+    int v = 0;
+
+    p += negativo;
+    if (p >= fim || *p < '0' || *p > '9') {
+        return -1;
+    }
+    while (p < fim && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p++ - '0');
+    }
+    *id = negativo ? -v : v;
+    return p < fim && *p == ',' ? 0 : -1;
+}
+
+/**
+ * soma_contagem - Soma 1 ao contador de `chave` no mapa.
+ */
+static int soma_contagem(MapaInteiros *mapa, int chave) {
+    long unsigned int atual = 0;
+    mapa_busca(mapa, chave, &atual);
+    return mapa_insere(mapa, chave, atual + 1) < 0 ? -1 : 0;
+}
+
+/**
+ * subtrai_contagem - Subtrai 1 do contador de `chave`, removendo a chave quando ele chega a zero.
+ * 
+ * Só atualiza ou remove chaves existentes, então nunca reserva memória.
+ */
+static void subtrai_contagem(MapaInteiros *mapa, int chave) {
+    long unsigned int atual = 0;
+    if (mapa_busca(mapa, chave, &atual) && atual > 1) {
+        mapa_insere(mapa, chave, atual - 1);
+    } else {
+        mapa_remove(mapa, chave);
+    }
+}
+
+/**
+ * conta_lista - Soma (ou subtrai) 1 ao contador de cada valor distinto de uma lista.
+ * 
+ * @sinal: 1 para somar ou -1 para subtrair.
+ * 
+ * Um processo conta uma vez por classe/assunto distinto, como em `count_id`. Se faltar memória
+ * no meio da lista, as somas já feitas são desfeitas e os contadores ficam como estavam.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+static int conta_lista(MapaInteiros *mapa, const int *lista, int tamanho, int sinal) {
+    for (int i = 0; i < tamanho; i++) {
+        int repetido = 0;
+        for (int j = 0; j < i && !repetido; j++) {
+            repetido = lista[j] == lista[i];
+        }
+        if (repetido) {
+            continue;
+        }
+        if (sinal < 0) {
+            subtrai_contagem(mapa, lista[i]);
+        } else if (soma_contagem(mapa, lista[i]) != 0) {
+            conta_lista(mapa, lista, i, -1);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * atualiza_contadores - Incorpora um registro aos contadores (`sinal` 1) ou o retira deles (-1).
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória; nesse caso nada é alterado.
+ */
+static int atualiza_contadores(BaseIncremental *base, const Processo *processo, int sinal) {
+    if (conta_lista(&base->contagem_classe, processo->classe, processo->classe_len, sinal) != 0) {
+        return -1;
+    }
+    if (conta_lista(&base->contagem_assunto, processo->assunto, processo->assunto_len, sinal) != 0) {
+        conta_lista(&base->contagem_classe, processo->classe, processo->classe_len, -1);
+        return -1;
+    }
+    if (processo->assunto_len > 1) {
+        base->mais_de_um_assunto += sinal > 0 ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * desfaz_carga - Retira da base os registros [n, tamanho) de uma carga interrompida por erro.
+ * 
+ * Os ids saem do índice primário e os contadores voltam aos valores anteriores à carga. Os campos
+ * desses registros continuam na arena até `base_incremental_libera`.
+ */
+static void desfaz_carga(BaseIncremental *base, long unsigned int n) {
+    for (long unsigned int r = n; r < base->tamanho; r++) {
+        mapa_remove(&base->ids.mapa, base->processos[r].id);
+        atualiza_contadores(base, &base->processos[r], -1);
+    }
+    base->tamanho = n;
+}
+
+static int antes_por_id(const Processo *processos, long unsigned int a, long unsigned int b) {
+    return processos[a].id < processos[b].id;
+}
+
+static int antes_por_data(const Processo *processos, long unsigned int a, long unsigned int b) {
+    return processos[a].timestamp > processos[b].timestamp ||
+           (processos[a].timestamp == processos[b].timestamp && processos[a].id < processos[b].id);
+}
+
+/**
+ * intercala_ordem - Intercala `novos` (já ordenados) no fim de `ordem`, de trás para frente.
+ * 
+ * @ordem: Array com `n` linhas ordenadas e espaço para mais `d`.
+ * 
+ * Só os elementos posteriores ao ponto de inserção do menor novo registro são deslocados: quando
+ * os registros novos vão para o fim da ordem (ids crescentes), o custo é O(d).
+ */
+static void intercala_ordem(const Processo *processos, long unsigned int *ordem, long unsigned int n,
+                            const long unsigned int *novos, long unsigned int d,
+                            int (*antes)(const Processo *, long unsigned int, long unsigned int)) {
+    long unsigned int i = n;
+    long unsigned int j = d;
+    long unsigned int k = n + d;
+
+    while (j > 0) {
+        if (i > 0 && antes(processos, novos[j - 1], ordem[i - 1])) {
+            ordem[--k] = ordem[--i];
+        } else {
+            ordem[--k] = novos[--j];
+        }
+    }
+}
+
+/**
+ * ordena_delta - Ordena as linhas [n, n + d) por id e por data e as intercala nas ordens da base.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+static int ordena_delta(BaseIncremental *base, long unsigned int n, long unsigned int d) {
+    long unsigned int *por_id = malloc(d * sizeof(long unsigned int));
+    long unsigned int *por_data = malloc(d * sizeof(long unsigned int));
+    unsigned long long *chaves = malloc(d * sizeof(unsigned long long));
+    long unsigned int *permutacao = malloc(d * sizeof(long unsigned int));
+    long unsigned int *ordem_id = realloc(base->ordem_id, (n + d) * sizeof(long unsigned int));
+    if (ordem_id != NULL) {
+        base->ordem_id = ordem_id;
+    }
+    long unsigned int *ordem_data = realloc(base->ordem_data, (n + d) * sizeof(long unsigned int));
+    if (ordem_data != NULL) {
+        base->ordem_data = ordem_data;
+    }
+
+    int erro = por_id == NULL || por_data == NULL || chaves == NULL || permutacao == NULL || ordem_id == NULL ||
+               ordem_data == NULL || ordena_indices_por_id(base->processos + n, d, por_id, ORDEM_CRESCENTE) != 0;
+    if (!erro) {
+        // Ordena por data a partir da ordem por id, para que os empates fiquem em ordem de id
+        for (long unsigned int i = 0; i < d; i++) {
+            por_id[i] += n;
+            chaves[i] = (unsigned long long)base->processos[por_id[i]].timestamp ^ (1ULL << 63);
+        }
+        erro = radix_sort_indices(chaves, d, permutacao, ORDEM_DECRESCENTE) != 0;
+    }
+    if (!erro) {
+        for (long unsigned int i = 0; i < d; i++) {
+            por_data[i] = por_id[permutacao[i]];
+        }
+        intercala_ordem(base->processos, base->ordem_id, n, por_id, d, antes_por_id);
+        intercala_ordem(base->processos, base->ordem_data, n, por_data, d, antes_por_data);
+    }
+
+    free(por_id);
+    free(por_data);
+    free(chaves);
+    free(permutacao);
+    return erro ? -1 : 0;
+}
+
+/**
+ * base_incremental_carrega - Incorpora à base os registros de um arquivo que ainda não foram vistos.
+ * 
+ * @base: Base inicializada com `base_incremental_inicializa` (vazia ou com cargas anteriores).
+ * @nome_arquivo: CSV diário, normalmente o arquivo anterior com linhas novas acrescentadas.
+ * @stats: Estrutura que receberá as estatísticas da carga (pode ser NULL).
+ * 
+ * Se o início do arquivo for idêntico ao trecho já processado do arquivo anterior (mesmo checksum),
+ * só o restante é percorrido, e o checksum guardado é estendido apenas sobre os bytes novos. Caso
+ * contrário, cada linha tem apenas o id lido e consultado no índice primário; só as linhas com id
+ * novo são analisadas por completo. Os registros novos são ordenados entre si e intercalados nas
+ * ordens por id e por data, e os contadores por classe, por assunto e de processos com mais de um
+ * assunto são atualizados. Exceto pela verificação do prefixo, o custo depende só do tamanho do delta.
+ * 
+ * Em caso de erro, a base volta ao estado anterior à carga (registros, índice, ordens, contadores e
+ * trecho processado), e a próxima carga relê as mesmas linhas.
+ * 
+ * Retorna o número de registros acrescentados ou -1 em caso de erro.
+ */
+long int base_incremental_carrega(BaseIncremental *base, const char *nome_arquivo, EstatisticasDelta *stats) {
+    double inicio = agora_segundos();
+    EstatisticasDelta local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(EstatisticasDelta));
+
+    int fd = open(nome_arquivo, O_RDONLY);
+    struct stat st;
+    if (fd == -1 || fstat(fd, &st) == -1) {
+        printf("Erro ao abrir o arquivo.\n");
+        if (fd != -1) {
+            close(fd);
+        }
+        return -1;
+    }
+    size_t tamanho = (size_t)st.st_size;
+    char *mapa = tamanho > 0 ? mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        printf("Erro ao mapear o arquivo.\n");
+        return -1;
+    }
+
+    const char *p = mapa;
+    const char *fim = mapa + tamanho;
+
+    // O checksum cobre só as palavras inteiras; os bytes restantes são comparados diretamente
+    size_t alinhado = base->bytes_processados & ~(size_t)7;
+    unsigned long long checksum = CHECKSUM_INICIAL;
+    if (base->bytes_processados > 0 && base->bytes_processados <= tamanho) {
+        checksum = acumula_checksum(CHECKSUM_INICIAL, mapa, alinhado);
+    }
+    if (base->bytes_processados > 0 && base->bytes_processados <= tamanho &&
+        checksum == base->checksum_processado &&
+        memcmp(mapa + alinhado, base->cauda_processada, base->bytes_processados - alinhado) == 0) {
+        p += base->bytes_processados;
+        stats->bytes_pulados = base->bytes_processados;
+    } else {
+        // Arquivo diferente: ignora o cabeçalho e confere todas as linhas pelo id
+        const char *nl = tamanho > 0 ? memchr(p, '\n', tamanho) : NULL;
+        p = nl != NULL ? nl + 1 : fim;
+        alinhado = 0;
+        checksum = CHECKSUM_INICIAL;
+    }
+
+    long unsigned int n = base->tamanho;
+    int erro = 0;
+    while (p < fim && !erro) {
+        const char *nl = memchr(p, '\n', (size_t)(fim - p));
+        const char *fim_linha = nl != NULL ? nl : fim;
+        int id;
+
+        stats->linhas++;
+        if (id_da_linha(p, fim_linha, &id) == 0 && mapa_busca(&base->ids.mapa, id, NULL)) {
+            stats->repetidos++;
+        } else {
+            if (base->tamanho == base->capacidade) {
+                long unsigned int capacidade = base->capacidade > 0 ? base->capacidade * 2 : 1024;
+                Processo *maior = realloc(base->processos, capacidade * sizeof(Processo));
+                if (maior == NULL) {
+                    erro = 1;
+                    break;
+                }
+                base->processos = maior;
+                base->capacidade = capacidade;
+            }
+            Processo *processo = &base->processos[base->tamanho];
+            if (parse_registro(p, fim_linha, processo, &base->arena) == 6) {
+                if (mapa_insere(&base->ids.mapa, processo->id, base->tamanho) < 0) {
+                    erro = 1;
+                } else if (atualiza_contadores(base, processo, 1) != 0) {
+                    mapa_remove(&base->ids.mapa, processo->id);
+                    erro = 1;
+                } else {
+                    base->tamanho++;
+                }
+            }
+        }
+        p = fim_linha + (nl != NULL);
+    }
+
+    long unsigned int d = base->tamanho - n;
+    if (!erro && d > 0) {
+        erro = ordena_delta(base, n, d) != 0;
+    }
+
+    if (erro) {
+        desfaz_carga(base, n);
+        d = 0;
+    } else {
+        // Guarda o trecho processado até o último '\n', para reconhecer o próximo arquivo.
+        // Com o prefixo reaproveitado, o checksum só avança sobre os bytes novos.
+        size_t processado = tamanho;
+        while (processado > 0 && mapa[processado - 1] != '\n') {
+            processado--;
+        }
+        size_t novo_alinhado = processado & ~(size_t)7;
+        base->checksum_processado = acumula_checksum(checksum, mapa + alinhado, novo_alinhado - alinhado);
+        memcpy(base->cauda_processada, mapa + novo_alinhado, processado - novo_alinhado);
+        base->bytes_processados = processado;
+    }
+    if (mapa != NULL) {
+        munmap(mapa, tamanho);
+    }
+    stats->novos = d;
+    stats->segundos = agora_segundos() - inicio;
+    return erro ? -1 : (long int)d;
+}
+
+/**
+ * base_incremental_count_id - Versão incremental de `count_id` (consulta ao contador mantido).
+ */
+long unsigned int base_incremental_count_id(const BaseIncremental *base, int id_classe) {
+    long unsigned int contagem = 0;
+    mapa_busca(&base->contagem_classe, id_classe, &contagem);
+    return contagem;
+}
+
+/**
+ * base_incremental_count_assuntos - Versão incremental de `count_assuntos`.
+ */
+long unsigned int base_incremental_count_assuntos(const BaseIncremental *base) {
+    return base->contagem_assunto.tamanho;
+}
+
+/**
+ * print_estatisticas_delta - Imprime o resultado de uma carga incremental.
+ */
+void print_estatisticas_delta(const EstatisticasDelta *stats) {
+    printf("Delta: %lu linhas examinadas, %lu novos, %lu repetidos, %lu bytes reaproveitados em %.3f s\n",
+        stats->linhas, stats->novos, stats->repetidos, stats->bytes_pulados, stats->segundos);
+}
@@ -0,0 +1,41 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "processo.h"
+#include "conjunto.h"
+#include "indice.h"
+
+// Base mantida entre cargas sucessivas de arquivos diários.
+// Os registros só são acrescentados; as ordens e os contadores são atualizados a cada carga.
+typedef struct {
+    Processo *processos;                // Registros, na ordem em que foram carregados
+    long unsigned int tamanho;
+    long unsigned int capacidade;
+    Arena arena;                        // Campos alocados dos registros
+    IndicePrimario ids;                 // id → linha (a primeira ocorrência vence)
+    long unsigned int *ordem_id;        // Linhas em ordem crescente de id
+    long unsigned int *ordem_data;      // Linhas da mais recente para a mais antiga (empates por id)
+    MapaInteiros contagem_classe;       // id_classe → número de processos
+    MapaInteiros contagem_assunto;      // id_assunto → número de processos
+    long unsigned int mais_de_um_assunto;
+    long unsigned int bytes_processados;        // Bytes do último arquivo já incorporados (até o último '\n')
+    unsigned long long checksum_processado;     // Checksum das palavras inteiras desses bytes (estado do FNV-1a)
+    char cauda_processada[8];                   // Bytes finais que não completam uma palavra
+} BaseIncremental;
+
+// Estatísticas de uma carga incremental
+typedef struct {
+    long unsigned int linhas;           // Linhas examinadas
+    long unsigned int novos;            // Registros acrescentados
+    long unsigned int repetidos;        // Linhas com id já presente na base
+    long unsigned int bytes_pulados;    // Prefixo idêntico ao arquivo anterior, não relido
+    double segundos;
+} EstatisticasDelta;
+
+int base_incremental_inicializa(BaseIncremental *base);
+void base_incremental_libera(BaseIncremental *base);
+long int base_incremental_carrega(BaseIncremental *base, const char *nome_arquivo, EstatisticasDelta *stats);
+long unsigned int base_incremental_count_id(const BaseIncremental *base, int id_classe);
+long unsigned int base_incremental_count_assuntos(const BaseIncremental *base);
+void print_estatisticas_delta(const EstatisticasDelta *stats);
+#endif
@@ -0,0 +1,519 @@
+#include "indice.h"
+
+/**
+ * lista_do_campo - Retorna a lista (classe ou assunto) de um processo e seu tamanho.
+ */
+static const int *lista_do_campo(const Processo *processo, CampoIndice campo, int *tamanho) {
+    if (campo == CAMPO_CLASSE) {
+        *tamanho = processo->classe_len;
+        return processo->classe;
+    }
+    *tamanho = processo->assunto_len;
+    return processo->assunto;
+}
+
+/**
+ * repetido - Verifica se `lista[j]` já apareceu antes na mesma lista.
+ * 
+ * Um processo entra apenas uma vez na lista de cada id, mesmo que o id se repita no registro.
+ */
+static int repetido(const int *lista, int j) {
+    for (int k = 0; k < j; k++) {
+        if (lista[k] == lista[j]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * indice_invertido_constroi - Constrói o índice invertido de classes ou assuntos.
+ * 
+ * @indice: Índice a ser construído.
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @processos_size: Tamanho do array de estruturas `Processo`.
+ * @campo: `CAMPO_CLASSE` ou `CAMPO_ASSUNTO`.
+ * 
+ * São feitas duas passagens sobre os registros: a primeira conta quantas linhas cada id possui
+ * e a segunda preenche as listas. Como as linhas são visitadas em ordem, cada lista já sai ordenada.
+ * Os índices de linha referem-se à ordem atual de `processos`; o índice precisa ser reconstruído
+ * se o array for reordenado.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int indice_invertido_constroi(IndiceInvertido *indice, const Processo *processos, long unsigned int processos_size,
+                              CampoIndice campo) {
+    double inicio = agora_segundos();
+    long unsigned int *contagem = NULL;
+    long unsigned int capacidade = 0;
+    long unsigned int total = 0;
+
+    memset(indice, 0, sizeof(IndiceInvertido));
+    if (mapa_inicializa(&indice->mapa, 256) != 0) {
+        return -1;
+    }
+
+    // 1. Atribui uma posição a cada id e conta suas linhas
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        int tamanho;
+        const int *lista = lista_do_campo(&processos[i], campo, &tamanho);
+
+        for (int j = 0; j < tamanho; j++) {
+            long unsigned int k;
+            if (repetido(lista, j)) {
+                continue;
+            }
+            if (!mapa_busca(&indice->mapa, lista[j], &k)) {
+                k = indice->num_chaves++;
+                if (k == capacidade) {
+                    capacidade = capacidade > 0 ? capacidade * 2 : 256;
+                    long unsigned int *nova = realloc(contagem, capacidade * sizeof(long unsigned int));
+                    int *chaves = realloc(indice->chaves, capacidade * sizeof(int));
+                    if (nova != NULL) {
+                        contagem = nova;
+                    }
+                    if (chaves != NULL) {
+                        indice->chaves = chaves;
+                    }
+                    if (nova == NULL || chaves == NULL) {
+                        free(contagem);
+                        indice_invertido_libera(indice);
+                        return -1;
+                    }
+                }
+                contagem[k] = 0;
+                indice->chaves[k] = lista[j];
+                if (mapa_insere(&indice->mapa, lista[j], k) < 0) {
+                    free(contagem);
+                    indice_invertido_libera(indice);
+                    return -1;
+                }
+            }
+            contagem[k]++;
+            total++;
+        }
+    }
+
+    // 2. Converte as contagens em deslocamentos
+    indice->offset = malloc((indice->num_chaves + 1) * sizeof(long unsigned int));
+    indice->linhas = malloc((total > 0 ? total : 1) * sizeof(long unsigned int));
+    if (indice->offset == NULL || indice->linhas == NULL) {
+        free(contagem);
+        indice_invertido_libera(indice);
+        return -1;
+    }
+    long unsigned int soma = 0;
+    for (long unsigned int k = 0; k < indice->num_chaves; k++) {
+        indice->offset[k] = soma;
+        soma += contagem[k];
+        contagem[k] = indice->offset[k]; // Próxima posição livre da lista k
+    }
+    indice->offset[indice->num_chaves] = soma;
+
+    // 3. Preenche as listas na ordem das linhas
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        int tamanho;
+        const int *lista = lista_do_campo(&processos[i], campo, &tamanho);
+
+        for (int j = 0; j < tamanho; j++) {
+            long unsigned int k;
+            if (!repetido(lista, j) && mapa_busca(&indice->mapa, lista[j], &k)) {
+                indice->linhas[contagem[k]++] = i;
+            }
+        }
+    }
+
+    free(contagem);
+    indice->segundos_construcao = agora_segundos() - inicio;
+    return 0;
+}
+
+/**
+ * indice_invertido_libera - Libera a memória do índice invertido.
+ */
+void indice_invertido_libera(IndiceInvertido *indice) {
+    mapa_libera(&indice->mapa);
+    free(indice->chaves);
+    free(indice->offset);
+    free(indice->linhas);
+    memset(indice, 0, sizeof(IndiceInvertido));
+}
+
+/**
+ * indice_invertido_bytes - Calcula a memória ocupada pelo índice, em bytes.
+ */
+long unsigned int indice_invertido_bytes(const IndiceInvertido *indice) {
+    return mapa_bytes(&indice->mapa)
+        + indice->num_chaves * sizeof(int)
+        + (indice->num_chaves + 1) * sizeof(long unsigned int)
+        + indice->offset[indice->num_chaves] * sizeof(long unsigned int);
+}
+
+/**
+ * indice_lista - Retorna as linhas dos processos que contêm o id, em ordem crescente.
+ * 
+ * @indice: Índice invertido.
+ * @id: ID de classe ou assunto.
+ * @tamanho: Ponteiro que receberá o número de linhas.
+ * 
+ * A busca é O(1) esperado; a lista retornada pertence ao índice e não deve ser liberada.
+ * 
+ * Retorna o ponteiro para a lista ou NULL se o id não ocorrer na base.
+ */
+const long unsigned int *indice_lista(const IndiceInvertido *indice, int id, long unsigned int *tamanho) {
+    long unsigned int k;
+
+    if (!mapa_busca(&indice->mapa, id, &k)) {
+        *tamanho = 0;
+        return NULL;
+    }
+    *tamanho = indice->offset[k + 1] - indice->offset[k];
+    return &indice->linhas[indice->offset[k]];
+}
+
+/**
+ * count_id_indice - Versão de `count_id` que consulta um índice invertido de classes.
+ * 
+ * @indice: Índice construído com `CAMPO_CLASSE`.
+ * @id_classe: ID da classe a ser buscada.
+ * 
+ * Retorna o número de processos que possuem a classe especificada, em tempo O(1).
+ */
+int count_id_indice(const IndiceInvertido *indice, int id_classe) {
+    long unsigned int tamanho;
+
+    indice_lista(indice, id_classe, &tamanho);
+    return (int)tamanho;
+}
+
+/**
+ * indice_primario_constroi - Constrói o índice id → linha, uma única vez após a leitura.
+ * 
+ * @indice: Índice a ser construído.
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @processos_size: Tamanho do array de estruturas `Processo`.
+ * 
+ * Se um id se repetir, vale a primeira ocorrência (a mesma encontrada pela busca linear de
+ * `count_dias`). As linhas referem-se à ordem atual de `processos`; o índice precisa ser
+ * reconstruído se o array for reordenado.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int indice_primario_constroi(IndicePrimario *indice, const Processo *processos, long unsigned int processos_size) {
+    double inicio = agora_segundos();
+
+    if (mapa_inicializa(&indice->mapa, processos_size) != 0) {
+        return -1;
+    }
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        if (!mapa_busca(&indice->mapa, processos[i].id, NULL) &&
+            mapa_insere(&indice->mapa, processos[i].id, i) < 0) {
+            indice_primario_libera(indice);
+            return -1;
+        }
+    }
+
+    indice->segundos_construcao = agora_segundos() - inicio;
+    return 0;
+}
+
+/**
+ * indice_primario_libera - Libera a memória do índice de chave primária.
+ */
+void indice_primario_libera(IndicePrimario *indice) {
+    mapa_libera(&indice->mapa);
+}
+
+/**
+ * indice_primario_busca - Procura a linha de um processo pelo id, em tempo O(1) esperado.
+ * 
+ * Retorna a linha do processo ou -1 se o id não existir.
+ */
+long int indice_primario_busca(const IndicePrimario *indice, int id) {
+    long unsigned int linha;
+
+    if (!mapa_busca(&indice->mapa, id, &linha)) {
+        return -1;
+    }
+    return (long int)linha;
+}
+
+/**
+ * count_dias_indice - Versão de `count_dias` que localiza o processo pelo índice de chave primária.
+ * 
+ * @processos: Array indexado por `indice`; não é modificado.
+ * @indice: Índice de chave primária.
+ * @id: ID do registro cuja diferença de dias será calculada.
+ * 
+ * Retorna:
+ * - A diferença em dias entre a data atual e a data do registro.
+ * - -1 se o ID não for encontrado.
+ * - -2 se a data do registro for inválida.
+ */
+int count_dias_indice(const Processo *processos, const IndicePrimario *indice, int id) {
+    long int linha = indice_primario_busca(indice, id);
+
+    if (linha == -1) {
+        return -1;
+    }
+    return dias_em_tramitacao(&processos[linha], (long long)time(NULL) * 1000);
+}
+
+/**
+ * count_dias_lote - Calcula os dias em tramitação de vários processos de uma vez.
+ * 
+ * @processos: Array indexado por `indice`; não é modificado.
+ * @indice: Índice de chave primária.
+ * @ids: IDs consultados.
+ * @n: Número de IDs.
+ * @dias: Array de `n` posições que receberá os resultados, com os mesmos códigos de `count_dias_indice`.
+ * 
+ * A data atual é obtida uma única vez, de modo que todos os resultados usam a mesma referência.
+ */
+void count_dias_lote(const Processo *processos, const IndicePrimario *indice, const int *ids, long unsigned int n,
+                     int *dias) {
+    long long agora = (long long)time(NULL) * 1000;
+
+    for (long unsigned int i = 0; i < n; i++) {
+        long int linha = indice_primario_busca(indice, ids[i]);
+        dias[i] = linha == -1 ? -1 : dias_em_tramitacao(&processos[linha], agora);
+    }
+}
+
+/**
+ * hash_numero - Hash de um número de processo, compactado ou em texto.
+ * 
+ * Números compactados misturam dígitos e prefixo; os guardados como texto usam FNV-1a.
+ * O resultado passa pelo finalizador do MurmurHash3 para espalhar os bits baixos.
+ */
+static unsigned long long hash_numero(const NumeroProcesso *numero) {
+    unsigned long long h;
+
+    if (numero->prefixo == NUMERO_TEXTO) {
+        h = 0xcbf29ce484222325ULL;
+        for (const unsigned char *c = (const unsigned char *)numero->texto; *c; c++) {
+            h = (h ^ *c) * 0x100000001b3ULL;
+        }
+    } else {
+        h = numero->digitos * 0x9E3779B97F4A7C15ULL ^ numero->prefixo;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * indice_numero_constroi - Constrói o índice de numeração (número CNJ → linha).
+ * 
+ * @indice: Estrutura que receberá o índice.
+ * @processos: Array de estruturas `Processo`; não é modificado.
+ * @processos_size: Tamanho do array de estruturas `Processo`.
+ * 
+ * A tabela tem capacidade fixa (potência de 2 com ocupação de no máximo 50%), de modo que a
+ * sondagem linear percorre poucas posições. Se um número se repetir, vale a primeira ocorrência,
+ * como na busca linear. Números guardados como texto apontam para a arena dos processos.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int indice_numero_constroi(IndiceNumero *indice, const Processo *processos, long unsigned int processos_size) {
+    double inicio = agora_segundos();
+
+    long unsigned int capacidade = 16;
+    while (capacidade < 2 * processos_size) {
+        capacidade <<= 1;
+    }
+
+    indice->capacidade = capacidade;
+    indice->tamanho = 0;
+    indice->chaves = malloc(capacidade * sizeof(NumeroProcesso));
+    indice->linhas = malloc(capacidade * sizeof(long unsigned int));
+    if (indice->chaves == NULL || indice->linhas == NULL) {
+        indice_numero_libera(indice);
+        return -1;
+    }
+    memset(indice->linhas, 0xFF, capacidade * sizeof(long unsigned int));
+
+    long unsigned int mascara = capacidade - 1;
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        const NumeroProcesso *numero = &processos[i].numero;
+        long unsigned int pos = (long unsigned int)hash_numero(numero) & mascara;
+
+        while (indice->linhas[pos] != INDICE_NUMERO_VAZIO && !numero_iguais(&indice->chaves[pos], numero)) {
+            pos = (pos + 1) & mascara;
+        }
+        if (indice->linhas[pos] == INDICE_NUMERO_VAZIO) {
+            indice->chaves[pos] = *numero;
+            indice->linhas[pos] = i;
+            indice->tamanho++;
+        }
+    }
+
+    indice->segundos_construcao = agora_segundos() - inicio;
+    return 0;
+}
+
+/**
+ * indice_numero_libera - Libera a memória do índice de numeração.
+ */
+void indice_numero_libera(IndiceNumero *indice) {
+    free(indice->chaves);
+    free(indice->linhas);
+    indice->chaves = NULL;
+    indice->linhas = NULL;
+    indice->capacidade = 0;
+    indice->tamanho = 0;
+}
+
+/**
+ * indice_numero_bytes - Memória ocupada pela tabela do índice de numeração.
+ * 
+ * Os textos dos números não canônicos ficam na arena dos processos e não são contados.
+ */
+long unsigned int indice_numero_bytes(const IndiceNumero *indice) {
+    return indice->capacidade * (sizeof(NumeroProcesso) + sizeof(long unsigned int));
+}
+
+/**
+ * indice_numero_busca - Procura a linha de um processo pelo número, em tempo O(1) esperado.
+ * 
+ * Retorna a linha do processo ou -1 se o número não existir.
+ */
+long int indice_numero_busca(const IndiceNumero *indice, const NumeroProcesso *numero) {
+    if (indice->capacidade == 0) {
+        return -1;
+    }
+
+    long unsigned int mascara = indice->capacidade - 1;
+    long unsigned int pos = (long unsigned int)hash_numero(numero) & mascara;
+
+    while (indice->linhas[pos] != INDICE_NUMERO_VAZIO) {
+        if (numero_iguais(&indice->chaves[pos], numero)) {
+            return (long int)indice->linhas[pos];
+        }
+        pos = (pos + 1) & mascara;
+    }
+    return -1;
+}
+
+/**
+ * indice_numero_busca_texto - Procura um processo pelo número escrito como texto.
+ * 
+ * @texto: Número com ou sem a pontuação do padrão CNJ (NNNNNNN-DD.AAAA.J.TR.OOOO).
+ * 
+ * Números com 20 dígitos são compactados antes da busca; os demais são comparados como
+ * texto, exatamente como foram lidos do arquivo.
+ * 
+ * Retorna a linha do processo ou -1 se o número não existir.
+ */
+long int indice_numero_busca_texto(const IndiceNumero *indice, const char *texto) {
+    NumeroProcesso numero;
+
+    if (numero_de_texto(texto, &numero) != 0) {
+        numero.texto = texto;
+        numero.prefixo = NUMERO_TEXTO;
+    }
+    return indice_numero_busca(indice, &numero);
+}
+
+/**
+ * intersecao_linhas - Intersecção de duas listas ordenadas de linhas (consulta "E").
+ * 
+ * @a, @na: Primeira lista e seu tamanho.
+ * @b, @nb: Segunda lista e seu tamanho.
+ * @saida: Buffer com pelo menos min(na, nb) posições.
+ * 
+ * Quando uma lista é muito menor que a outra, cada elemento da menor é procurado na maior por
+ * busca exponencial; caso contrário, as listas são percorridas em paralelo.
+ * 
+ * Retorna o número de linhas escritas em `saida`.
+ */
+long unsigned int intersecao_linhas(const long unsigned int *a, long unsigned int na,
+                                    const long unsigned int *b, long unsigned int nb, long unsigned int *saida) {
+    long unsigned int count = 0;
+
+    // Garante que `a` seja a menor lista
+    if (na > nb) {
+        const long unsigned int *t = a;
+        a = b;
+        b = t;
+        long unsigned int tn = na;
+        na = nb;
+        nb = tn;
+    }
+
+    if (na * 16 < nb) {
+        long unsigned int base = 0;
+        for (long unsigned int i = 0; i < na && base < nb; i++) {
+            // Busca exponencial seguida de busca binária a partir da última posição
+            long unsigned int passo = 1;
+            while (base + passo < nb && b[base + passo] < a[i]) {
+                passo *= 2;
+            }
+            long unsigned int inf = base + passo / 2;
+            long unsigned int sup = base + passo < nb ? base + passo + 1 : nb;
+            while (inf < sup) {
+                long unsigned int meio = inf + (sup - inf) / 2;
+                if (b[meio] < a[i]) {
+                    inf = meio + 1;
+                } else {
+                    sup = meio;
+                }
+            }
+            base = inf;
+            if (base < nb && b[base] == a[i]) {
+                saida[count++] = a[i];
+            }
+        }
+        return count;
+    }
+
+    long unsigned int i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (a[i] > b[j]) {
+            j++;
+        } else {
+            saida[count++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+/**
+ * uniao_linhas - União de duas listas ordenadas de linhas (consulta "OU"), sem repetições.
+ * 
+ * @a, @na: Primeira lista e seu tamanho.
+ * @b, @nb: Segunda lista e seu tamanho.
+ * @saida: Buffer com pelo menos na + nb posições.
+ * 
+ * Retorna o número de linhas escritas em `saida`.
+ */
+long unsigned int uniao_linhas(const long unsigned int *a, long unsigned int na,
+                               const long unsigned int *b, long unsigned int nb, long unsigned int *saida) {
+    long unsigned int i = 0, j = 0, count = 0;
+
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            saida[count++] = a[i++];
+        } else if (a[i] > b[j]) {
+            saida[count++] = b[j++];
+        } else {
+            saida[count++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    while (i < na) {
+        saida[count++] = a[i++];
+    }
+    while (j < nb) {
+        saida[count++] = b[j++];
+    }
+    return count;
+}
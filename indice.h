@@ -0,0 +1,67 @@
+#ifndef INDICE_H
+#define INDICE_H
+
+#include "processo.h"
+#include "conjunto.h"
+
+// Campo de lista indexado por um índice invertido
+typedef enum {
+    CAMPO_CLASSE = 0,
+    CAMPO_ASSUNTO = 1
+} CampoIndice;
+
+// Índice invertido: id de classe/assunto → lista ordenada das linhas que o contêm.
+// A lista da chave armazenada na posição k ocupa linhas[offset[k] .. offset[k+1]).
+typedef struct {
+    MapaInteiros mapa;              // id → posição k
+    int *chaves;                    // id de cada posição k
+    long unsigned int num_chaves;   // Número de ids distintos
+    long unsigned int *offset;      // num_chaves + 1 posições
+    long unsigned int *linhas;      // Listas de linhas concatenadas
+    double segundos_construcao;     // Tempo gasto em `indice_invertido_constroi`
+} IndiceInvertido;
+
+// Índice de chave primária: id do processo → linha no array
+typedef struct {
+    MapaInteiros mapa;              // id → linha
+    double segundos_construcao;     // Tempo gasto em `indice_primario_constroi`
+} IndicePrimario;
+
+// Índice de numeração: número CNJ compactado → linha no array (endereçamento aberto, sondagem linear).
+// Os números guardados como texto apontam para a arena dos processos, que deve continuar viva.
+typedef struct {
+    NumeroProcesso *chaves;         // Número de cada posição ocupada
+    long unsigned int *linhas;      // Linha de cada posição (INDICE_NUMERO_VAZIO marca posição livre)
+    long unsigned int capacidade;   // Número de posições da tabela (potência de 2)
+    long unsigned int tamanho;      // Números distintos armazenados
+    double segundos_construcao;     // Tempo gasto em `indice_numero_constroi`
+} IndiceNumero;
+
+// Valor de `IndiceNumero.linhas` nas posições livres
+#define INDICE_NUMERO_VAZIO ((long unsigned int)-1)
+
+int indice_invertido_constroi(IndiceInvertido *indice, const Processo *processos, long unsigned int processos_size,
+                              CampoIndice campo);
+void indice_invertido_libera(IndiceInvertido *indice);
+long unsigned int indice_invertido_bytes(const IndiceInvertido *indice);
+const long unsigned int *indice_lista(const IndiceInvertido *indice, int id, long unsigned int *tamanho);
+int count_id_indice(const IndiceInvertido *indice, int id_classe);
+
+int indice_primario_constroi(IndicePrimario *indice, const Processo *processos, long unsigned int processos_size);
+void indice_primario_libera(IndicePrimario *indice);
+long int indice_primario_busca(const IndicePrimario *indice, int id);
+int count_dias_indice(const Processo *processos, const IndicePrimario *indice, int id);
+void count_dias_lote(const Processo *processos, const IndicePrimario *indice, const int *ids, long unsigned int n,
+                     int *dias);
+
+int indice_numero_constroi(IndiceNumero *indice, const Processo *processos, long unsigned int processos_size);
+void indice_numero_libera(IndiceNumero *indice);
+long unsigned int indice_numero_bytes(const IndiceNumero *indice);
+long int indice_numero_busca(const IndiceNumero *indice, const NumeroProcesso *numero);
+long int indice_numero_busca_texto(const IndiceNumero *indice, const char *texto);
+
+long unsigned int intersecao_linhas(const long unsigned int *a, long unsigned int na,
+                                    const long unsigned int *b, long unsigned int nb, long unsigned int *saida);
+long unsigned int uniao_linhas(const long unsigned int *a, long unsigned int na,
+                               const long unsigned int *b, long unsigned int nb, long unsigned int *saida);
+#endif
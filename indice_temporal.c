@@ -0,0 +1,346 @@
+#include "indice_temporal.h"
+#include "ordenacao.h"
+
+// Milissegundos em um dia
+#define MS_POR_DIA 86400000LL
+
+// Timestamps com sinal viram chaves sem sinal invertendo o bit de sinal
+#define BIT_SINAL (1ULL << 63)
+
+/**
+ * dia_de_timestamp - Retorna o dia (desde 1970-01-01) de um timestamp em milissegundos, arredondando para baixo.
+ */
+static long long dia_de_timestamp(long long timestamp) {
+    long long dia = timestamp / MS_POR_DIA;
+    return timestamp % MS_POR_DIA < 0 ? dia - 1 : dia;
+}
+
+/**
+ * chaves_do_dia - Calcula as chaves de balde (AAAAMMDD, AAAAMM e AAAA) de um dia.
+ */
+static void chaves_do_dia(long long dia, int chaves[NUM_GRANULARIDADES]) {
+    int ano, mes, dia_mes;
+
+    dias_para_data(dia, &ano, &mes, &dia_mes);
+    chaves[GRANULARIDADE_DIA] = ano * 10000 + mes * 100 + dia_mes;
+    chaves[GRANULARIDADE_MES] = ano * 100 + mes;
+    chaves[GRANULARIDADE_ANO] = ano;
+}
+
+/**
+ * constroi_histogramas - Calcula os histogramas por dia, mês e ano sobre os timestamps já ordenados.
+ *
+ * Como os timestamps estão ordenados, cada balde é um trecho contíguo do índice: basta uma
+ * passagem para contar os baldes e outra para preenchê-los. A conversão para o calendário é
+ * feita apenas quando o dia muda.
+ *
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+static int constroi_histogramas(IndiceTemporal *indice) {
+    long unsigned int num_baldes[NUM_GRANULARIDADES] = {0};
+    int atuais[NUM_GRANULARIDADES] = {0};
+    int chaves[NUM_GRANULARIDADES];
+    long long dia_anterior = 0;
+
+    // 1. Conta os baldes de cada granularidade
+    for (long unsigned int i = 0; i < indice->tamanho; i++) {
+        long long dia = dia_de_timestamp(indice->timestamps[i]);
+        if (i > 0 && dia == dia_anterior) {
+            continue;
+        }
+        chaves_do_dia(dia, chaves);
+        for (int g = 0; g < NUM_GRANULARIDADES; g++) {
+            if (i == 0 || chaves[g] != atuais[g]) {
+                num_baldes[g]++;
+                atuais[g] = chaves[g];
+            }
+        }
+        dia_anterior = dia;
+    }
+
+    for (int g = 0; g < NUM_GRANULARIDADES; g++) {
+        HistogramaTemporal *histograma = &indice->histogramas[g];
+        histograma->num_baldes = 0;
+        histograma->chaves = malloc((num_baldes[g] > 0 ? num_baldes[g] : 1) * sizeof(int));
+        histograma->offset = malloc((num_baldes[g] + 1) * sizeof(long unsigned int));
+        if (histograma->chaves == NULL || histograma->offset == NULL) {
+            return -1;
+        }
+    }
+
+    // 2. Registra a chave e a posição inicial de cada balde
+    for (long unsigned int i = 0; i < indice->tamanho; i++) {
+        long long dia = dia_de_timestamp(indice->timestamps[i]);
+        if (i > 0 && dia == dia_anterior) {
+            continue;
+        }
+        chaves_do_dia(dia, chaves);
+        for (int g = 0; g < NUM_GRANULARIDADES; g++) {
+            HistogramaTemporal *histograma = &indice->histogramas[g];
+            if (histograma->num_baldes == 0 || chaves[g] != histograma->chaves[histograma->num_baldes - 1]) {
+                histograma->chaves[histograma->num_baldes] = chaves[g];
+                histograma->offset[histograma->num_baldes] = i;
+                histograma->num_baldes++;
+            }
+        }
+        dia_anterior = dia;
+    }
+    for (int g = 0; g < NUM_GRANULARIDADES; g++) {
+        indice->histogramas[g].offset[indice->histogramas[g].num_baldes] = indice->tamanho;
+    }
+    return 0;
+}
+
+/**
+ * constroi_de_chaves - Ordena as chaves de data e monta o índice e os histogramas.
+ *
+ * @indice: Índice a ser construído.
+ * @chaves: Timestamp de cada linha com o bit de sinal invertido; liberado por esta função.
+ * @n: Número de linhas.
+ * @inicio: Instante do início da construção, para `segundos_construcao`.
+ *
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+static int constroi_de_chaves(IndiceTemporal *indice, unsigned long long *chaves, long unsigned int n,
+                              double inicio) {
+    memset(indice, 0, sizeof(*indice));
+    indice->tamanho = n;
+    indice->timestamps = malloc((n > 0 ? n : 1) * sizeof(long long));
+    indice->linhas = malloc((n > 0 ? n : 1) * sizeof(long unsigned int));
+
+    // O radix sort é estável: datas iguais ficam na ordem das linhas
+    if (chaves == NULL || indice->timestamps == NULL || indice->linhas == NULL ||
+        (n > 0 && radix_sort_indices(chaves, n, indice->linhas, ORDEM_CRESCENTE) != 0)) {
+        free(chaves);
+        indice_temporal_libera(indice);
+        return -1;
+    }
+    for (long unsigned int i = 0; i < n; i++) {
+        indice->timestamps[i] = (long long)(chaves[indice->linhas[i]] ^ BIT_SINAL);
+    }
+    free(chaves);
+
+    if (constroi_histogramas(indice) != 0) {
+        indice_temporal_libera(indice);
+        return -1;
+    }
+
+    indice->segundos_construcao = agora_segundos() - inicio;
+    return 0;
+}
+
+/**
+ * indice_temporal_constroi - Constrói o índice de datas de ajuizamento, uma única vez após a leitura.
+ *
+ * @indice: Índice a ser construído.
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @processos_size: Tamanho do array de estruturas `Processo`.
+ *
+ * As datas são ordenadas por radix sort de índices e os histogramas por dia, mês e ano são
+ * calculados em seguida. As linhas referem-se à ordem atual de `processos`; o índice precisa
+ * ser reconstruído se o array for reordenado.
+ *
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int indice_temporal_constroi(IndiceTemporal *indice, const Processo *processos, long unsigned int processos_size) {
+    double inicio = agora_segundos();
+    unsigned long long *chaves = malloc((processos_size > 0 ? processos_size : 1) * sizeof(unsigned long long));
+
+    if (chaves != NULL) {
+        for (long unsigned int i = 0; i < processos_size; i++) {
+            chaves[i] = (unsigned long long)processos[i].timestamp ^ BIT_SINAL;
+        }
+    }
+    return constroi_de_chaves(indice, chaves, processos_size, inicio);
+}
+
+/**
+ * indice_temporal_constroi_colunar - Versão de `indice_temporal_constroi` para a base colunar.
+ *
+ * @indice: Índice a ser construído.
+ * @colunar: Base colunar (inclusive a de um snapshot aberto, que não é modificada).
+ *
+ * Lê apenas a coluna `timestamp`. Como a base colunar preserva a ordem das linhas, o índice é
+ * idêntico ao construído sobre o array de processos de origem.
+ *
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int indice_temporal_constroi_colunar(IndiceTemporal *indice, const ProcessosColunar *colunar) {
+    double inicio = agora_segundos();
+    long unsigned int n = colunar->tamanho;
+    unsigned long long *chaves = malloc((n > 0 ? n : 1) * sizeof(unsigned long long));
+
+    if (chaves != NULL) {
+        for (long unsigned int i = 0; i < n; i++) {
+            chaves[i] = (unsigned long long)colunar->timestamp[i] ^ BIT_SINAL;
+        }
+    }
+    return constroi_de_chaves(indice, chaves, n, inicio);
+}
+
+/**
+ * indice_temporal_libera - Libera a memória do índice temporal.
+ */
+void indice_temporal_libera(IndiceTemporal *indice) {
+    free(indice->timestamps);
+    free(indice->linhas);
+    for (int g = 0; g < NUM_GRANULARIDADES; g++) {
+        free(indice->histogramas[g].chaves);
+        free(indice->histogramas[g].offset);
+        indice->histogramas[g].chaves = NULL;
+        indice->histogramas[g].offset = NULL;
+        indice->histogramas[g].num_baldes = 0;
+    }
+    indice->timestamps = NULL;
+    indice->linhas = NULL;
+    indice->tamanho = 0;
+}
+
+/**
+ * indice_temporal_bytes - Retorna a memória ocupada pelo índice temporal, em bytes.
+ */
+long unsigned int indice_temporal_bytes(const IndiceTemporal *indice) {
+    long unsigned int bytes = indice->tamanho * (sizeof(long long) + sizeof(long unsigned int));
+
+    for (int g = 0; g < NUM_GRANULARIDADES; g++) {
+        bytes += indice->histogramas[g].num_baldes * (sizeof(int) + sizeof(long unsigned int)) +
+                 sizeof(long unsigned int);
+    }
+    return bytes;
+}
+
+/**
+ * primeira_posicao - Retorna a primeira posição do índice com data maior ou igual a `instante`.
+ */
+static long unsigned int primeira_posicao(const IndiceTemporal *indice, long long instante) {
+    long unsigned int inf = 0, sup = indice->tamanho;
+
+    while (inf < sup) {
+        long unsigned int meio = inf + (sup - inf) / 2;
+        if (indice->timestamps[meio] < instante) {
+            inf = meio + 1;
+        } else {
+            sup = meio;
+        }
+    }
+    return inf;
+}
+
+/**
+ * indice_temporal_conta - Conta os processos ajuizados no intervalo [inicio, fim).
+ *
+ * @indice: Índice temporal.
+ * @inicio: Início do intervalo, em milissegundos desde 1970-01-01 (inclusive).
+ * @fim: Fim do intervalo, em milissegundos desde 1970-01-01 (exclusive).
+ *
+ * Duas buscas binárias, em tempo O(log n). Para datas do calendário, use
+ * `data_para_epoch(...) * 1000`.
+ *
+ * Retorna o número de processos no intervalo.
+ */
+long unsigned int indice_temporal_conta(const IndiceTemporal *indice, long long inicio, long long fim) {
+    if (fim <= inicio) {
+        return 0;
+    }
+    return primeira_posicao(indice, fim) - primeira_posicao(indice, inicio);
+}
+
+/**
+ * indice_temporal_lista - Retorna as linhas dos processos ajuizados no intervalo [inicio, fim).
+ *
+ * @indice: Índice temporal.
+ * @inicio: Início do intervalo (inclusive), em milissegundos.
+ * @fim: Fim do intervalo (exclusive), em milissegundos.
+ * @tamanho: Recebe o número de linhas.
+ *
+ * As linhas vêm em ordem crescente de data e não são copiadas: o ponteiro aponta para o
+ * próprio índice e vale enquanto ele não for liberado. Custa O(log n) para localizar o trecho,
+ * mais O(k) para percorrê-lo.
+ *
+ * Retorna o ponteiro para a primeira linha do intervalo (NULL se o intervalo estiver vazio).
+ */
+const long unsigned int *indice_temporal_lista(const IndiceTemporal *indice, long long inicio, long long fim,
+                                               long unsigned int *tamanho) {
+    *tamanho = 0;
+    if (fim <= inicio) {
+        return NULL;
+    }
+
+    long unsigned int primeira = primeira_posicao(indice, inicio);
+    long unsigned int ultima = primeira_posicao(indice, fim);
+    if (primeira == ultima) {
+        return NULL;
+    }
+    *tamanho = ultima - primeira;
+    return indice->linhas + primeira;
+}
+
+/**
+ * indice_temporal_histograma - Retorna o histograma completo de uma granularidade.
+ *
+ * O histograma é calculado na construção do índice; esta chamada não faz nenhum cálculo.
+ * A contagem do balde k é `offset[k + 1] - offset[k]`.
+ *
+ * Retorna o histograma ou NULL se a granularidade for inválida.
+ */
+const HistogramaTemporal *indice_temporal_histograma(const IndiceTemporal *indice, Granularidade granularidade) {
+    if ((int)granularidade < 0 || (int)granularidade >= NUM_GRANULARIDADES) {
+        return NULL;
+    }
+    return &indice->histogramas[granularidade];
+}
+
+/**
+ * indice_temporal_histograma_intervalo - Conta os processos por dia, mês ou ano dentro de [inicio, fim).
+ *
+ * @indice: Índice temporal.
+ * @granularidade: Tamanho dos baldes.
+ * @inicio: Início do intervalo (inclusive), em milissegundos.
+ * @fim: Fim do intervalo (exclusive), em milissegundos.
+ * @saida: Array que receberá as contagens, em ordem crescente de chave (pode ser NULL).
+ * @max_saida: Capacidade de `saida`.
+ *
+ * O trecho do intervalo é localizado por busca binária e cruzado com os deslocamentos do
+ * histograma pré-calculado: os baldes inteiramente contidos saem prontos e só os das pontas
+ * são recortados. O custo é O(log n + b), onde b é o número de baldes não vazios no intervalo.
+ *
+ * Retorna o número de baldes não vazios no intervalo; se for maior que `max_saida`, apenas
+ * os `max_saida` primeiros são escritos.
+ */
+long unsigned int indice_temporal_histograma_intervalo(const IndiceTemporal *indice, Granularidade granularidade,
+                                                       long long inicio, long long fim,
+                                                       ContagemBalde *saida, long unsigned int max_saida) {
+    const HistogramaTemporal *histograma = indice_temporal_histograma(indice, granularidade);
+    if (histograma == NULL || fim <= inicio) {
+        return 0;
+    }
+
+    long unsigned int primeira = primeira_posicao(indice, inicio);
+    long unsigned int ultima = primeira_posicao(indice, fim);
+    if (primeira == ultima) {
+        return 0;
+    }
+
+    // Primeiro balde que termina depois de `primeira`
+    long unsigned int inf = 0, sup = histograma->num_baldes;
+    while (inf < sup) {
+        long unsigned int meio = inf + (sup - inf) / 2;
+        if (histograma->offset[meio + 1] <= primeira) {
+            inf = meio + 1;
+        } else {
+            sup = meio;
+        }
+    }
+
+    long unsigned int baldes = 0;
+    for (long unsigned int k = inf; k < histograma->num_baldes && histograma->offset[k] < ultima; k++) {
+        if (saida != NULL && baldes < max_saida) {
+            long unsigned int de = histograma->offset[k] > primeira ? histograma->offset[k] : primeira;
+            long unsigned int ate = histograma->offset[k + 1] < ultima ? histograma->offset[k + 1] : ultima;
+            saida[baldes].chave = histograma->chaves[k];
+            saida[baldes].contagem = ate - de;
+        }
+        baldes++;
+    }
+    return baldes;
+}
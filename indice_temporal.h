@@ -0,0 +1,50 @@
+#ifndef INDICE_TEMPORAL_H
+#define INDICE_TEMPORAL_H
+
+#include "processo.h"
+#include "colunar.h"
+
+// Tamanho dos baldes dos histogramas temporais
+typedef enum {
+    GRANULARIDADE_DIA = 0,      // Chave AAAAMMDD
+    GRANULARIDADE_MES = 1,      // Chave AAAAMM
+    GRANULARIDADE_ANO = 2,      // Chave AAAA
+    NUM_GRANULARIDADES
+} Granularidade;
+
+// Histograma pré-calculado (formato CSR): o balde k tem chave `chaves[k]` e cobre as
+// posições [offset[k], offset[k+1]) do índice; só aparecem baldes com pelo menos um processo.
+typedef struct {
+    int *chaves;                    // Chaves dos baldes, em ordem crescente
+    long unsigned int *offset;      // num_baldes + 1 posições
+    long unsigned int num_baldes;   // Número de baldes não vazios
+} HistogramaTemporal;
+
+// Contagem de um balde dentro de um intervalo de datas
+typedef struct {
+    int chave;                      // AAAAMMDD, AAAAMM ou AAAA
+    long unsigned int contagem;     // Processos do balde dentro do intervalo
+} ContagemBalde;
+
+// Índice temporal: datas de ajuizamento ordenadas e as linhas correspondentes.
+// As linhas referem-se à ordem do array (ou da base colunar) usado na construção.
+typedef struct {
+    long long *timestamps;          // Datas em milissegundos, em ordem crescente
+    long unsigned int *linhas;      // linhas[i] é a linha com data timestamps[i] (empates na ordem das linhas)
+    long unsigned int tamanho;      // Número de registros indexados
+    HistogramaTemporal histogramas[NUM_GRANULARIDADES];
+    double segundos_construcao;     // Tempo gasto na construção
+} IndiceTemporal;
+
+int indice_temporal_constroi(IndiceTemporal *indice, const Processo *processos, long unsigned int processos_size);
+int indice_temporal_constroi_colunar(IndiceTemporal *indice, const ProcessosColunar *colunar);
+void indice_temporal_libera(IndiceTemporal *indice);
+long unsigned int indice_temporal_bytes(const IndiceTemporal *indice);
+long unsigned int indice_temporal_conta(const IndiceTemporal *indice, long long inicio, long long fim);
+const long unsigned int *indice_temporal_lista(const IndiceTemporal *indice, long long inicio, long long fim,
+                                               long unsigned int *tamanho);
+const HistogramaTemporal *indice_temporal_histograma(const IndiceTemporal *indice, Granularidade granularidade);
+long unsigned int indice_temporal_histograma_intervalo(const IndiceTemporal *indice, Granularidade granularidade,
+                                                       long long inicio, long long fim,
+                                                       ContagemBalde *saida, long unsigned int max_saida);
+#endif
@@ -0,0 +1,649 @@
+#include "ingestao.h"
+#include "conjunto.h"
+
+#include <glob.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Dígitos do carimbo de exportação normalizado (AAAAMMDDHHMMSS)
+#define CARIMBO_DIGITOS 14
+
+// Menor número de dígitos aceito como carimbo (AAAAMMDD)
+#define CARIMBO_MIN_DIGITOS 8
+
+// Arquivo da lista durante a ingestão
+typedef struct {
+    const char *nome;
+    Processo *processos;            // Registros do arquivo, na ordem em que aparecem
+    int *ids;                       // Cópia compacta dos ids, percorrida na resolução de duplicados
+    long unsigned int count;        // Registros lidos
+    long unsigned int inicio;       // Posição do primeiro registro na numeração global (todos os arquivos)
+    long unsigned int destino;      // Posição do primeiro registro mantido na base final
+    long unsigned int mantidos;     // Registros que entram na base final
+    long unsigned int tamanho;      // Tamanho do arquivo em bytes
+    Arena arena;                    // Campos alocados dos registros do arquivo
+    EstatisticasLeitura leitura;
+    int erro;                       // Diferente de 0 se o arquivo não pôde ser lido
+} ArquivoIngestao;
+
+// Estado compartilhado pelas threads de uma etapa da ingestão
+typedef struct {
+    ArquivoIngestao *arquivos;
+    int num_arquivos;
+    const int *ordem;               // Ordem de distribuição dos arquivos (maiores primeiro)
+    int proximo;                    // Próxima posição de `ordem` a ser entregue (acesso atômico)
+    int threads_por_arquivo;        // Threads de `read_csv_paralelo` em cada arquivo
+    const long long *carimbos;      // Carimbo de exportação de cada arquivo
+    RegraDuplicados regra;
+    unsigned char *mantem;          // mantem[g] = 1 se o registro global g entra na base final
+    Processo *saida;                // Base final
+    int erro;                       // Diferente de 0 se faltou memória (acesso atômico)
+} FilaIngestao;
+
+// Registro distribuído para o balde da sua partição
+typedef struct {
+    int id;
+    int arquivo;                    // Arquivo de origem do registro
+    long unsigned int posicao;      // Posição global do registro
+} EntradaMescla;
+
+// Trabalho de uma thread da mescla: uma fatia da numeração global e uma partição dos ids
+typedef struct {
+    FilaIngestao *fila;
+    int particao;                   // Ids com `particao_id(id) == particao`
+    int num_particoes;
+    long unsigned int fatia_inicio; // Registros globais [fatia_inicio, fatia_fim) distribuídos pela thread
+    long unsigned int fatia_fim;
+    long unsigned int *destinos;    // Por partição: contagem da fatia e, depois, próxima posição em `baldes`
+    EntradaMescla *baldes;          // Entradas de todas as partições, agrupadas por partição (compartilhado)
+    long unsigned int balde_inicio; // Trecho de `baldes` que pertence à partição
+    long unsigned int balde_fim;
+    long unsigned int *mantidos;    // Registros mantidos da partição, por arquivo
+    int erro;
+} ParticaoMescla;
+
+/**
+ * carimbo_exportacao - Extrai o carimbo de exportação do nome de um arquivo.
+ * 
+ * @nome_arquivo: Nome no padrão processo_<tribunal>_<AAAAMMDDHHMM>.csv, com ou sem diretório.
+ * 
+ * O carimbo é o último grupo de 8 a 14 dígitos do nome (sem a extensão), precedido por '_'.
+ * É completado com zeros à direita até AAAAMMDDHHMMSS, de modo que carimbos de precisões
+ * diferentes possam ser comparados diretamente.
+ * 
+ * Retorna o carimbo ou 0 se o nome não tiver um.
+ */
+long long carimbo_exportacao(const char *nome_arquivo) {
+    const char *base = strrchr(nome_arquivo, '/');
+    base = base != NULL ? base + 1 : nome_arquivo;
+
+    const char *fim = strrchr(base, '.');
+    if (fim == NULL) {
+        fim = base + strlen(base);
+    }
+    const char *inicio = fim;
+    while (inicio > base && inicio[-1] >= '0' && inicio[-1] <= '9') {
+        inicio--;
+    }
+
+    int digitos = (int)(fim - inicio);
+    if (digitos < CARIMBO_MIN_DIGITOS || digitos > CARIMBO_DIGITOS || (inicio > base && inicio[-1] != '_')) {
+        return 0;
+    }
+
+    long long carimbo = 0;
+    for (int i = 0; i < CARIMBO_DIGITOS; i++) {
+        carimbo = carimbo * 10 + (i < digitos ? inicio[i] - '0' : 0);
+    }
+    return carimbo;
+}
+
+/**
+ * proximo_arquivo - Entrega à thread o próximo arquivo da fila.
+ * 
+ * Retorna o arquivo ou NULL quando a fila acabou.
+ */
+static ArquivoIngestao *proximo_arquivo(FilaIngestao *fila) {
+    int k = __atomic_fetch_add(&fila->proximo, 1, __ATOMIC_RELAXED);
+    return k < fila->num_arquivos ? &fila->arquivos[fila->ordem[k]] : NULL;
+}
+
+/**
+ * trabalhador_leitura - Lê os arquivos da fila até que ela acabe.
+ * 
+ * Cada arquivo é lido em um buffer e uma arena próprios. Quando há duplicados a resolver,
+ * os ids são copiados para um array compacto, que a mescla percorre no lugar dos registros.
+ */
+static void *trabalhador_leitura(void *arg) {
+    FilaIngestao *fila = arg;
+    ArquivoIngestao *arquivo;
+
+    while ((arquivo = proximo_arquivo(fila)) != NULL) {
+        if (arquivo->erro) {
+            continue;
+        }
+        arquivo->count = read_csv_paralelo(arquivo->nome, &arquivo->processos, &arquivo->arena,
+                                           fila->threads_por_arquivo, &arquivo->leitura);
+
+        // Sem conseguir abrir o arquivo, `read_csv_paralelo` devolve 1 e não aloca os registros
+        if (arquivo->processos == NULL) {
+            arquivo->erro = arquivo->count == 1;
+            arquivo->count = 0;
+            continue;
+        }
+
+        if (fila->regra != DUPLICADOS_MANTEM) {
+            arquivo->ids = malloc((arquivo->count > 0 ? arquivo->count : 1) * sizeof(int));
+            if (arquivo->ids == NULL) {
+                __atomic_store_n(&fila->erro, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            for (long unsigned int i = 0; i < arquivo->count; i++) {
+                arquivo->ids[i] = arquivo->processos[i].id;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * particao_id - Partição da mescla responsável por um id.
+ */
+static int particao_id(int id, int num_particoes) {
+    unsigned long long h = (unsigned long long)(unsigned int)id * 0x9E3779B97F4A7C15ULL;
+    return (int)((h >> 32) % (unsigned long long)num_particoes);
+}
+
+/**
+ * arquivo_da_posicao - Arquivo que contém o registro de posição global `g` (busca binária).
+ * 
+ * É o último arquivo que começa em `g` ou antes; arquivos vazios têm o mesmo início do seguinte.
+ */
+static int arquivo_da_posicao(const FilaIngestao *fila, long unsigned int g) {
+    int inf = 0;
+    int sup = fila->num_arquivos - 1;
+
+    while (inf < sup) {
+        int meio = inf + (sup - inf + 1) / 2;
+        if (fila->arquivos[meio].inicio <= g) {
+            inf = meio;
+        } else {
+            sup = meio - 1;
+        }
+    }
+    return inf;
+}
+
+/**
+ * percorre_fatia - Percorre os ids da fatia da thread, contando-os ou espalhando-os por partição.
+ * 
+ * @espalha: 0 para somar a partição de cada id em `destinos`; 1 para gravar cada registro em
+ *           `baldes[destinos[p]++]`.
+ * 
+ * As fatias cobrem a numeração global em ordem, e os destinos de cada thread começam depois dos
+ * das threads anteriores, então cada balde fica na ordem global dos registros.
+ */
+static void percorre_fatia(ParticaoMescla *particao, int espalha) {
+    const FilaIngestao *fila = particao->fila;
+    if (particao->fatia_inicio >= particao->fatia_fim) {
+        return;
+    }
+
+    int f = arquivo_da_posicao(fila, particao->fatia_inicio);
+    long unsigned int i = particao->fatia_inicio - fila->arquivos[f].inicio;
+    for (long unsigned int g = particao->fatia_inicio; g < particao->fatia_fim; g++, i++) {
+        while (i >= fila->arquivos[f].count) {
+            f++;
+            i = 0;
+        }
+        int id = fila->arquivos[f].ids[i];
+        int p = particao_id(id, particao->num_particoes);
+        if (espalha) {
+            EntradaMescla *entrada = &particao->baldes[particao->destinos[p]++];
+            entrada->id = id;
+            entrada->arquivo = f;
+            entrada->posicao = g;
+        } else {
+            particao->destinos[p]++;
+        }
+    }
+}
+
+/**
+ * conta_fatia - Conta quantos ids da fatia da thread caem em cada partição.
+ */
+static void *conta_fatia(void *arg) {
+    percorre_fatia(arg, 0);
+    return NULL;
+}
+
+/**
+ * espalha_fatia - Grava os registros da fatia da thread nos baldes das suas partições.
+ */
+static void *espalha_fatia(void *arg) {
+    percorre_fatia(arg, 1);
+    return NULL;
+}
+
+/**
+ * resolve_particao - Escolhe o registro que representa cada id do balde de uma partição.
+ * 
+ * A primeira passada percorre o balde (na ordem global dos registros) e guarda, para cada id, a
+ * posição do registro vencedor: o primeiro visto ou, com a regra DUPLICADOS_MAIS_RECENTE, o do
+ * arquivo de carimbo maior (empates ficam com o primeiro). A segunda marca os vencedores em
+ * `mantem`. Cada partição escreve posições distintas, sem sincronização.
+ */
+static void *resolve_particao(void *arg) {
+    ParticaoMescla *particao = arg;
+    FilaIngestao *fila = particao->fila;
+    const EntradaMescla *inicio = particao->baldes + particao->balde_inicio;
+    const EntradaMescla *fim = particao->baldes + particao->balde_fim;
+    MapaInteiros vencedores;
+
+    if (mapa_inicializa(&vencedores, (long unsigned int)(fim - inicio) + 1) != 0) {
+        particao->erro = 1;
+        return NULL;
+    }
+
+    for (const EntradaMescla *entrada = inicio; entrada < fim; entrada++) {
+        long unsigned int atual;
+        if (!mapa_busca(&vencedores, entrada->id, &atual)) {
+            if (mapa_insere(&vencedores, entrada->id, (long unsigned int)(entrada - particao->baldes)) < 0) {
+                particao->erro = 1;
+                break;
+            }
+        } else if (fila->regra == DUPLICADOS_MAIS_RECENTE &&
+                   fila->carimbos[entrada->arquivo] > fila->carimbos[particao->baldes[atual].arquivo]) {
+            mapa_insere(&vencedores, entrada->id, (long unsigned int)(entrada - particao->baldes));
+        }
+    }
+
+    for (const EntradaMescla *entrada = inicio; entrada < fim && !particao->erro; entrada++) {
+        long unsigned int vencedor;
+        if (mapa_busca(&vencedores, entrada->id, &vencedor) &&
+            vencedor == (long unsigned int)(entrada - particao->baldes)) {
+            fila->mantem[entrada->posicao] = 1;
+            particao->mantidos[entrada->arquivo]++;
+        }
+    }
+
+    mapa_libera(&vencedores);
+    return NULL;
+}
+
+/**
+ * trabalhador_copia - Copia os registros mantidos de cada arquivo da fila para a base final.
+ * 
+ * Cada arquivo tem seu trecho reservado na saída, então as cópias não se sobrepõem.
+ */
+static void *trabalhador_copia(void *arg) {
+    FilaIngestao *fila = arg;
+    ArquivoIngestao *arquivo;
+
+    while ((arquivo = proximo_arquivo(fila)) != NULL) {
+        Processo *destino = fila->saida + arquivo->destino;
+
+        if (fila->regra == DUPLICADOS_MANTEM) {
+            memcpy(destino, arquivo->processos, arquivo->count * sizeof(Processo));
+        } else {
+            const unsigned char *mantem = fila->mantem + arquivo->inicio;
+            for (long unsigned int i = 0; i < arquivo->count; i++) {
+                if (mantem[i]) {
+                    *destino++ = arquivo->processos[i];
+                }
+            }
+        }
+        free(arquivo->processos);
+        arquivo->processos = NULL;
+    }
+    return NULL;
+}
+
+/**
+ * executa_fila - Roda `funcao` em `num_threads` threads que consomem a fila de arquivos.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória para as threads.
+ */
+static int executa_fila(FilaIngestao *fila, void *(*funcao)(void *), int num_threads) {
+    pthread_t *threads = malloc((size_t)num_threads * sizeof(pthread_t));
+    if (threads == NULL) {
+        return -1;
+    }
+
+    // Sem conseguir criar uma thread, a atual consome o restante da fila
+    fila->proximo = 0;
+    int criadas = 0;
+    while (criadas < num_threads && pthread_create(&threads[criadas], NULL, funcao, fila) == 0) {
+        criadas++;
+    }
+    if (criadas < num_threads) {
+        funcao(fila);
+    }
+    for (int t = 0; t < criadas; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    return 0;
+}
+
+/**
+ * executa_particoes - Roda `funcao` em uma thread por partição e espera todas terminarem.
+ * 
+ * Se uma thread não puder ser criada, ela e as seguintes partições são processadas na thread atual.
+ */
+static void executa_particoes(ParticaoMescla *particoes, pthread_t *threads, int num_particoes,
+                              void *(*funcao)(void *)) {
+    int criadas = 0;
+    for (int p = 0; p < num_particoes; p++) {
+        if (criadas == p && pthread_create(&threads[p], NULL, funcao, &particoes[p]) == 0) {
+            criadas++;
+        } else {
+            funcao(&particoes[p]);
+        }
+    }
+    for (int p = 0; p < criadas; p++) {
+        pthread_join(threads[p], NULL);
+    }
+}
+
+/**
+ * mescla_duplicados - Resolve os ids repetidos em paralelo, particionando os ids entre as threads.
+ * 
+ * Os registros são espalhados uma única vez em baldes por partição: cada thread conta e depois
+ * distribui uma fatia da numeração global, e em seguida cada thread resolve o balde da sua
+ * partição. O trabalho total é proporcional ao número de registros, e não ao número de registros
+ * vezes o número de threads.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+static int mescla_duplicados(FilaIngestao *fila, long unsigned int total, int num_threads) {
+    int num_particoes = (long unsigned int)num_threads > total ? (int)total : num_threads;
+    ParticaoMescla *particoes = calloc((size_t)num_particoes, sizeof(ParticaoMescla));
+    pthread_t *threads = malloc((size_t)num_particoes * sizeof(pthread_t));
+    EntradaMescla *baldes = malloc(total * sizeof(EntradaMescla));
+    int erro = particoes == NULL || threads == NULL || baldes == NULL;
+
+    fila->mantem = calloc(total, 1);
+    erro |= fila->mantem == NULL;
+    for (int p = 0; p < num_particoes && !erro; p++) {
+        particoes[p].fila = fila;
+        particoes[p].particao = p;
+        particoes[p].num_particoes = num_particoes;
+        particoes[p].fatia_inicio = total * (long unsigned int)p / (long unsigned int)num_particoes;
+        particoes[p].fatia_fim = total * (long unsigned int)(p + 1) / (long unsigned int)num_particoes;
+        particoes[p].baldes = baldes;
+        particoes[p].destinos = calloc((size_t)num_particoes, sizeof(long unsigned int));
+        particoes[p].mantidos = calloc((size_t)fila->num_arquivos, sizeof(long unsigned int));
+        erro = particoes[p].destinos == NULL || particoes[p].mantidos == NULL;
+    }
+
+    if (!erro) {
+        executa_particoes(particoes, threads, num_particoes, conta_fatia);
+
+        // Soma de prefixos: balde a balde e, dentro de cada balde, fatia a fatia
+        long unsigned int posicao = 0;
+        for (int q = 0; q < num_particoes; q++) {
+            particoes[q].balde_inicio = posicao;
+            for (int p = 0; p < num_particoes; p++) {
+                long unsigned int contagem = particoes[p].destinos[q];
+                particoes[p].destinos[q] = posicao;
+                posicao += contagem;
+            }
+            particoes[q].balde_fim = posicao;
+        }
+
+        executa_particoes(particoes, threads, num_particoes, espalha_fatia);
+        executa_particoes(particoes, threads, num_particoes, resolve_particao);
+        for (int p = 0; p < num_particoes; p++) {
+            erro |= particoes[p].erro;
+            for (int f = 0; f < fila->num_arquivos; f++) {
+                fila->arquivos[f].mantidos += particoes[p].mantidos[f];
+            }
+        }
+    }
+
+    for (int p = 0; particoes != NULL && p < num_particoes; p++) {
+        free(particoes[p].destinos);
+        free(particoes[p].mantidos);
+    }
+    free(particoes);
+    free(threads);
+    free(baldes);
+    return erro ? -1 : 0;
+}
+
+/**
+ * read_csv_multiplos - Lê vários CSVs concorrentemente e os mescla em uma única base.
+ * 
+ * @nomes: Nomes dos arquivos; a ordem da lista é a ordem dos registros na base final.
+ * @num_arquivos: Número de arquivos.
+ * @processos: Ponteiro que receberá o array com os registros mesclados.
+ * @arena: Arena que passa a ser dona dos campos alocados dos registros.
+ * @regra: Tratamento dos ids que aparecem mais de uma vez.
+ * @num_threads: Número de threads; se menor ou igual a 0, usa o número de núcleos disponíveis.
+ * @stats: Estrutura que receberá a vazão por arquivo e total (pode ser NULL); liberar com
+ *         `ingestao_libera_estatisticas`.
+ * 
+ * Os arquivos são distribuídos dos maiores para os menores entre as threads, e cada um é lido
+ * por `read_csv_paralelo` em buffer e arena próprios; com menos arquivos que threads, as threads
+ * que sobram dividem a análise de cada arquivo. A mescla não ordena: os ids são particionados por
+ * hash entre as threads, cada uma escolhe os vencedores da sua partição e, por fim, cada arquivo
+ * copia os registros mantidos para o seu trecho da base final. Os registros ficam na ordem da lista
+ * e, dentro de cada arquivo, na ordem do arquivo. Com regra diferente de DUPLICADOS_MANTEM, um id
+ * repetido dentro do mesmo arquivo também fica só com a primeira ocorrência.
+ * 
+ * Um arquivo que não pode ser aberto é informado e ignorado. Os campos dos registros descartados
+ * continuam na arena até `arena_libera`.
+ * 
+ * Retorna o número de registros da base mesclada ou -1 se não houver memória.
+ */
+long int read_csv_multiplos(const char *const *nomes, int num_arquivos, Processo **processos, Arena *arena,
+                            RegraDuplicados regra, int num_threads, EstatisticasIngestao *stats) {
+    double inicio = agora_segundos();
+    EstatisticasIngestao local;
+
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(EstatisticasIngestao));
+    *processos = NULL;
+    if (num_arquivos <= 0) {
+        return 0;
+    }
+
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_threads <= 0) {
+            num_threads = 1;
+        }
+    }
+
+    ArquivoIngestao *arquivos = calloc((size_t)num_arquivos, sizeof(ArquivoIngestao));
+    int *ordem = malloc((size_t)num_arquivos * sizeof(int));
+    long long *carimbos = malloc((size_t)num_arquivos * sizeof(long long));
+    stats->arquivos = calloc((size_t)num_arquivos, sizeof(EstatisticasArquivo));
+    if (arquivos == NULL || ordem == NULL || carimbos == NULL || stats->arquivos == NULL) {
+        free(arquivos);
+        free(ordem);
+        free(carimbos);
+        ingestao_libera_estatisticas(stats);
+        return -1;
+    }
+    stats->num_arquivos = num_arquivos;
+
+    for (int f = 0; f < num_arquivos; f++) {
+        struct stat st;
+        arquivos[f].nome = nomes[f];
+        arena_inicializa(&arquivos[f].arena, arena->tamanho_bloco);
+        if (stat(nomes[f], &st) != 0) {
+            printf("Erro ao abrir o arquivo %s.\n", nomes[f]);
+            arquivos[f].erro = 1;
+        } else {
+            arquivos[f].tamanho = (long unsigned int)st.st_size;
+        }
+        carimbos[f] = carimbo_exportacao(nomes[f]);
+
+        // Inserção ordenada por tamanho decrescente: as listas de arquivos são curtas
+        int k = f;
+        while (k > 0 && arquivos[ordem[k - 1]].tamanho < arquivos[f].tamanho) {
+            ordem[k] = ordem[k - 1];
+            k--;
+        }
+        ordem[k] = f;
+    }
+
+    FilaIngestao fila;
+    memset(&fila, 0, sizeof(FilaIngestao));
+    fila.arquivos = arquivos;
+    fila.num_arquivos = num_arquivos;
+    fila.ordem = ordem;
+    fila.threads_por_arquivo = num_threads > num_arquivos ? num_threads / num_arquivos : 1;
+    fila.carimbos = carimbos;
+    fila.regra = regra;
+
+    int trabalhadores = num_threads < num_arquivos ? num_threads : num_arquivos;
+    int erro = executa_fila(&fila, trabalhador_leitura, trabalhadores) != 0 || fila.erro;
+    stats->segundos_leitura = agora_segundos() - inicio;
+
+    // Numeração global dos registros, na ordem da lista
+    long unsigned int total = 0;
+    for (int f = 0; f < num_arquivos; f++) {
+        arquivos[f].inicio = total;
+        arquivos[f].mantidos = arquivos[f].count;
+        total += arquivos[f].count;
+    }
+
+    double inicio_mescla = agora_segundos();
+    if (!erro && regra != DUPLICADOS_MANTEM && total > 0) {
+        for (int f = 0; f < num_arquivos; f++) {
+            arquivos[f].mantidos = 0;
+        }
+        erro = mescla_duplicados(&fila, total, num_threads) != 0;
+    }
+
+    long unsigned int mantidos = 0;
+    for (int f = 0; f < num_arquivos; f++) {
+        arquivos[f].destino = mantidos;
+        mantidos += arquivos[f].mantidos;
+    }
+    if (!erro) {
+        fila.saida = malloc((mantidos > 0 ? mantidos : 1) * sizeof(Processo));
+        erro = fila.saida == NULL || executa_fila(&fila, trabalhador_copia, trabalhadores) != 0;
+    }
+    stats->segundos_mescla = agora_segundos() - inicio_mescla;
+
+    if (erro) {
+        printf("Erro ao alocar memória para a mescla dos arquivos.\n");
+        free(fila.saida);
+        fila.saida = NULL;
+        mantidos = 0;
+    }
+    for (int f = 0; f < num_arquivos; f++) {
+        EstatisticasArquivo *arquivo = &stats->arquivos[f];
+        arquivo->nome = strdup(nomes[f]);
+        arquivo->carimbo = carimbos[f];
+        arquivo->linhas = arquivos[f].count;
+        arquivo->mantidos = erro ? 0 : arquivos[f].mantidos;
+        arquivo->bytes = arquivos[f].tamanho;
+        arquivo->segundos = arquivos[f].leitura.segundos;
+        arquivo->erro = arquivos[f].erro;
+        stats->linhas += arquivo->linhas;
+        stats->bytes += arquivo->bytes;
+
+        free(arquivos[f].processos);
+        free(arquivos[f].ids);
+        if (erro) {
+            arena_libera(&arquivos[f].arena);
+        } else {
+            arena_absorve(arena, &arquivos[f].arena);
+        }
+    }
+    stats->registros = mantidos;
+    stats->duplicados = erro ? 0 : stats->linhas - mantidos;
+    stats->segundos = agora_segundos() - inicio;
+
+    *processos = fila.saida;
+    free(fila.mantem);
+    free(arquivos);
+    free(ordem);
+    free(carimbos);
+    if (stats == &local) {
+        ingestao_libera_estatisticas(stats);
+    }
+    return erro ? -1 : (long int)mantidos;
+}
+
+/**
+ * read_csv_glob - Versão de `read_csv_multiplos` que recebe um padrão de nomes (ex.: "processo_*.csv").
+ * 
+ * Os arquivos entram na ordem alfabética devolvida por `glob`.
+ * 
+ * Retorna o número de registros da base mesclada ou -1 se nenhum arquivo corresponder ao padrão
+ * ou se não houver memória.
+ */
+long int read_csv_glob(const char *padrao, Processo **processos, Arena *arena, RegraDuplicados regra,
+                       int num_threads, EstatisticasIngestao *stats) {
+    glob_t resultado;
+
+    *processos = NULL;
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(EstatisticasIngestao));
+    }
+    if (glob(padrao, 0, NULL, &resultado) != 0) {
+        printf("Nenhum arquivo corresponde a %s.\n", padrao);
+        return -1;
+    }
+
+    long int count = read_csv_multiplos((const char *const *)resultado.gl_pathv, (int)resultado.gl_pathc,
+                                        processos, arena, regra, num_threads, stats);
+    globfree(&resultado);
+    return count;
+}
+
+/**
+ * ingestao_libera_estatisticas - Libera a lista de arquivos das estatísticas de ingestão.
+ */
+void ingestao_libera_estatisticas(EstatisticasIngestao *stats) {
+    for (int f = 0; stats->arquivos != NULL && f < stats->num_arquivos; f++) {
+        free(stats->arquivos[f].nome);
+    }
+    free(stats->arquivos);
+    stats->arquivos = NULL;
+    stats->num_arquivos = 0;
+}
+
+/**
+ * print_estatisticas_ingestao - Imprime a vazão de cada arquivo e da ingestão completa.
+ * 
+ * @stats: Estatísticas preenchidas por `read_csv_multiplos`.
+ */
+void print_estatisticas_ingestao(const EstatisticasIngestao *stats) {
+    printf("%-40s | %-14s | %-10s | %-10s | %-8s | %-12s | %-8s\n", "Arquivo", "Carimbo", "Registros",
+           "Mantidos", "Tempo(s)", "Registros/s", "MB/s");
+    for (int f = 0; f < stats->num_arquivos; f++) {
+        const EstatisticasArquivo *arquivo = &stats->arquivos[f];
+        double segundos = arquivo->segundos > 0 ? arquivo->segundos : 1e-9;
+
+        if (arquivo->erro) {
+            printf("%-40s | %-14lld | %-10s |\n", arquivo->nome, arquivo->carimbo, "erro");
+            continue;
+        }
+        printf("%-40s | %-14lld | %-10lu | %-10lu | %-8.3f | %-12.0f | %-8.1f\n", arquivo->nome, arquivo->carimbo,
+               arquivo->linhas, arquivo->mantidos, arquivo->segundos, (double)arquivo->linhas / segundos,
+               (double)arquivo->bytes / segundos / (1024.0 * 1024.0));
+    }
+
+    double segundos = stats->segundos > 0 ? stats->segundos : 1e-9;
+    printf("Ingestão: %d arquivos, %lu registros lidos, %lu na base (%lu duplicados descartados) em %.3f s "
+           "(leitura %.3f s, mescla %.3f s; %.0f registros/s, %.1f MB/s)\n",
+        stats->num_arquivos,
+        stats->linhas,
+        stats->registros,
+        stats->duplicados,
+        stats->segundos,
+        stats->segundos_leitura,
+        stats->segundos_mescla,
+        (double)stats->linhas / segundos,
+        (double)stats->bytes / segundos / (1024.0 * 1024.0));
+}
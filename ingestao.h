@@ -0,0 +1,44 @@
+#ifndef INGESTAO_H
+#define INGESTAO_H
+
+#include "processo.h"
+
+// Regra aplicada a um id que aparece mais de uma vez na base mesclada
+typedef enum {
+    DUPLICADOS_MAIS_RECENTE = 0,    // Vale o registro do arquivo com o carimbo de exportação mais recente
+    DUPLICADOS_PRIMEIRO = 1,        // Vale o registro do primeiro arquivo da lista
+    DUPLICADOS_MANTEM = 2           // Todos os registros são mantidos
+} RegraDuplicados;
+
+// Resultado da leitura de um arquivo da lista
+typedef struct {
+    char *nome;                     // Nome do arquivo
+    long long carimbo;              // Carimbo de exportação (AAAAMMDDHHMMSS) extraído do nome, 0 se ausente
+    long unsigned int linhas;       // Registros lidos do arquivo
+    long unsigned int mantidos;     // Registros que sobreviveram à resolução de duplicados
+    long unsigned int bytes;        // Tamanho do arquivo
+    double segundos;                // Tempo de leitura e análise do arquivo
+    int erro;                       // Diferente de 0 se o arquivo não pôde ser lido
+} EstatisticasArquivo;
+
+// Vazão de uma ingestão de vários arquivos
+typedef struct {
+    EstatisticasArquivo *arquivos;  // Uma posição por arquivo, na ordem da lista
+    int num_arquivos;
+    long unsigned int linhas;       // Registros lidos de todos os arquivos
+    long unsigned int registros;    // Registros na base mesclada
+    long unsigned int duplicados;   // Registros descartados pela regra de duplicados
+    long unsigned int bytes;        // Soma dos tamanhos dos arquivos
+    double segundos_leitura;        // Leitura concorrente dos arquivos
+    double segundos_mescla;         // Resolução de duplicados e cópia para a base final
+    double segundos;                // Tempo total
+} EstatisticasIngestao;
+
+long long carimbo_exportacao(const char *nome_arquivo);
+long int read_csv_multiplos(const char *const *nomes, int num_arquivos, Processo **processos, Arena *arena,
+                            RegraDuplicados regra, int num_threads, EstatisticasIngestao *stats);
+long int read_csv_glob(const char *padrao, Processo **processos, Arena *arena, RegraDuplicados regra,
+                       int num_threads, EstatisticasIngestao *stats);
+void ingestao_libera_estatisticas(EstatisticasIngestao *stats);
+void print_estatisticas_ingestao(const EstatisticasIngestao *stats);
+#endif
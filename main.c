@@ -2,47 +2,114 @@
 #include <stdlib.h>
 
 #include "processo.h"
+#include "colunar.h"
+#include "ordenacao.h"
+#include "indice.h"
+#include "snapshot.h"
+#include "metricas.h"
+#include "ingestao.h"
 
-int main()
+int main(int argc, char *argv[])
 {
     Processo *processos;
+    EstatisticasLeitura stats;
+    Arena arena;
+    ProcessosColunar colunar;
+    long unsigned int *indices;
+    IndiceInvertido indice_classes;
+    IndicePrimario indice_ids;
     const long unsigned int MAX_DADOS_PRINT = 5;
     int id_classe = 11528;
     const int id_processo = 680402167;
 
-    long unsigned int qnt_processos = read_csv("processo_043_202409032338.csv", &processos);
-    printf("Número de processos lidos: %lu\n", qnt_processos);
+    // Com PROCESSO_METRICAS=1, o tempo de cada etapa é escrito em stderr ao final
+    metricas_ativa_por_ambiente();
+    arena_inicializa(&arena, 0);
+    long unsigned int qnt_processos;
+    if (argc > 1) {
+        // Vários exportes (ex.: ./main processo_*.csv): ids repetidos ficam com o exporte mais recente
+        EstatisticasIngestao ingestao;
+        long int lidos = read_csv_multiplos((const char *const *)&argv[1], argc - 1, &processos, &arena,
+                                            DUPLICADOS_MAIS_RECENTE, 0, &ingestao);
+        print_estatisticas_ingestao(&ingestao);
+        ingestao_libera_estatisticas(&ingestao);
+        if (lidos < 0) {
+            arena_libera(&arena);
+            return 1;
+        }
+        qnt_processos = (long unsigned int)lidos;
+        printf("Número de processos lidos: %lu\n", qnt_processos);
+    } else {
+        qnt_processos = carrega_base("processo_043_202409032338.csv", "processo_043_202409032338.snap",
+                                     &processos, &arena, 0, &stats);
+        printf("Número de processos lidos: %lu\n", qnt_processos);
+        print_estatisticas_leitura(&stats);
+    }
+    if (colunar_constroi(processos, qnt_processos, &colunar) != 0) {
+        printf("Erro ao construir a base colunar.\n");
+        arena_libera(&arena);
+        free(processos);
+        return 1;
+    }
+    indices = malloc((qnt_processos > 0 ? qnt_processos : 1) * sizeof(long unsigned int));
+    if (indices == NULL) {
+        printf("Erro ao alocar memória para a ordenação.\n");
+        colunar_libera(&colunar);
+        arena_libera(&arena);
+        free(processos);
+        return 1;
+    }
     print_processos(&processos, 0, MAX_DADOS_PRINT); // Imprime os 2 primeiros processos
 
     printf("\n1. Ordenar, em ordem crescente, o conjunto de processos a partir do atributo “id”;\n");
-    quicksort(processos, 0, qnt_processos - 1, compara_id);
-    export_csv("processo_043_202409032338_ordenado_id.csv", &processos, 0, qnt_processos);
-    print_processos(&processos, 0, MAX_DADOS_PRINT);
+    if (ordena_indices_por_id(processos, qnt_processos, indices, ORDEM_CRESCENTE) != 0 ||
+        aplica_permutacao(processos, indices, qnt_processos) != 0) {
+        printf("Erro ao ordenar os processos por id.\n");
+    } else {
+        export_csv("processo_043_202409032338_ordenado_id.csv", &processos, 0, qnt_processos);
+        print_processos(&processos, 0, MAX_DADOS_PRINT);
+    }
 
     printf("\n2. Ordenar, em ordem decrescente, o conjunto de processos a partir do atributo “data_ajuizamento”;\n");
-    quicksort(processos, 0, qnt_processos - 1, compara_data);
-    export_csv("processo_043_202409032338_ordenado_data.csv", &processos, 0, qnt_processos);
-    print_processos(&processos, 0, MAX_DADOS_PRINT);
+    if (ordena_indices_por_data(processos, qnt_processos, indices, ORDEM_DECRESCENTE) != 0 ||
+        aplica_permutacao(processos, indices, qnt_processos) != 0) {
+        printf("Erro ao ordenar os processos por data.\n");
+    } else {
+        export_csv("processo_043_202409032338_ordenado_data.csv", &processos, 0, qnt_processos);
+        print_processos(&processos, 0, MAX_DADOS_PRINT);
+    }
 
     printf("\n3. Contar quantos processos estão vinculados a um determinado “id_classe”;\n");
-    printf("Quantidade de processos com id_classe %d: %d\n", id_classe, count_id(processos, qnt_processos, id_classe));
+    int processos_classe;
+    if (indice_invertido_constroi(&indice_classes, processos, qnt_processos, CAMPO_CLASSE) == 0) {
+        processos_classe = count_id_indice(&indice_classes, id_classe);
+    } else {
+        // Sem memória para o índice, a contagem é feita pela varredura dos registros
+        printf("Erro ao construir o índice de classes.\n");
+        processos_classe = count_id(processos, qnt_processos, id_classe);
+    }
+    printf("Quantidade de processos com id_classe %d: %d\n", id_classe, processos_classe);
 
     printf("\n4. Identificar quantos “id_assuntos” constam nos processos presentes na base de processos;\n");
-    printf("Quantidade de id_assuntos: %ld\n", count_assuntos(processos, qnt_processos));
+    printf("Quantidade de id_assuntos: %ld\n", count_assuntos_colunar(&colunar));
 
     printf("\n5. Listar todos os processos que estão vinculados a mais de um assunto;\n");
-    printf("Processos com mais de um assunto: %d\n", mais_de_um_assunto(processos, qnt_processos));
+    printf("Processos com mais de um assunto: %d\n", mais_de_um_assunto_colunar(&colunar));
 
     printf("\n6. Indicar a quantos dias um processo está em tramitação na justiça;\n");
-    printf("O processo %d em tramitação na justiça a %d dias\n",id_processo, count_dias(processos, qnt_processos, id_processo));
+    indice_primario_constroi(&indice_ids, processos, qnt_processos);
+    printf("O processo %d em tramitação na justiça a %d dias\n",id_processo, count_dias_indice(processos, &indice_ids, id_processo));
 
 
-    // Libera memória alocada
-    for (long unsigned int i = 0; i < qnt_processos; i++) {
-        free(processos[i].data);
-        free(processos[i].classe);
-        free(processos[i].assunto);
-    }
+    // Libera memória alocada (campos dos registros ficam na arena)
+    free(indices);
+    indice_invertido_libera(&indice_classes);
+    indice_primario_libera(&indice_ids);
+    colunar_libera(&colunar);
+    arena_libera(&arena);
     free(processos);
+    if (metricas_ligadas()) {
+        metricas_imprime_json(stderr);
+    }
     return 0;
 }
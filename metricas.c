@@ -0,0 +1,137 @@
+#include "metricas.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Os contadores são atualizados com operações atômicas relaxadas: as threads de
+// `read_csv_paralelo` e `ordena_paralelo` podem registrar ao mesmo tempo.
+static int ativas = 0;
+static ContadorMetrica contadores[NUM_METRICAS];
+
+static const char *nomes[NUM_METRICAS] = {
+    "leitura",
+    "analise",
+    "ordenacao",
+    "exportacao",
+    "consulta"
+};
+
+/**
+ * agora_nanossegundos - Retorna o instante atual de um relógio monotônico, em nanossegundos.
+ */
+static long long agora_nanossegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * metricas_ativa - Liga ou desliga a coleta dos contadores da biblioteca.
+ *
+ * @ativa: Diferente de 0 para ligar.
+ *
+ * Desligados (o padrão), os pontos de medição custam apenas a leitura de uma variável.
+ */
+void metricas_ativa(int ativa) {
+    __atomic_store_n(&ativas, ativa != 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * metricas_ativa_por_ambiente - Liga os contadores se `PROCESSO_METRICAS` estiver definida e não for "0".
+ *
+ * Permite que um binário de produção passe a medir suas etapas sem ser recompilado.
+ *
+ * Retorna 1 se os contadores ficaram ligados ou 0 caso contrário.
+ */
+int metricas_ativa_por_ambiente(void) {
+    const char *valor = getenv(METRICAS_VARIAVEL_AMBIENTE);
+    metricas_ativa(valor != NULL && valor[0] != '\0' && strcmp(valor, "0") != 0);
+    return metricas_ligadas();
+}
+
+/**
+ * metricas_ligadas - Retorna 1 se os contadores estiverem ligados ou 0 caso contrário.
+ */
+int metricas_ligadas(void) {
+    return __atomic_load_n(&ativas, __ATOMIC_RELAXED);
+}
+
+/**
+ * metricas_inicio - Marca o início de uma etapa.
+ *
+ * Retorna o instante atual em nanossegundos ou 0 se os contadores estiverem desligados.
+ */
+long long metricas_inicio(void) {
+    return metricas_ligadas() ? agora_nanossegundos() : 0;
+}
+
+/**
+ * metricas_registra - Acumula uma execução de `etapa` iniciada em `inicio`.
+ *
+ * @etapa: Etapa medida.
+ * @inicio: Valor retornado por `metricas_inicio`; se 0, a execução não é registrada.
+ * @registros: Registros processados pela execução.
+ */
+void metricas_registra(EtapaMetrica etapa, long long inicio, long unsigned int registros) {
+    if (inicio == 0 || (int)etapa < 0 || (int)etapa >= NUM_METRICAS) {
+        return;
+    }
+
+    long long decorrido = agora_nanossegundos() - inicio;
+    ContadorMetrica *contador = &contadores[etapa];
+    __atomic_fetch_add(&contador->chamadas, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&contador->registros, registros, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&contador->nanossegundos, (long unsigned int)(decorrido > 0 ? decorrido : 0),
+                       __ATOMIC_RELAXED);
+}
+
+/**
+ * metricas_zera - Zera os contadores de todas as etapas.
+ */
+void metricas_zera(void) {
+    for (int e = 0; e < NUM_METRICAS; e++) {
+        __atomic_store_n(&contadores[e].chamadas, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&contadores[e].registros, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&contadores[e].nanossegundos, 0, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * metricas_le - Copia os totais acumulados de `etapa` para `contador`.
+ */
+void metricas_le(EtapaMetrica etapa, ContadorMetrica *contador) {
+    memset(contador, 0, sizeof(*contador));
+    if ((int)etapa < 0 || (int)etapa >= NUM_METRICAS) {
+        return;
+    }
+    contador->chamadas = __atomic_load_n(&contadores[etapa].chamadas, __ATOMIC_RELAXED);
+    contador->registros = __atomic_load_n(&contadores[etapa].registros, __ATOMIC_RELAXED);
+    contador->nanossegundos = __atomic_load_n(&contadores[etapa].nanossegundos, __ATOMIC_RELAXED);
+}
+
+/**
+ * metricas_nome - Retorna o nome de `etapa` usado na saída JSON.
+ */
+const char *metricas_nome(EtapaMetrica etapa) {
+    return (int)etapa >= 0 && (int)etapa < NUM_METRICAS ? nomes[etapa] : "desconhecida";
+}
+
+/**
+ * metricas_imprime_json - Escreve os contadores de todas as etapas como um objeto JSON.
+ *
+ * @saida: Arquivo de destino (por exemplo, `stderr`, para não misturar com a saída do programa).
+ *
+ * Formato: {"leitura": {"chamadas": N, "registros": N, "segundos": S}, ...}
+ */
+void metricas_imprime_json(FILE *saida) {
+    fprintf(saida, "{");
+    for (int e = 0; e < NUM_METRICAS; e++) {
+        ContadorMetrica contador;
+        metricas_le((EtapaMetrica)e, &contador);
+        fprintf(saida, "%s\"%s\": {\"chamadas\": %lu, \"registros\": %lu, \"segundos\": %.6f}",
+            e > 0 ? ", " : "", nomes[e], contador.chamadas, contador.registros,
+            (double)contador.nanossegundos / 1e9);
+    }
+    fprintf(saida, "}\n");
+}
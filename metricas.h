@@ -0,0 +1,35 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include<stdio.h>
+
+// Etapas do pipeline acompanhadas pelos contadores da biblioteca
+typedef enum {
+    METRICA_LEITURA,        // read_csv, read_csv_stats, read_csv_paralelo e carga de snapshot
+    METRICA_ANALISE,        // Análise das linhas (parse_line e os trechos de parse_registro)
+    METRICA_ORDENACAO,      // quicksort, ordena_indices_por_* e ordena_paralelo
+    METRICA_EXPORTACAO,     // export_csv e export_csv_indices
+    METRICA_CONSULTA,       // count_id, count_assuntos, mais_de_um_assunto, count_dias e versões colunares
+    NUM_METRICAS
+} EtapaMetrica;
+
+// Totais acumulados de uma etapa desde a última chamada a `metricas_zera`
+typedef struct {
+    long unsigned int chamadas;         // Número de execuções da etapa
+    long unsigned int registros;        // Registros processados
+    long unsigned int nanossegundos;    // Tempo total (somado entre threads)
+} ContadorMetrica;
+
+// Variável de ambiente que liga os contadores em `metricas_ativa_por_ambiente`
+#define METRICAS_VARIAVEL_AMBIENTE "PROCESSO_METRICAS"
+
+void metricas_ativa(int ativa);
+int metricas_ativa_por_ambiente(void);
+int metricas_ligadas(void);
+long long metricas_inicio(void);
+void metricas_registra(EtapaMetrica etapa, long long inicio, long unsigned int registros);
+void metricas_zera(void);
+void metricas_le(EtapaMetrica etapa, ContadorMetrica *contador);
+const char *metricas_nome(EtapaMetrica etapa);
+void metricas_imprime_json(FILE *saida);
+#endif
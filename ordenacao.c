@@ -0,0 +1,664 @@
+#include "ordenacao.h"
+#include "metricas.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+// Número de bits ordenados por passada do radix sort
+#define RADIX_BITS 8
+#define RADIX_BALDES (1 << RADIX_BITS)
+#define RADIX_PASSADAS (64 / RADIX_BITS)
+
+// Trechos menores que isso são ordenados por inserção no merge sort
+#define LIMITE_INSERCAO 32
+
+/**
+ * radix_sort_indices - Ordena uma permutação de índices pelas chaves inteiras de 64 bits (LSD radix sort).
+ * 
+ * @chaves: Array de `n` chaves sem sinal; não é modificado.
+ * @n: Número de chaves.
+ * @indices: Array de `n` posições que receberá a permutação ordenada: `chaves[indices[0]]` é a menor
+ *           (ou a maior, em ordem decrescente).
+ * @ordem: `ORDEM_CRESCENTE` ou `ORDEM_DECRESCENTE`.
+ * 
+ * Os registros nunca são movidos: apenas pares (chave, índice) de 16 bytes passam pelas passadas.
+ * Os histogramas dos 8 bytes são calculados em uma única leitura das chaves, e as passadas em que
+ * todas as chaves têm o mesmo byte são puladas; assim, chaves de 32 bits custam no máximo 4 passadas.
+ * A ordenação é estável também em ordem decrescente (as chaves são complementadas).
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int radix_sort_indices(const unsigned long long *chaves, long unsigned int n, long unsigned int *indices, Ordem ordem) {
+    unsigned long long inverte = ordem == ORDEM_DECRESCENTE ? ~0ULL : 0ULL;
+    long unsigned int (*histograma)[RADIX_BALDES] = calloc(RADIX_PASSADAS, sizeof(*histograma));
+    unsigned long long *chaves_a = malloc(n * sizeof(unsigned long long));
+    unsigned long long *chaves_b = malloc(n * sizeof(unsigned long long));
+    long unsigned int *indices_b = malloc(n * sizeof(long unsigned int));
+
+    if (histograma == NULL || chaves_a == NULL || chaves_b == NULL || indices_b == NULL) {
+        free(histograma);
+        free(chaves_a);
+        free(chaves_b);
+        free(indices_b);
+        return -1;
+    }
+
+    // Copia as chaves, inicializa a permutação e conta os bytes de todas as passadas
+    for (long unsigned int i = 0; i < n; i++) {
+        unsigned long long chave = chaves[i] ^ inverte;
+        chaves_a[i] = chave;
+        indices[i] = i;
+        for (int passada = 0; passada < RADIX_PASSADAS; passada++) {
+            histograma[passada][(chave >> (passada * RADIX_BITS)) & (RADIX_BALDES - 1)]++;
+        }
+    }
+
+    unsigned long long *chaves_origem = chaves_a, *chaves_destino = chaves_b;
+    long unsigned int *indices_origem = indices, *indices_destino = indices_b;
+
+    for (int passada = 0; passada < RADIX_PASSADAS; passada++) {
+        long unsigned int *contagem = histograma[passada];
+        int deslocamento = passada * RADIX_BITS;
+
+        // Pula a passada se todas as chaves caem no mesmo balde
+        if (n == 0 || contagem[(chaves_origem[0] >> deslocamento) & (RADIX_BALDES - 1)] == n) {
+            continue;
+        }
+
+        // Converte as contagens em posições iniciais de cada balde
+        long unsigned int soma = 0;
+        for (int b = 0; b < RADIX_BALDES; b++) {
+            long unsigned int c = contagem[b];
+            contagem[b] = soma;
+            soma += c;
+        }
+
+        for (long unsigned int i = 0; i < n; i++) {
+            unsigned long long chave = chaves_origem[i];
+            long unsigned int pos = contagem[(chave >> deslocamento) & (RADIX_BALDES - 1)]++;
+            chaves_destino[pos] = chave;
+            indices_destino[pos] = indices_origem[i];
+        }
+
+        unsigned long long *tc = chaves_origem;
+        chaves_origem = chaves_destino;
+        chaves_destino = tc;
+        long unsigned int *ti = indices_origem;
+        indices_origem = indices_destino;
+        indices_destino = ti;
+    }
+
+    // Garante que o resultado final esteja no array do chamador
+    if (indices_origem != indices) {
+        memcpy(indices, indices_origem, n * sizeof(long unsigned int));
+    }
+
+    free(histograma);
+    free(chaves_a);
+    free(chaves_b);
+    free(indices_b);
+    return 0;
+}
+
+/**
+ * ordena_indices_por_chave - Extrai uma chave de cada processo e ordena os índices por ela.
+ * 
+ * @extrai: Função que converte o processo em uma chave sem sinal com a mesma ordem do campo.
+ */
+static int ordena_indices_por_chave(const Processo *processos, long unsigned int n, long unsigned int *indices,
+                                    Ordem ordem, unsigned long long (*extrai)(const Processo *)) {
+    long long medicao = metricas_inicio();
+    unsigned long long *chaves = malloc(n * sizeof(unsigned long long));
+    if (chaves == NULL) {
+        return -1;
+    }
+
+    for (long unsigned int i = 0; i < n; i++) {
+        chaves[i] = extrai(&processos[i]);
+    }
+    int resultado = radix_sort_indices(chaves, n, indices, ordem);
+
+    free(chaves);
+    metricas_registra(METRICA_ORDENACAO, medicao, n);
+    return resultado;
+}
+
+// Inteiros com sinal viram chaves sem sinal invertendo o bit de sinal
+static unsigned long long chave_id(const Processo *p) {
+    return (unsigned long long)((unsigned int)p->id ^ 0x80000000u);
+}
+
+static unsigned long long chave_data(const Processo *p) {
+    return (unsigned long long)p->timestamp ^ (1ULL << 63);
+}
+
+static unsigned long long chave_ano(const Processo *p) {
+    return (unsigned long long)((unsigned int)p->ano_eleicao ^ 0x80000000u);
+}
+
+/**
+ * ordena_indices_por_id - Ordena os índices dos processos pelo campo `id`.
+ * 
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @n: Tamanho do array.
+ * @indices: Array de `n` posições que receberá a permutação ordenada.
+ * @ordem: `ORDEM_CRESCENTE` ou `ORDEM_DECRESCENTE`.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int ordena_indices_por_id(const Processo *processos, long unsigned int n, long unsigned int *indices, Ordem ordem) {
+    return ordena_indices_por_chave(processos, n, indices, ordem, chave_id);
+}
+
+/**
+ * ordena_indices_por_data - Ordena os índices dos processos pela data de ajuizamento (`timestamp`).
+ * 
+ * Parâmetros e retorno como em `ordena_indices_por_id`.
+ */
+int ordena_indices_por_data(const Processo *processos, long unsigned int n, long unsigned int *indices, Ordem ordem) {
+    return ordena_indices_por_chave(processos, n, indices, ordem, chave_data);
+}
+
+/**
+ * ordena_indices_por_ano - Ordena os índices dos processos pelo campo `ano_eleicao`.
+ * 
+ * Parâmetros e retorno como em `ordena_indices_por_id`.
+ */
+int ordena_indices_por_ano(const Processo *processos, long unsigned int n, long unsigned int *indices, Ordem ordem) {
+    return ordena_indices_por_chave(processos, n, indices, ordem, chave_ano);
+}
+
+/**
+ * aplica_permutacao - Reorganiza o array de processos segundo uma permutação de índices.
+ * 
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @indices: Permutação produzida por uma das funções `ordena_indices_*`.
+ * @n: Tamanho do array.
+ * 
+ * Cada registro é copiado exatamente uma vez para um buffer temporário.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int aplica_permutacao(Processo *processos, const long unsigned int *indices, long unsigned int n) {
+    Processo *ordenados = malloc(n * sizeof(Processo));
+    if (ordenados == NULL) {
+        return -1;
+    }
+
+    for (long unsigned int i = 0; i < n; i++) {
+        ordenados[i] = processos[indices[i]];
+    }
+    memcpy(processos, ordenados, n * sizeof(Processo));
+
+    free(ordenados);
+    return 0;
+}
+
+// Comparador de processos usado pelo merge sort paralelo
+typedef int (*Comparador)(const Processo *, const Processo *);
+
+/**
+ * merge_ponteiros - Intercala de forma estável `a[0..na)` e `b[0..nb)` em `saida`.
+ * 
+ * Em caso de empate, o elemento de `a` vem primeiro.
+ */
+static void merge_ponteiros(const Processo **a, size_t na, const Processo **b, size_t nb,
+                            const Processo **saida, Comparador compara) {
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < na && j < nb) {
+        saida[k++] = compara(b[j], a[i]) < 0 ? b[j++] : a[i++];
+    }
+    while (i < na) {
+        saida[k++] = a[i++];
+    }
+    while (j < nb) {
+        saida[k++] = b[j++];
+    }
+}
+
+/**
+ * merge_sort_ponteiros - Merge sort estável de `v[0..n)`, usando `aux` como buffer de mesmo tamanho.
+ * 
+ * O resultado fica em `v`.
+ */
+static void merge_sort_ponteiros(const Processo **v, const Processo **aux, size_t n, Comparador compara) {
+    if (n <= LIMITE_INSERCAO) {
+        // Ordenação por inserção (estável)
+        for (size_t i = 1; i < n; i++) {
+            const Processo *atual = v[i];
+            size_t j = i;
+            while (j > 0 && compara(atual, v[j - 1]) < 0) {
+                v[j] = v[j - 1];
+                j--;
+            }
+            v[j] = atual;
+        }
+        return;
+    }
+
+    size_t meio = n / 2;
+    merge_sort_ponteiros(v, aux, meio, compara);
+    merge_sort_ponteiros(v + meio, aux + meio, n - meio, compara);
+
+    // Já estão em ordem: evita a intercalação
+    if (compara(v[meio], v[meio - 1]) >= 0) {
+        return;
+    }
+    merge_ponteiros(v, meio, v + meio, n - meio, aux, compara);
+    memcpy(v, aux, n * sizeof(const Processo *));
+}
+
+/**
+ * co_rank - Encontra quantos elementos de `a` estão entre os `k` primeiros da intercalação estável de `a` e `b`.
+ * 
+ * Permite dividir uma única intercalação em partes independentes, uma por thread.
+ */
+static size_t co_rank(size_t k, const Processo **a, size_t na, const Processo **b, size_t nb, Comparador compara) {
+    size_t inf = k > nb ? k - nb : 0;
+    size_t sup = k < na ? k : na;
+
+    while (inf < sup) {
+        size_t i = inf + (sup - inf) / 2;
+        size_t j = k - i;
+        // Se a[i] precede b[j-1], então `i` ainda é pequeno demais
+        if (j > 0 && i < na && compara(a[i], b[j - 1]) <= 0) {
+            inf = i + 1;
+        } else {
+            sup = i;
+        }
+    }
+    return inf;
+}
+
+// Tarefa executada por uma thread de `ordena_paralelo`
+typedef struct {
+    const Processo **origem;    // Ordenação: trecho a ordenar. Intercalação: início do par de blocos
+    const Processo **destino;   // Buffer auxiliar (ordenação) ou saída (intercalação)
+    size_t na;                  // Tamanho do trecho ou do bloco da esquerda
+    size_t nb;                  // Tamanho do bloco da direita (0 na ordenação)
+    size_t saida_inicio;        // Intervalo da saída da intercalação tratado por esta tarefa
+    size_t saida_fim;
+    Comparador compara;
+} TarefaOrdenacao;
+
+static void *thread_ordena_trecho(void *arg) {
+    TarefaOrdenacao *t = arg;
+    merge_sort_ponteiros(t->origem, t->destino, t->na, t->compara);
+    return NULL;
+}
+
+static void *thread_intercala(void *arg) {
+    TarefaOrdenacao *t = arg;
+    const Processo **a = t->origem;
+    const Processo **b = t->origem + t->na;
+    size_t ia = co_rank(t->saida_inicio, a, t->na, b, t->nb, t->compara);
+    size_t fa = co_rank(t->saida_fim, a, t->na, b, t->nb, t->compara);
+    size_t ib = t->saida_inicio - ia;
+    size_t fb = t->saida_fim - fa;
+
+    merge_ponteiros(a + ia, fa - ia, b + ib, fb - ib, t->destino + t->saida_inicio, t->compara);
+    return NULL;
+}
+
+/**
+ * ordena_paralelo - Ordena um vetor de processos com merge sort paralelo e estável.
+ * 
+ * @vetor: Ponteiro para o vetor de estruturas `Processo` que será ordenado.
+ * @n: Número de elementos (índices `size_t`, sem o limite de `int` do `quicksort`).
+ * @compara: Função de comparação com a mesma assinatura usada por `quicksort`.
+ * @num_threads: Número de threads; se menor ou igual a 0, usa o número de núcleos disponíveis.
+ * 
+ * A ordenação trabalha sobre um array de ponteiros para os registros: o vetor é dividido em
+ * `num_threads` trechos ordenados em paralelo e, em seguida, os trechos são intercalados dois a dois.
+ * Cada intercalação é dividida em partes iguais da saída (via `co_rank`) para que todas as threads
+ * trabalhem até a última rodada. Os registros são movidos uma única vez, no final.
+ * Como todas as etapas são estáveis, o resultado é idêntico ao de uma ordenação estável sequencial.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+int ordena_paralelo(Processo *vetor, size_t n, int (*compara)(const Processo *, const Processo *), int num_threads) {
+    if (n < 2) {
+        return 0;
+    }
+    long long medicao = metricas_inicio();
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_threads <= 0) {
+            num_threads = 1;
+        }
+    }
+    if ((size_t)num_threads > n / LIMITE_INSERCAO) {
+        num_threads = n / LIMITE_INSERCAO > 0 ? (int)(n / LIMITE_INSERCAO) : 1;
+    }
+
+    const Processo **ponteiros = malloc(n * sizeof(const Processo *));
+    const Processo **aux = malloc(n * sizeof(const Processo *));
+    size_t *limites = malloc(((size_t)num_threads + 1) * sizeof(size_t));
+    TarefaOrdenacao *tarefas = malloc((size_t)num_threads * 2 * sizeof(TarefaOrdenacao));
+    pthread_t *threads = malloc((size_t)num_threads * 2 * sizeof(pthread_t));
+    if (ponteiros == NULL || aux == NULL || limites == NULL || tarefas == NULL || threads == NULL) {
+        free(ponteiros);
+        free(aux);
+        free(limites);
+        free(tarefas);
+        free(threads);
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        ponteiros[i] = &vetor[i];
+    }
+
+    // 1. Ordena cada trecho em paralelo
+    int blocos = num_threads;
+    int criadas = 0;    // Se uma thread não puder ser criada, ela e as seguintes rodam na thread atual
+    for (int t = 0; t <= blocos; t++) {
+        limites[t] = n / (size_t)blocos * (size_t)t;
+    }
+    limites[blocos] = n;
+    for (int t = 0; t < blocos; t++) {
+        tarefas[t] = (TarefaOrdenacao) {
+            .origem = ponteiros + limites[t],
+            .destino = aux + limites[t],
+            .na = limites[t + 1] - limites[t],
+            .compara = compara
+        };
+        if (criadas == t && pthread_create(&threads[t], NULL, thread_ordena_trecho, &tarefas[t]) == 0) {
+            criadas++;
+        } else {
+            thread_ordena_trecho(&tarefas[t]);
+        }
+    }
+    for (int t = 0; t < criadas; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // 2. Intercala os blocos dois a dois até restar um único bloco
+    const Processo **origem = ponteiros;
+    const Processo **destino = aux;
+    while (blocos > 1) {
+        int pares = blocos / 2;
+        int partes = num_threads / pares > 0 ? num_threads / pares : 1;
+        int num_tarefas = 0;
+        criadas = 0;
+
+        for (int par = 0; par < pares; par++) {
+            size_t inicio = limites[2 * par];
+            size_t na = limites[2 * par + 1] - inicio;
+            size_t nb = limites[2 * par + 2] - limites[2 * par + 1];
+            size_t total = na + nb;
+
+            for (int parte = 0; parte < partes; parte++) {
+                TarefaOrdenacao *t = &tarefas[num_tarefas];
+                *t = (TarefaOrdenacao) {
+                    .origem = origem + inicio,
+                    .destino = destino + inicio,
+                    .na = na,
+                    .nb = nb,
+                    .saida_inicio = total / (size_t)partes * (size_t)parte,
+                    .saida_fim = parte == partes - 1 ? total : total / (size_t)partes * (size_t)(parte + 1),
+                    .compara = compara
+                };
+                if (criadas == num_tarefas && pthread_create(&threads[num_tarefas], NULL, thread_intercala, t) == 0) {
+                    criadas++;
+                } else {
+                    thread_intercala(t);
+                }
+                num_tarefas++;
+            }
+        }
+
+        // Um bloco ímpar no final é apenas copiado
+        if (blocos % 2 == 1) {
+            size_t inicio = limites[blocos - 1];
+            memcpy(destino + inicio, origem + inicio, (n - inicio) * sizeof(const Processo *));
+        }
+
+        for (int t = 0; t < criadas; t++) {
+            pthread_join(threads[t], NULL);
+        }
+
+        // Atualiza os limites dos blocos resultantes
+        for (int b = 0; b < pares; b++) {
+            limites[b] = limites[2 * b];
+        }
+        if (blocos % 2 == 1) {
+            limites[pares] = limites[blocos - 1];
+        }
+        blocos = pares + blocos % 2;
+        limites[blocos] = n;
+
+        const Processo **tmp = origem;
+        origem = destino;
+        destino = tmp;
+    }
+
+    // 3. Move os registros para a ordem final
+    Processo *ordenados = malloc(n * sizeof(Processo));
+    if (ordenados == NULL) {
+        free(ponteiros);
+        free(aux);
+        free(limites);
+        free(tarefas);
+        free(threads);
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        ordenados[i] = *origem[i];
+    }
+    memcpy(vetor, ordenados, n * sizeof(Processo));
+
+    free(ordenados);
+    free(ponteiros);
+    free(aux);
+    free(limites);
+    free(tarefas);
+    free(threads);
+    metricas_registra(METRICA_ORDENACAO, medicao, n);
+    return 0;
+}
+
+// Heap limitado usado por `top_k`: a raiz é o pior dos K melhores registros vistos até agora
+typedef struct {
+    const Processo *processos;
+    long unsigned int *indices;
+    long unsigned int tamanho;
+    Comparador compara;
+} HeapTopK;
+
+/**
+ * antes - Ordem total usada por `top_k`: `compara` e, nos empates, o menor índice.
+ * 
+ * O desempate pelo índice faz o resultado coincidir com o início de uma ordenação estável.
+ */
+static int antes(const HeapTopK *heap, long unsigned int a, long unsigned int b) {
+    int c = heap->compara(&heap->processos[a], &heap->processos[b]);
+    return c < 0 || (c == 0 && a < b);
+}
+
+static void heap_top_k_sobe(HeapTopK *heap, long unsigned int pos) {
+    long unsigned int *v = heap->indices;
+    while (pos > 0) {
+        long unsigned int pai = (pos - 1) / 2;
+        if (!antes(heap, v[pai], v[pos])) {
+            return;
+        }
+        long unsigned int tmp = v[pai];
+        v[pai] = v[pos];
+        v[pos] = tmp;
+        pos = pai;
+    }
+}
+
+static void heap_top_k_desce(HeapTopK *heap, long unsigned int pos, long unsigned int tamanho) {
+    long unsigned int *v = heap->indices;
+    for (;;) {
+        long unsigned int pior = pos;
+        long unsigned int esq = 2 * pos + 1;
+        long unsigned int dir = esq + 1;
+        if (esq < tamanho && antes(heap, v[pior], v[esq])) {
+            pior = esq;
+        }
+        if (dir < tamanho && antes(heap, v[pior], v[dir])) {
+            pior = dir;
+        }
+        if (pior == pos) {
+            return;
+        }
+        long unsigned int tmp = v[pior];
+        v[pior] = v[pos];
+        v[pos] = tmp;
+        pos = pior;
+    }
+}
+
+/**
+ * seleciona_top_k - Mantém em `heap` os K melhores registros de [`inicio`, `fim`).
+ */
+static void seleciona_top_k(HeapTopK *heap, long unsigned int k, long unsigned int inicio, long unsigned int fim) {
+    for (long unsigned int i = inicio; i < fim; i++) {
+        if (heap->tamanho < k) {
+            heap->indices[heap->tamanho] = i;
+            heap_top_k_sobe(heap, heap->tamanho++);
+        } else if (antes(heap, i, heap->indices[0])) {
+            heap->indices[0] = i;
+            heap_top_k_desce(heap, 0, heap->tamanho);
+        }
+    }
+}
+
+/**
+ * ordena_heap_top_k - Transforma o heap em um array do melhor para o pior (heapsort in-place).
+ */
+static void ordena_heap_top_k(HeapTopK *heap) {
+    for (long unsigned int fim = heap->tamanho; fim > 1; fim--) {
+        long unsigned int tmp = heap->indices[0];
+        heap->indices[0] = heap->indices[fim - 1];
+        heap->indices[fim - 1] = tmp;
+        heap_top_k_desce(heap, 0, fim - 1);
+    }
+}
+
+/**
+ * top_k - Seleciona os K primeiros registros segundo `compara`, sem ordenar a base inteira.
+ * 
+ * @processos: Array de processos; não é modificado.
+ * @n: Número de processos.
+ * @k: Quantidade de registros desejada.
+ * @compara: Função de comparação com a mesma assinatura usada por `quicksort`
+ *           (por exemplo, `compara_data` para os mais recentes).
+ * @indices: Array de pelo menos `k` posições que receberá os índices selecionados, em ordem.
+ * 
+ * Percorre a base uma vez mantendo um heap limitado a K elementos cuja raiz é o pior deles:
+ * cada registro só entra se for melhor que a raiz. O custo é O(n log K) comparações e nenhuma
+ * memória além de `indices`. Empates são resolvidos pelo índice, de modo que o resultado é
+ * igual aos K primeiros de uma ordenação estável.
+ * 
+ * Retorna o número de índices escritos (o menor entre `k` e `n`).
+ */
+long unsigned int top_k(const Processo *processos, long unsigned int n, long unsigned int k,
+                        int (*compara)(const Processo *, const Processo *), long unsigned int *indices) {
+    HeapTopK heap = {processos, indices, 0, compara};
+
+    if (k == 0) {
+        return 0;
+    }
+    seleciona_top_k(&heap, k, 0, n);
+    ordena_heap_top_k(&heap);
+    return heap.tamanho;
+}
+
+// Trecho da base processado por uma thread de `top_k_paralelo`
+typedef struct {
+    HeapTopK heap;
+    long unsigned int k;
+    long unsigned int inicio;
+    long unsigned int fim;
+} TarefaTopK;
+
+static void *thread_top_k(void *arg) {
+    TarefaTopK *tarefa = arg;
+    seleciona_top_k(&tarefa->heap, tarefa->k, tarefa->inicio, tarefa->fim);
+    ordena_heap_top_k(&tarefa->heap);
+    return NULL;
+}
+
+/**
+ * top_k_paralelo - Versão de `top_k` que divide a base entre threads.
+ * 
+ * @num_threads: Número de threads; se menor ou igual a 0, usa o número de núcleos disponíveis.
+ * 
+ * Cada thread mantém o próprio heap de K elementos sobre um trecho contíguo da base; as listas
+ * ordenadas resultantes são intercaladas até K elementos, com o mesmo desempate por índice.
+ * O resultado é idêntico ao de `top_k`. Usa O(K * num_threads) de memória auxiliar.
+ * 
+ * Retorna o número de índices escritos ou 0 se não houver memória.
+ */
+long unsigned int top_k_paralelo(const Processo *processos, long unsigned int n, long unsigned int k,
+                                 int (*compara)(const Processo *, const Processo *), long unsigned int *indices,
+                                 int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_threads <= 0) {
+            num_threads = 1;
+        }
+    }
+    if (k > n) {
+        k = n;
+    }
+    // Trechos menores que K não compensam uma thread
+    if (num_threads == 1 || k == 0 || n / (long unsigned int)num_threads < k) {
+        return top_k(processos, n, k, compara, indices);
+    }
+
+    TarefaTopK *tarefas = malloc((size_t)num_threads * sizeof(TarefaTopK));
+    pthread_t *threads = malloc((size_t)num_threads * sizeof(pthread_t));
+    long unsigned int *candidatos = malloc((size_t)num_threads * k * sizeof(long unsigned int));
+    long unsigned int *posicao = calloc((size_t)num_threads, sizeof(long unsigned int));
+    if (tarefas == NULL || threads == NULL || candidatos == NULL || posicao == NULL) {
+        free(tarefas);
+        free(threads);
+        free(candidatos);
+        free(posicao);
+        return 0;
+    }
+
+    int criadas = 0;    // Se uma thread não puder ser criada, ela e as seguintes rodam na thread atual
+    for (int t = 0; t < num_threads; t++) {
+        tarefas[t] = (TarefaTopK) {
+            .heap = {processos, candidatos + (size_t)t * k, 0, compara},
+            .k = k,
+            .inicio = n / (long unsigned int)num_threads * (long unsigned int)t,
+            .fim = t == num_threads - 1 ? n : n / (long unsigned int)num_threads * (long unsigned int)(t + 1)
+        };
+        if (criadas == t && pthread_create(&threads[t], NULL, thread_top_k, &tarefas[t]) == 0) {
+            criadas++;
+        } else {
+            thread_top_k(&tarefas[t]);
+        }
+    }
+    for (int t = 0; t < criadas; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // Intercala as listas ordenadas de cada thread até obter K elementos
+    const HeapTopK *ordem = &tarefas[0].heap;
+    for (long unsigned int i = 0; i < k; i++) {
+        int melhor = -1;
+        for (int t = 0; t < num_threads; t++) {
+            if (posicao[t] < tarefas[t].heap.tamanho &&
+                (melhor < 0 || antes(ordem, tarefas[t].heap.indices[posicao[t]],
+                                     tarefas[melhor].heap.indices[posicao[melhor]]))) {
+                melhor = t;
+            }
+        }
+        indices[i] = tarefas[melhor].heap.indices[posicao[melhor]++];
+    }
+
+    free(tarefas);
+    free(threads);
+    free(candidatos);
+    free(posicao);
+    return k;
+}
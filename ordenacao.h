@@ -0,0 +1,23 @@
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+#include "processo.h"
+
+// Sentido da ordenação
+typedef enum {
+    ORDEM_CRESCENTE = 0,
+    ORDEM_DECRESCENTE = 1
+} Ordem;
+
+int radix_sort_indices(const unsigned long long *chaves, long unsigned int n, long unsigned int *indices, Ordem ordem);
+int ordena_indices_por_id(const Processo *processos, long unsigned int n, long unsigned int *indices, Ordem ordem);
+int ordena_indices_por_data(const Processo *processos, long unsigned int n, long unsigned int *indices, Ordem ordem);
+int ordena_indices_por_ano(const Processo *processos, long unsigned int n, long unsigned int *indices, Ordem ordem);
+int aplica_permutacao(Processo *processos, const long unsigned int *indices, long unsigned int n);
+int ordena_paralelo(Processo *vetor, size_t n, int (*compara)(const Processo *, const Processo *), int num_threads);
+long unsigned int top_k(const Processo *processos, long unsigned int n, long unsigned int k,
+                        int (*compara)(const Processo *, const Processo *), long unsigned int *indices);
+long unsigned int top_k_paralelo(const Processo *processos, long unsigned int n, long unsigned int k,
+                                 int (*compara)(const Processo *, const Processo *), long unsigned int *indices,
+                                 int num_threads);
+#endif
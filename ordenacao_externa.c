@@ -0,0 +1,584 @@
+#include "ordenacao_externa.h"
+#include "ordenacao.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Limites do buffer de cada arquivo lido ou escrito
+#define BUFFER_MINIMO ((size_t)64 << 10)
+#define BUFFER_MAXIMO ((size_t)1 << 20)
+
+// Leitor de linhas sobre um descritor, com buffer próprio
+typedef struct {
+    int fd;
+    char *buffer;
+    size_t capacidade;
+    size_t inicio;      // Início da próxima linha
+    size_t fim;         // Bytes válidos no buffer
+    int eof;
+} LeitorLinhas;
+
+// Escritor com buffer sobre um descritor
+typedef struct {
+    int fd;
+    char *buffer;
+    size_t capacidade;
+    size_t usado;
+    long unsigned int bytes;    // Total de bytes escritos
+    int erro;
+} EscritorBuffer;
+
+// Conjunto de corridas (descritores de arquivos temporários já removidos do diretório)
+typedef struct {
+    int *fds;
+    int quantidade;
+    int capacidade;
+} Corridas;
+
+static size_t limita_buffer(size_t tamanho) {
+    return tamanho < BUFFER_MINIMO ? BUFFER_MINIMO : tamanho > BUFFER_MAXIMO ? BUFFER_MAXIMO : tamanho;
+}
+
+static int leitor_inicializa(LeitorLinhas *leitor, int fd, size_t capacidade) {
+    leitor->fd = fd;
+    leitor->buffer = malloc(capacidade);
+    leitor->capacidade = capacidade;
+    leitor->inicio = 0;
+    leitor->fim = 0;
+    leitor->eof = 0;
+    return leitor->buffer != NULL ? 0 : -1;
+}
+
+/**
+ * leitor_proxima - Obtém a próxima linha, sem o '\n'.
+ * 
+ * A linha devolvida em [`*linha`, `*fim_linha`) é válida até a próxima chamada.
+ * 
+ * Retorna 1 se uma linha foi obtida, 0 no fim do arquivo ou -1 em caso de erro.
+ */
+static int leitor_proxima(LeitorLinhas *leitor, const char **linha, const char **fim_linha) {
+    for (;;) {
+        char *inicio = leitor->buffer + leitor->inicio;
+        char *nl = memchr(inicio, '\n', leitor->fim - leitor->inicio);
+        if (nl != NULL || (leitor->eof && leitor->inicio < leitor->fim)) {
+            *linha = inicio;
+            *fim_linha = nl != NULL ? nl : leitor->buffer + leitor->fim;
+            leitor->inicio = nl != NULL ? (size_t)(nl - leitor->buffer) + 1 : leitor->fim;
+            return 1;
+        }
+        if (leitor->eof) {
+            return 0;
+        }
+
+        // Move a linha incompleta para o início e completa o buffer
+        size_t resto = leitor->fim - leitor->inicio;
+        memmove(leitor->buffer, inicio, resto);
+        leitor->inicio = 0;
+        leitor->fim = resto;
+        if (leitor->fim == leitor->capacidade) {
+            char *maior = realloc(leitor->buffer, leitor->capacidade * 2);
+            if (maior == NULL) {
+                return -1;
+            }
+            leitor->buffer = maior;
+            leitor->capacidade *= 2;
+        }
+
+        ssize_t lido = read(leitor->fd, leitor->buffer + leitor->fim, leitor->capacidade - leitor->fim);
+        if (lido < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (lido == 0) {
+            leitor->eof = 1;
+        }
+        leitor->fim += (size_t)lido;
+    }
+}
+
+static int escritor_inicializa(EscritorBuffer *escritor, int fd, size_t capacidade) {
+    escritor->fd = fd;
+    escritor->buffer = malloc(capacidade);
+    escritor->capacidade = capacidade;
+    escritor->usado = 0;
+    escritor->bytes = 0;
+    escritor->erro = escritor->buffer == NULL;
+    return escritor->erro ? -1 : 0;
+}
+
+static void escritor_descarrega(EscritorBuffer *escritor) {
+    if (!escritor->erro && escritor->usado > 0) {
+        escritor->erro = escreve_tudo(escritor->fd, escritor->buffer, escritor->usado) != 0;
+    }
+    escritor->bytes += escritor->usado;
+    escritor->usado = 0;
+}
+
+/**
+ * escritor_linha - Acrescenta [`inicio`, `fim`) seguido de '\n'.
+ */
+static void escritor_linha(EscritorBuffer *escritor, const char *inicio, const char *fim) {
+    size_t tamanho = (size_t)(fim - inicio);
+    if (escritor->usado + tamanho + 1 > escritor->capacidade) {
+        escritor_descarrega(escritor);
+        if (tamanho + 1 > escritor->capacidade) {
+            escritor->erro |= escreve_tudo(escritor->fd, inicio, tamanho) != 0 ||
+                              escreve_tudo(escritor->fd, "\n", 1) != 0;
+            escritor->bytes += tamanho + 1;
+            return;
+        }
+    }
+    memcpy(escritor->buffer + escritor->usado, inicio, tamanho);
+    escritor->usado += tamanho;
+    escritor->buffer[escritor->usado++] = '\n';
+}
+
+/**
+ * escritor_registro - Acrescenta um processo no formato de `export_csv`.
+ */
+static void escritor_registro(EscritorBuffer *escritor, const Processo *processo) {
+    if (escritor->usado + MAX_LINHA_CSV > escritor->capacidade) {
+        escritor_descarrega(escritor);
+    }
+    char *fim = formata_registro_csv(escritor->buffer + escritor->usado, processo);
+    escritor->usado = (size_t)(fim - escritor->buffer);
+}
+
+/**
+ * cria_temporario - Cria um arquivo temporário em `diretorio` e o remove do diretório.
+ * 
+ * O arquivo continua acessível pelo descritor e desaparece quando ele é fechado,
+ * mesmo que o programa seja interrompido.
+ * 
+ * Retorna o descritor ou -1 em caso de erro.
+ */
+static int cria_temporario(const char *diretorio) {
+    char nome[4096];
+    snprintf(nome, sizeof(nome), "%s/ordena_XXXXXX", diretorio);
+    int fd = mkstemp(nome);
+    if (fd != -1) {
+        unlink(nome);
+    }
+    return fd;
+}
+
+static int corridas_adiciona(Corridas *corridas, int fd) {
+    if (corridas->quantidade == corridas->capacidade) {
+        int capacidade = corridas->capacidade > 0 ? corridas->capacidade * 2 : 16;
+        int *maior = realloc(corridas->fds, (size_t)capacidade * sizeof(int));
+        if (maior == NULL) {
+            return -1;
+        }
+        corridas->fds = maior;
+        corridas->capacidade = capacidade;
+    }
+    corridas->fds[corridas->quantidade++] = fd;
+    return 0;
+}
+
+static void corridas_fecha(Corridas *corridas) {
+    for (int i = 0; i < corridas->quantidade; i++) {
+        close(corridas->fds[i]);
+    }
+    free(corridas->fds);
+    corridas->fds = NULL;
+    corridas->quantidade = 0;
+    corridas->capacidade = 0;
+}
+
+/**
+ * grava_corrida - Ordena os registros carregados e os grava em um novo arquivo temporário.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int grava_corrida(Processo *vetor, long unsigned int n, int (*compara)(const Processo *, const Processo *),
+                         const char *diretorio, size_t tamanho_buffer, Corridas *corridas,
+                         EstatisticasOrdenacaoExterna *stats) {
+    if (ordena_paralelo(vetor, n, compara, 0) != 0) {
+        return -1;
+    }
+
+    int fd = cria_temporario(diretorio);
+    if (fd == -1) {
+        printf("Erro ao criar arquivo temporário em %s.\n", diretorio);
+        return -1;
+    }
+
+    EscritorBuffer escritor;
+    escritor_inicializa(&escritor, fd, tamanho_buffer);
+    for (long unsigned int i = 0; i < n && !escritor.erro; i++) {
+        escritor_registro(&escritor, &vetor[i]);
+    }
+    escritor_descarrega(&escritor);
+    free(escritor.buffer);
+    stats->bytes_temporarios += escritor.bytes;
+
+    if (escritor.erro || corridas_adiciona(corridas, fd) != 0) {
+        close(fd);
+        return -1;
+    }
+    stats->corridas++;
+    return 0;
+}
+
+/**
+ * gera_corridas - Lê a entrada em trechos que cabem no orçamento e grava cada um ordenado.
+ * 
+ * O custo de cada trecho é contado como o vetor de registros, os dois arrays de ponteiros e a
+ * cópia dos registros usados por `ordena_paralelo` e os blocos da arena com as listas de
+ * classe/assunto e as datas.
+ * O trecho termina quando o próximo crescimento do vetor ou o próximo bloco da arena
+ * ultrapassaria a memória disponível.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int gera_corridas(int fd_entrada, int (*compara)(const Processo *, const Processo *), size_t orcamento,
+                         const char *diretorio, Corridas *corridas, EstatisticasOrdenacaoExterna *stats) {
+    const size_t custo_registro = 2 * sizeof(Processo) + 2 * sizeof(Processo *);
+    size_t tamanho_buffer = limita_buffer(orcamento / 16);
+    size_t disponivel = orcamento - 2 * tamanho_buffer;
+    size_t bloco_arena = limita_buffer(disponivel / 16);
+
+    LeitorLinhas leitor;
+    long unsigned int capacidade = 1024;
+    Processo *vetor = malloc(capacidade * sizeof(Processo));
+    if (leitor_inicializa(&leitor, fd_entrada, tamanho_buffer) != 0 || vetor == NULL) {
+        free(leitor.buffer);
+        free(vetor);
+        return -1;
+    }
+
+    Arena arena;
+    arena_inicializa(&arena, bloco_arena);
+    long unsigned int n = 0;
+    int erro = 0;
+    int cabecalho = 1;
+    const char *linha;
+    const char *fim_linha;
+    int status;
+
+    while (!erro && (status = leitor_proxima(&leitor, &linha, &fim_linha)) == 1) {
+        if (cabecalho) {
+            cabecalho = 0;
+            continue;
+        }
+        if (parse_registro(linha, fim_linha, &vetor[n], &arena) != 6) {
+            continue;
+        }
+        n++;
+
+        int cheio = arena.bytes_reservados + bloco_arena + capacidade * custo_registro > disponivel;
+        if (!cheio && n == capacidade) {
+            // Só cresce o vetor se o dobro ainda couber no orçamento
+            if (arena.bytes_reservados + 2 * capacidade * custo_registro > disponivel) {
+                cheio = 1;
+            } else {
+                Processo *maior = realloc(vetor, 2 * capacidade * sizeof(Processo));
+                if (maior == NULL) {
+                    erro = 1;
+                    break;
+                }
+                vetor = maior;
+                capacidade *= 2;
+            }
+        }
+        if (cheio) {
+            erro = grava_corrida(vetor, n, compara, diretorio, tamanho_buffer, corridas, stats) != 0;
+            n = 0;
+            arena_libera(&arena);
+            arena_inicializa(&arena, bloco_arena);
+        }
+    }
+    if (status < 0) {
+        printf("Erro ao ler o arquivo de entrada.\n");
+        erro = 1;
+    }
+    if (!erro && n > 0) {
+        erro = grava_corrida(vetor, n, compara, diretorio, tamanho_buffer, corridas, stats) != 0;
+    }
+
+    arena_libera(&arena);
+    free(vetor);
+    free(leitor.buffer);
+    return erro ? -1 : 0;
+}
+
+// Estado da intercalação de k corridas
+typedef struct {
+    LeitorLinhas *leitores;
+    Processo *atual;            // Registro corrente de cada corrida
+    const char **linha;         // Linha do registro corrente (válida até a próxima leitura)
+    const char **fim_linha;
+    int *heap;                  // Heap mínimo de índices de corrida
+    int tamanho_heap;
+    int (*compara)(const Processo *, const Processo *);
+} Intercalacao;
+
+/**
+ * libera_campos - Libera os campos de um registro analisado sem arena (inclusive o número em texto).
+ */
+static void libera_campos(Processo *processo) {
+    free(processo->classe);
+    free(processo->assunto);
+    free(processo->data);
+    if (processo->numero.prefixo == NUMERO_TEXTO) {
+        free((char *)processo->numero.texto);
+    }
+}
+
+/**
+ * avanca - Carrega o próximo registro válido da corrida `i`.
+ * 
+ * Retorna 1 se há um registro, 0 se a corrida acabou ou -1 em caso de erro.
+ */
+static int avanca(Intercalacao *intercalacao, int i) {
+    int status;
+    while ((status = leitor_proxima(&intercalacao->leitores[i], &intercalacao->linha[i],
+                                    &intercalacao->fim_linha[i])) == 1) {
+        if (parse_registro(intercalacao->linha[i], intercalacao->fim_linha[i], &intercalacao->atual[i], NULL) == 6) {
+            return 1;
+        }
+    }
+    return status;
+}
+
+/**
+ * precede - Indica se a corrida `a` deve sair antes da corrida `b`.
+ * 
+ * Empates favorecem a corrida anterior, o que mantém a ordenação estável.
+ */
+static int precede(const Intercalacao *intercalacao, int a, int b) {
+    int c = intercalacao->compara(&intercalacao->atual[a], &intercalacao->atual[b]);
+    return c < 0 || (c == 0 && a < b);
+}
+
+static void desce(Intercalacao *intercalacao, int pos) {
+    int *heap = intercalacao->heap;
+    for (;;) {
+        int menor = pos;
+        int esq = 2 * pos + 1;
+        int dir = esq + 1;
+        if (esq < intercalacao->tamanho_heap && precede(intercalacao, heap[esq], heap[menor])) {
+            menor = esq;
+        }
+        if (dir < intercalacao->tamanho_heap && precede(intercalacao, heap[dir], heap[menor])) {
+            menor = dir;
+        }
+        if (menor == pos) {
+            return;
+        }
+        int tmp = heap[pos];
+        heap[pos] = heap[menor];
+        heap[menor] = tmp;
+        pos = menor;
+    }
+}
+
+/**
+ * intercala - Intercala `k` corridas ordenadas no descritor `fd_saida`.
+ * 
+ * @fds: Descritores das corridas (relidos desde o início).
+ * @k: Número de corridas.
+ * @fd_saida: Descritor de destino.
+ * @cabecalho: Texto escrito antes dos registros (pode ser NULL).
+ * @tamanho_buffer: Tamanho do buffer de cada corrida e da saída.
+ * @compara: Função de comparação usada nas corridas.
+ * @registros: Recebe o número de registros escritos.
+ * @bytes: Recebe o número de bytes escritos.
+ * 
+ * As linhas das corridas já estão no formato exportado e são copiadas sem reformatação;
+ * cada uma é analisada apenas para que `compara` possa ser aplicada.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int intercala(const int *fds, int k, int fd_saida, const char *cabecalho, size_t tamanho_buffer,
+                     int (*compara)(const Processo *, const Processo *), long unsigned int *registros,
+                     long unsigned int *bytes) {
+    Intercalacao intercalacao;
+    intercalacao.leitores = calloc((size_t)k + 1, sizeof(LeitorLinhas));
+    intercalacao.atual = calloc((size_t)k + 1, sizeof(Processo));
+    intercalacao.linha = calloc((size_t)k + 1, sizeof(const char *));
+    intercalacao.fim_linha = calloc((size_t)k + 1, sizeof(const char *));
+    intercalacao.heap = malloc(((size_t)k + 1) * sizeof(int));
+    intercalacao.tamanho_heap = 0;
+    intercalacao.compara = compara;
+
+    EscritorBuffer escritor;
+    int erro = escritor_inicializa(&escritor, fd_saida, tamanho_buffer) != 0 || intercalacao.leitores == NULL ||
+               intercalacao.atual == NULL || intercalacao.linha == NULL || intercalacao.fim_linha == NULL ||
+               intercalacao.heap == NULL;
+
+    for (int i = 0; i < k && !erro; i++) {
+        erro = lseek(fds[i], 0, SEEK_SET) == -1 || leitor_inicializa(&intercalacao.leitores[i], fds[i],
+                                                                     tamanho_buffer) != 0;
+        int status = erro ? -1 : avanca(&intercalacao, i);
+        erro = status < 0;
+        if (status == 1) {
+            intercalacao.heap[intercalacao.tamanho_heap++] = i;
+        }
+    }
+    for (int pos = intercalacao.tamanho_heap / 2 - 1; pos >= 0 && !erro; pos--) {
+        desce(&intercalacao, pos);
+    }
+
+    if (cabecalho != NULL && !erro) {
+        escritor_linha(&escritor, cabecalho, cabecalho + strlen(cabecalho) - 1);
+    }
+
+    long unsigned int escritos = 0;
+    while (intercalacao.tamanho_heap > 0 && !erro && !escritor.erro) {
+        int i = intercalacao.heap[0];
+        escritor_linha(&escritor, intercalacao.linha[i], intercalacao.fim_linha[i]);
+        libera_campos(&intercalacao.atual[i]);
+        escritos++;
+
+        int status = avanca(&intercalacao, i);
+        if (status < 0) {
+            erro = 1;
+            break;
+        }
+        if (status == 0) {
+            intercalacao.heap[0] = intercalacao.heap[--intercalacao.tamanho_heap];
+        }
+        desce(&intercalacao, 0);
+    }
+    escritor_descarrega(&escritor);
+    erro |= escritor.erro;
+
+    // Registros que ficaram no heap após um erro
+    for (int j = 0; j < intercalacao.tamanho_heap; j++) {
+        libera_campos(&intercalacao.atual[intercalacao.heap[j]]);
+    }
+    for (int i = 0; i < k && intercalacao.leitores != NULL; i++) {
+        free(intercalacao.leitores[i].buffer);
+    }
+    free(intercalacao.leitores);
+    free(intercalacao.atual);
+    free(intercalacao.linha);
+    free(intercalacao.fim_linha);
+    free(intercalacao.heap);
+    free(escritor.buffer);
+
+    *registros = escritos;
+    *bytes = escritor.bytes;
+    return erro ? -1 : 0;
+}
+
+/**
+ * ordena_externo - Ordena um CSV maior que a memória e grava o resultado no formato de `export_csv`.
+ * 
+ * @entrada: CSV de entrada (mesmo formato aceito por `read_csv`).
+ * @saida: Arquivo ordenado a ser criado.
+ * @compara: Função de comparação, com a mesma assinatura de `compara_id` e `compara_data`.
+ * @orcamento: Memória máxima, em bytes, para registros e buffers; valores abaixo de `ORCAMENTO_MINIMO`
+ *             são elevados a ele.
+ * @dir_temporario: Diretório das corridas temporárias; se NULL, usa o diretório atual.
+ * @stats: Estrutura que receberá as estatísticas (pode ser NULL).
+ * 
+ * A entrada é lida em trechos que cabem no orçamento; cada trecho é ordenado com `ordena_paralelo`
+ * e gravado em um arquivo temporário (uma corrida). As corridas são então intercaladas com um heap
+ * de k vias. Se houver mais de `MAX_VIAS_INTERCALACAO` corridas (ou mais do que o orçamento comporta
+ * de buffers), elas são intercaladas em grupos, em passagens sucessivas, até restar uma intercalação
+ * final. A ordenação é estável: registros equivalentes saem na ordem da entrada.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+int ordena_externo(const char *entrada, const char *saida, int (*compara)(const Processo *, const Processo *),
+                   long unsigned int orcamento, const char *dir_temporario, EstatisticasOrdenacaoExterna *stats) {
+    EstatisticasOrdenacaoExterna local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(EstatisticasOrdenacaoExterna));
+    if (orcamento < ORCAMENTO_MINIMO) {
+        orcamento = ORCAMENTO_MINIMO;
+    }
+    if (dir_temporario == NULL) {
+        dir_temporario = ".";
+    }
+
+    int fd_entrada = open(entrada, O_RDONLY);
+    if (fd_entrada == -1) {
+        printf("Erro ao abrir o arquivo.\n");
+        return -1;
+    }
+
+    double inicio = agora_segundos();
+    Corridas corridas = {NULL, 0, 0};
+    int erro = gera_corridas(fd_entrada, compara, orcamento, dir_temporario, &corridas, stats) != 0;
+    close(fd_entrada);
+    stats->segundos_corridas = agora_segundos() - inicio;
+
+    // Cada via precisa de um buffer, além do buffer de saída
+    int vias = (int)(orcamento / BUFFER_MINIMO) - 1;
+    if (vias > MAX_VIAS_INTERCALACAO) {
+        vias = MAX_VIAS_INTERCALACAO;
+    }
+    if (vias < 2) {
+        vias = 2;
+    }
+
+    inicio = agora_segundos();
+    long unsigned int registros;
+    long unsigned int bytes;
+
+    // Passagens intermediárias: intercala grupos de `vias` corridas em corridas maiores
+    while (!erro && corridas.quantidade > vias) {
+        Corridas proximas = {NULL, 0, 0};
+        size_t tamanho_buffer = limita_buffer(orcamento / (size_t)(vias + 1));
+
+        for (int g = 0; g < corridas.quantidade && !erro; g += vias) {
+            int k = corridas.quantidade - g < vias ? corridas.quantidade - g : vias;
+            int fd = k > 1 ? cria_temporario(dir_temporario) : corridas.fds[g];
+            erro = fd == -1;
+            if (!erro && k > 1) {
+                erro = intercala(&corridas.fds[g], k, fd, NULL, tamanho_buffer, compara, &registros, &bytes) != 0;
+                stats->bytes_temporarios += bytes;
+                for (int i = g; i < g + k; i++) {
+                    close(corridas.fds[i]);
+                    corridas.fds[i] = -1;
+                }
+            } else if (!erro) {
+                corridas.fds[g] = -1;
+            }
+            if (fd != -1 && (erro || corridas_adiciona(&proximas, fd) != 0)) {
+                close(fd);
+                erro = 1;
+            }
+        }
+
+        // Fecha apenas os descritores que não foram repassados
+        for (int i = 0; i < corridas.quantidade; i++) {
+            if (corridas.fds[i] != -1) {
+                close(corridas.fds[i]);
+            }
+        }
+        free(corridas.fds);
+        corridas = proximas;
+        stats->passagens++;
+    }
+
+    if (!erro) {
+        int fd_saida = open(saida, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (fd_saida == -1) {
+            printf("Erro ao abrir o arquivo para escrita.\n");
+            erro = 1;
+        } else {
+            size_t tamanho_buffer = limita_buffer(orcamento / (size_t)(corridas.quantidade + 1));
+            erro = intercala(corridas.fds, corridas.quantidade, fd_saida, CABECALHO_CSV, tamanho_buffer, compara,
+                             &stats->registros, &bytes) != 0;
+            erro |= close(fd_saida) != 0;
+            stats->passagens++;
+            if (erro) {
+                printf("Erro ao escrever o arquivo %s.\n", saida);
+            }
+        }
+    }
+    stats->segundos_intercalacao = agora_segundos() - inicio;
+
+    corridas_fecha(&corridas);
+    return erro ? -1 : 0;
+}
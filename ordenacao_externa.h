@@ -0,0 +1,24 @@
+#ifndef ORDENACAO_EXTERNA_H
+#define ORDENACAO_EXTERNA_H
+
+#include "processo.h"
+
+// Menor orçamento de memória aceito por `ordena_externo` (1 MB)
+#define ORCAMENTO_MINIMO ((long unsigned int)1 << 20)
+
+// Número máximo de corridas intercaladas de uma só vez
+#define MAX_VIAS_INTERCALACAO 64
+
+// Estatísticas coletadas durante a ordenação externa
+typedef struct {
+    long unsigned int registros;            // Registros escritos na saída
+    long unsigned int corridas;             // Corridas ordenadas geradas a partir da entrada
+    int passagens;                          // Passagens de intercalação (incluindo a final)
+    long unsigned int bytes_temporarios;    // Bytes escritos em arquivos temporários
+    double segundos_corridas;               // Tempo de leitura, ordenação e escrita das corridas
+    double segundos_intercalacao;           // Tempo das intercalações
+} EstatisticasOrdenacaoExterna;
+
+int ordena_externo(const char *entrada, const char *saida, int (*compara)(const Processo *, const Processo *),
+                   long unsigned int orcamento, const char *dir_temporario, EstatisticasOrdenacaoExterna *stats);
+#endif
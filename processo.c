@@ -1,4 +1,31 @@
 #include "processo.h"
+#include "conjunto.h"
+#include "metricas.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * aloca - Reserva memória na arena ou, se `arena` for NULL, com `malloc`.
+ */
+static void *aloca(Arena *arena, size_t tamanho) {
+    return arena != NULL ? arena_aloca(arena, tamanho) : malloc(tamanho);
+}
+
+/**
+ * timestamp_de_data - Converte a data analisada do CSV em milissegundos desde 1970-01-01 (UTC).
+ * 
+ * @data: Data com os campos no formato do arquivo (ano completo e mês de 1 a 12).
+ * @milissegundos: Fração de segundo informada após o ponto.
+ */
+static long long timestamp_de_data(const struct tm *data, int milissegundos) {
+    return data_para_epoch(data->tm_year, data->tm_mon, data->tm_mday,
+                           data->tm_hour, data->tm_min, data->tm_sec) * 1000 + milissegundos;
+}
 
 /**
  * parse_itens - Analisa uma string de processos separados por vírgulas e converte os valores em inteiros.
@@ -6,17 +33,21 @@
  * @processos: String contendo os processos separados por vírgulas.
  * @items: Ponteiro para um array de inteiros que será alocado dinamicamente e preenchido com os valores convertidos.
  * @item_count: Ponteiro para um inteiro que armazenará a quantidade de itens analisados.
+ * @arena: Arena onde o array será alocado; se NULL, o array é alocado com `malloc`.
  * 
  * Retorna o número de itens analisados.
  */
-int parse_itens(char *processos, int** items, int *item_count) {
+int parse_itens(char *processos, int** items, int *item_count, Arena *arena) {
     int parsed = 0;
 
     // Cria uma cópia da string de entrada para evitar modificar o original
-    char *processos_copy = malloc(strlen(processos) + 1);
-    strcpy(processos_copy, processos);
+    // (na pilha, salvo para strings maiores que o buffer local)
+    char buffer[128];
+    size_t len = strlen(processos);
+    char *processos_copy = len < sizeof(buffer) ? buffer : malloc(len + 1);
 
     // Conta o número de itens divididos por vírgulas
+    strcpy(processos_copy, processos);
     char *token = strtok(processos_copy, ",");
     while (token != NULL) {
         parsed++;
@@ -25,7 +56,7 @@ int parse_itens(char *processos, int** items, int *item_count) {
     *item_count = parsed;
     
     // Aloca memória para o array de inteiros
-    *items = malloc((size_t)parsed * sizeof(int));   
+    *items = aloca(arena, (size_t)parsed * sizeof(int));
     parsed = 0;
 
     // Reinicia a cópia da string para processar os valores
@@ -39,7 +70,9 @@ int parse_itens(char *processos, int** items, int *item_count) {
     }
 
     // Libera a memória alocada para a cópia da string
-    free(processos_copy);
+    if (processos_copy != buffer) {
+        free(processos_copy);
+    }
     return parsed;
 
 }
@@ -69,9 +102,11 @@ void print_processos(Processo **processos, long unsigned int offset, long unsign
     
     // Itera sobre os registros e imprime cada um no formato especificado
     for (long unsigned int i = offset; i < (offset + amount); i++) {
+        char numero[NUMERO_MAX_TEXTO + 1];
+        numero_para_texto(&(*processos)[i].numero, numero);
         printf("%-10d | %-20s | %-20s | %-15s | %-15s | %-4d\n",
             (*processos)[i].id,               // ID do registro
-            (*processos)[i].numero,           // Código associado
+            numero,                           // Código associado
             (*processos)[i].data_string,      // Data em formato de string
             (*processos)[i].classe_string,    // Classe em formato de string
             (*processos)[i].assunto_string,   // Assunto em formato de string
@@ -79,26 +114,145 @@ void print_processos(Processo **processos, long unsigned int offset, long unsign
     }
 }
 
-void export_csv(const char *nome_arquivo, Processo **processos, long unsigned int offset, long unsigned int amount){
-    FILE *file = fopen(nome_arquivo, "w");
-    if (file == NULL) {
+// Tamanho do buffer de escrita de `export_csv`
+#define TAMANHO_BUFFER_ESCRITA ((size_t)1 << 20)
+
+/**
+ * escreve_tudo - Escreve `tamanho` bytes no descritor, repetindo em caso de escrita parcial.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+int escreve_tudo(int fd, const char *dados, size_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t escrito = write(fd, dados, tamanho);
+        if (escrito < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        dados += escrito;
+        tamanho -= (size_t)escrito;
+    }
+    return 0;
+}
+
+/**
+ * copia_texto - Copia uma string terminada em '\0' para `saida`, sem o terminador.
+ * 
+ * Retorna o ponteiro para a posição logo após o último caractere copiado.
+ */
+static char *copia_texto(char *saida, const char *texto) {
+    size_t n = strlen(texto);
+    memcpy(saida, texto, n);
+    return saida + n;
+}
+
+/**
+ * formata_registro_csv - Escreve um processo como uma linha do CSV exportado.
+ * 
+ * Produz exatamente `%d,"%s",%s,"{%s}","{%s}",%d\n`, sem passar por `printf`.
+ * 
+ * Retorna o ponteiro para a posição logo após o '\n'.
+ */
+char *formata_registro_csv(char *p, const Processo *processo) {
+    p = formata_inteiro(processo->id, p);
+    *p++ = ',';
+    *p++ = '"';
+    p = numero_formata(p, &processo->numero);
+    *p++ = '"';
+    *p++ = ',';
+    p = copia_texto(p, processo->data_string);
+    memcpy(p, ",\"{", 3);
+    p += 3;
+    p = copia_texto(p, processo->classe_string);
+    memcpy(p, "}\",\"{", 5);
+    p += 5;
+    p = copia_texto(p, processo->assunto_string);
+    memcpy(p, "}\",", 3);
+    p += 3;
+    p = formata_inteiro(processo->ano_eleicao, p);
+    *p++ = '\n';
+    return p;
+}
+
+/**
+ * exporta - Escreve os registros selecionados em um CSV com um buffer de escrita próprio.
+ * 
+ * @nome_arquivo: Nome do arquivo a ser criado.
+ * @processos: Array de processos.
+ * @indices: Se não for NULL, o i-ésimo registro escrito é `processos[indices[offset + i]]`;
+ *           caso contrário, é `processos[offset + i]`.
+ * @offset: Posição inicial.
+ * @amount: Quantidade de registros.
+ */
+static void exporta(const char *nome_arquivo, const Processo *processos, const long unsigned int *indices,
+                    long unsigned int offset, long unsigned int amount) {
+    long long medicao = metricas_inicio();
+    int fd = open(nome_arquivo, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd == -1) {
         printf("Erro ao abrir o arquivo para escrita.\n");
         return;
     }
+
+    char *buffer = malloc(TAMANHO_BUFFER_ESCRITA);
+    if (buffer == NULL) {
+        printf("Erro ao alocar o buffer de escrita.\n");
+        close(fd);
+        return;
+    }
+
     // Escreve o cabeçalho do arquivo CSV
-    // fprintf(file, "ID,Código,Data,Classe,Assunto,Ano Eleição\n");
-    fprintf(file, "id;numero;data_ajuizamento;id_classe;id_assunto;ano_eleicao\n");
+    char *p = copia_texto(buffer, CABECALHO_CSV);
+    int erro = 0;
 
-    // Escreve os processos
-    for (long unsigned int i = offset; i < (offset + amount); i++) {
-        fprintf(file, "%d,\"%s\",%s,\"{%s}\",\"{%s}\",%d\n",
-                (*processos)[i].id,
-                (*processos)[i].numero,
-                (*processos)[i].data_string,
-                (*processos)[i].classe_string,
-                (*processos)[i].assunto_string,
-                (*processos)[i].ano_eleicao);
+    // Escreve os processos, descarregando o buffer apenas quando ele está quase cheio
+    for (long unsigned int i = offset; i < (offset + amount) && !erro; i++) {
+        if ((size_t)(p - buffer) > TAMANHO_BUFFER_ESCRITA - MAX_LINHA_CSV) {
+            erro = escreve_tudo(fd, buffer, (size_t)(p - buffer)) != 0;
+            p = buffer;
+        }
+        p = formata_registro_csv(p, &processos[indices != NULL ? indices[i] : i]);
+    }
+    if (!erro) {
+        erro = escreve_tudo(fd, buffer, (size_t)(p - buffer)) != 0;
     }
+    if (close(fd) != 0 || erro) {
+        printf("Erro ao escrever o arquivo %s.\n", nome_arquivo);
+    }
+
+    free(buffer);
+    metricas_registra(METRICA_EXPORTACAO, medicao, amount);
+}
+
+/**
+ * export_csv - Exporta um intervalo do array de processos para um arquivo CSV.
+ * 
+ * @nome_arquivo: Nome do arquivo a ser criado.
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @offset: Índice inicial dos processos a serem exportados.
+ * @amount: Quantidade de registros a serem exportados a partir do índice inicial.
+ * 
+ * As linhas são formatadas sem `printf` em um buffer de 1 MB, descarregado com chamadas
+ * `write` grandes. O arquivo é sempre fechado ao final.
+ */
+void export_csv(const char *nome_arquivo, Processo **processos, long unsigned int offset, long unsigned int amount){
+    exporta(nome_arquivo, *processos, NULL, offset, amount);
+}
+
+/**
+ * export_csv_indices - Exporta os processos na ordem dada por uma permutação de índices.
+ * 
+ * @nome_arquivo: Nome do arquivo a ser criado.
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @indices: Permutação (por exemplo, produzida por `ordena_indices_por_data`).
+ * @amount: Quantidade de índices a exportar.
+ * 
+ * Permite gravar uma visão ordenada sem reordenar os registros. O formato é o mesmo de `export_csv`.
+ */
+void export_csv_indices(const char *nome_arquivo, const Processo *processos, const long unsigned int *indices,
+                        long unsigned int amount) {
+    exporta(nome_arquivo, processos, indices, 0, amount);
 }
 
 
@@ -107,14 +261,16 @@ void export_csv(const char *nome_arquivo, Processo **processos, long unsigned in
  * 
  * @linha: String contendo a linha de texto a ser analisada.
  * @processos: Ponteiro para a estrutura `Processo` que será preenchida com os valores extraídos.
+ * @arena: Arena onde os arrays e a data serão alocados; se NULL, usa `malloc`.
  * 
  * A função tenta analisar a linha usando diferentes padrões de formatação (definidos em `PARSE_1`, `PARSE_2`, etc.).
  * Se a análise for bem-sucedida, os campos da estrutura `Processo` são preenchidos, incluindo a conversão de strings
- * para inteiros e a alocação de memória para arrays dinâmicos. A data também é convertida para o formato `struct tm`.
+ * para inteiros e a alocação de memória para arrays dinâmicos. A data também é convertida para o formato `struct tm`
+ * e para um timestamp em milissegundos.
  * 
  * Retorna o número máximo de campos analisados com sucesso.
  */
-int parse_line(const char *linha, Processo *processos) {
+int parse_line(const char *linha, Processo *processos, Arena *arena) {
     // Array de padrões de formatação para tentar analisar a linha
     const char* parse_patters[4] = {
         PARSE_1,
@@ -124,6 +280,8 @@ int parse_line(const char *linha, Processo *processos) {
     };
     
     int max_parsed = 0;
+    long long medicao = metricas_inicio();
+    char numero[NUMERO_MAX_TEXTO + 1];
 
     // Itera sobre os padrões de formatação para tentar analisar a linha
     for (int i = 0; i < 4; i++) {
@@ -133,7 +291,7 @@ int parse_line(const char *linha, Processo *processos) {
             linha,
             parse_patters[i],
             &processos->id,                // ID do registro
-            processos->numero,             // Código associado
+            numero,                        // Código associado
             processos->data_string,        // Data em formato de string
             processos->classe_string,      // Classe em formato de string
             processos->assunto_string,     // Assunto em formato de string
@@ -147,109 +305,1127 @@ int parse_line(const char *linha, Processo *processos) {
 
         // Se todos os campos foram analisados com sucesso, processa os processos
         if (parsed == 6) {
+            numero_compacta(numero, numero + strlen(numero), &processos->numero, arena);
+
             // Converte strings de classe e assunto para arrays de inteiros
-            parse_itens(processos->classe_string, &processos->classe, &processos->classe_len);
-            parse_itens(processos->assunto_string, &processos->assunto, &processos->assunto_len);
+            parse_itens(processos->classe_string, &processos->classe, &processos->classe_len, arena);
+            parse_itens(processos->assunto_string, &processos->assunto, &processos->assunto_len, arena);
 
             // Aloca memória para a data e converte a string para `struct tm`
-            processos->data = malloc(sizeof(struct tm));
-            sscanf(processos->data_string, "%d-%d-%d %d:%d:%d",
+            processos->data = aloca(arena, sizeof(struct tm));
+            memset(processos->data, 0, sizeof(struct tm));
+            int milissegundos = 0;
+            sscanf(processos->data_string, "%d-%d-%d %d:%d:%d.%d",
                 &processos->data->tm_year,
                 &processos->data->tm_mon,
                 &processos->data->tm_mday,
                 &processos->data->tm_hour,
                 &processos->data->tm_min,
-                &processos->data->tm_sec
+                &processos->data->tm_sec,
+                &milissegundos
             );
 
+            // Calcula uma única vez o timestamp usado nas comparações de data
+            processos->timestamp = timestamp_de_data(processos->data, milissegundos);
+
             break; // Interrompe o loop, pois a análise foi bem-sucedida
         }
     }
 
+    metricas_registra(METRICA_ANALISE, medicao, max_parsed == 6);
     return max_parsed;
 }
 
+/**
+ * agora_segundos - Retorna o instante atual de um relógio monotônico, em segundos.
+ */
+double agora_segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * parse_inteiro - Converte os dígitos a partir de `p` em um inteiro, sem ultrapassar `fim`.
+ * 
+ * @p: Início do número (aceita um sinal '-' opcional).
+ * @fim: Limite do buffer.
+ * @valor: Ponteiro onde o valor convertido será armazenado.
+ * 
+ * Retorna o ponteiro para o primeiro caractere após o número ou NULL se não houver dígitos.
+ */
+static const char *parse_inteiro(const char *p, const char *fim, int *valor) {
+    int negativo = 0;
+    int v = 0;
+
+    if (p < fim && *p == '-') {
+        negativo = 1;
+        p++;
+    }
+    if (p >= fim || *p < '0' || *p > '9') {
+        return NULL;
+    }
+    while (p < fim && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        p++;
+    }
+    *valor = negativo ? -v : v;
+    return p;
+}
+
+/**
+ * copia_campo - Copia o texto entre `inicio` e `fim` para `destino`, truncando se necessário.
+ */
+static void copia_campo(char *destino, size_t capacidade, const char *inicio, const char *fim) {
+    size_t n = (size_t)(fim - inicio);
+    if (n > capacidade - 1) {
+        n = capacidade - 1;
+    }
+    memcpy(destino, inicio, n);
+    destino[n] = '\0';
+}
+
+/**
+ * parse_lista - Valida uma lista no formato `{a,b,c}` ou `"{a,b,c}"` em uma única passagem.
+ * 
+ * @p: Início do campo (aspas opcionais seguidas de '{').
+ * @fim: Limite da linha.
+ * @conteudo: Ponteiro que receberá o início do conteúdo entre chaves.
+ * @fecha: Ponteiro que receberá a posição da chave de fechamento.
+ * @qtd: Ponteiro que receberá a quantidade de itens da lista.
+ * 
+ * Os itens só são convertidos por `converte_lista`, depois que a linha inteira foi validada,
+ * de modo que uma linha mal formada não reserva memória.
+ * 
+ * Retorna o ponteiro para o caractere após o campo ou NULL se o campo estiver mal formado.
+ */
+static const char *parse_lista(const char *p, const char *fim, const char **conteudo,
+                               const char **fecha, int *qtd) {
+    int aspas = 0;
+
+    if (p < fim && *p == '"') {
+        aspas = 1;
+        p++;
+    }
+    if (p >= fim || *p != '{') {
+        return NULL;
+    }
+    p++;
+
+    *conteudo = p;
+    *fecha = memchr(p, '}', (size_t)(fim - p));
+    if (*fecha == NULL) {
+        return NULL;
+    }
+
+    // Conta os itens pelo número de vírgulas entre as chaves
+    *qtd = 0;
+    if (*fecha > p) {
+        *qtd = 1;
+        for (const char *q = p; q < *fecha; q++) {
+            if (*q == ',') {
+                (*qtd)++;
+            }
+        }
+    }
+
+    p = *fecha + 1;
+    if (aspas) {
+        if (p >= fim || *p != '"') {
+            return NULL;
+        }
+        p++;
+    }
+    return p;
+}
+
+/**
+ * converte_lista - Copia e converte o conteúdo de uma lista validada por `parse_lista`.
+ * 
+ * @conteudo: Início do conteúdo entre chaves.
+ * @fecha: Posição da chave de fechamento.
+ * @qtd: Quantidade de itens contada por `parse_lista`.
+ * @texto: Buffer que receberá o conteúdo entre chaves (formato string).
+ * @capacidade: Tamanho do buffer `texto`.
+ * @itens: Ponteiro para o array de inteiros que será alocado na arena e preenchido.
+ * @itens_len: Ponteiro que receberá a quantidade de itens convertidos.
+ * @arena: Arena onde o array será alocado.
+ */
+static void converte_lista(const char *conteudo, const char *fecha, int qtd, char *texto, size_t capacidade,
+                           int **itens, int *itens_len, Arena *arena) {
+    const char *p = conteudo;
+
+    copia_campo(texto, capacidade, conteudo, fecha);
+    *itens = qtd > 0 ? aloca(arena, (size_t)qtd * sizeof(int)) : NULL;
+    *itens_len = 0;
+    while (p < fecha && *itens_len < qtd) {
+        while (p < fecha && (*p == ' ' || *p == ',')) {
+            p++;
+        }
+        int valor;
+        const char *prox = parse_inteiro(p, fecha, &valor);
+        if (prox == NULL) {
+            break;
+        }
+        (*itens)[(*itens_len)++] = valor;
+        p = prox;
+    }
+}
+
+// Conversão de dígitos em palavras de 64 bits (SWAR); depende da ordem de bytes little-endian
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define PARSE_SWAR 1
+#endif
+
+/**
+ * digito - Valor do dígito `c` como inteiro sem sinal (maior que 9 se `c` não for um dígito).
+ */
+static inline unsigned int digito(char c) {
+    return (unsigned int)(unsigned char)c - '0';
+}
+
+#ifdef PARSE_SWAR
+/**
+ * conta_digitos_swar - Conta os dígitos iniciais dos 8 bytes em `p` (0 a 8).
+ * 
+ * Um byte é dígito se o nibble alto for 3 e o nibble baixo for no máximo 9 (somar 6 não transborda).
+ */
+static inline int conta_digitos_swar(const char *p) {
+    unsigned long long x;
+    memcpy(&x, p, 8);
+    unsigned long long nao_digito = ((x & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL) |
+                                    (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL);
+    return nao_digito == 0 ? 8 : __builtin_ctzll(nao_digito) / 8;
+}
+
+/**
+ * converte_digitos_swar - Converte `n` dígitos (0 a 8) em `p` com três multiplicações.
+ * 
+ * Os dígitos são alinhados à direita de uma palavra preenchida com '0' e combinados dois a dois,
+ * quatro a quatro e oito a oito.
+ */
+static inline unsigned int converte_digitos_swar(const char *p, int n) {
+    unsigned long long x = 0x3030303030303030ULL;
+    memcpy((char *)&x + (8 - n), p, (size_t)n);
+    x = (x & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+    x = (x & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+    return (unsigned int)((x & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+}
+#endif
+
+/**
+ * digitos_validos - Indica se os `NUMERO_DIGITOS` caracteres em `p` são todos dígitos.
+ */
+static inline int digitos_validos(const char *p) {
+#ifdef PARSE_SWAR
+    return conta_digitos_swar(p) == 8 && conta_digitos_swar(p + 8) == 8 &&
+           conta_digitos_swar(p + NUMERO_DIGITOS - 8) == 8;
+#else
+    for (int i = 0; i < NUMERO_DIGITOS; i++) {
+        if (digito(p[i]) > 9) {
+            return 0;
+        }
+    }
+    return 1;
+#endif
+}
+
+/**
+ * numero_compacta - Converte o texto de `numero` em sua forma compactada.
+ * 
+ * @inicio: Primeiro caractere do número (sem as aspas).
+ * @fim: Posição logo após o último caractere.
+ * @numero: Estrutura que receberá o número.
+ * @arena: Arena onde o texto é reservado quando o número não é compactável; se NULL, usa `malloc`.
+ * 
+ * Um número de exatamente 20 dígitos vira `prefixo` (2 dígitos) e `digitos` (18 dígitos),
+ * convertidos 8 a 8 (SWAR). Qualquer outro texto é guardado como está, truncado em
+ * `NUMERO_MAX_TEXTO` caracteres como no antigo campo `char[30]`.
+ * 
+ * Retorna 0 se o número foi compactado ou 1 se foi guardado como texto.
+ */
+int numero_compacta(const char *inicio, const char *fim, NumeroProcesso *numero, Arena *arena) {
+    size_t n = (size_t)(fim - inicio);
+
+    if (n == NUMERO_DIGITOS && digitos_validos(inicio)) {
+        numero->prefixo = digito(inicio[0]) * 10 + digito(inicio[1]);
+#ifdef PARSE_SWAR
+        numero->digitos = (unsigned long long)converte_digitos_swar(inicio + 2, 8) * 10000000000ULL +
+                          (unsigned long long)converte_digitos_swar(inicio + 10, 8) * 100ULL +
+                          digito(inicio[18]) * 10 + digito(inicio[19]);
+#else
+        numero->digitos = 0;
+        for (int i = 2; i < NUMERO_DIGITOS; i++) {
+            numero->digitos = numero->digitos * 10 + digito(inicio[i]);
+        }
+#endif
+        return 0;
+    }
+
+    if (n > NUMERO_MAX_TEXTO) {
+        n = NUMERO_MAX_TEXTO;
+    }
+    char *texto = aloca(arena, n + 1);
+    memcpy(texto, inicio, n);
+    texto[n] = '\0';
+    numero->texto = texto;
+    numero->prefixo = NUMERO_TEXTO;
+    return 1;
+}
+
+/**
+ * numero_de_texto - Compacta um número digitado por um usuário, para consulta.
+ * 
+ * @texto: Número com 20 dígitos, com ou sem a pontuação do CNJ (ex.: 0600082-46.2021.6.07.0000).
+ * @numero: Estrutura que receberá o número compactado.
+ * 
+ * Pontos, hífens e espaços são ignorados. Nenhuma memória é reservada.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se o texto não tiver exatamente 20 dígitos.
+ */
+int numero_de_texto(const char *texto, NumeroProcesso *numero) {
+    char digitos[NUMERO_DIGITOS];
+    int n = 0;
+
+    for (const char *p = texto; *p != '\0'; p++) {
+        if (*p == '.' || *p == '-' || *p == ' ') {
+            continue;
+        }
+        if (digito(*p) > 9 || n == NUMERO_DIGITOS) {
+            return -1;
+        }
+        digitos[n++] = *p;
+    }
+    if (n != NUMERO_DIGITOS) {
+        return -1;
+    }
+    return numero_compacta(digitos, digitos + NUMERO_DIGITOS, numero, NULL) == 0 ? 0 : -1;
+}
+
+/**
+ * numero_formata - Escreve o número exatamente como estava no CSV de origem.
+ * 
+ * @saida: Buffer com pelo menos `NUMERO_MAX_TEXTO` posições livres; nenhum '\0' é acrescentado.
+ * @numero: Número compactado.
+ * 
+ * Os 18 dígitos finais são escritos em duas metades de 9 dígitos, com aritmética de 32 bits.
+ * 
+ * Retorna o ponteiro para a posição logo após o último caractere escrito.
+ */
+char *numero_formata(char *saida, const NumeroProcesso *numero) {
+    if (numero->prefixo == NUMERO_TEXTO) {
+        return copia_texto(saida, numero->texto);
+    }
+
+    unsigned int metades[2] = { (unsigned int)(numero->digitos / 1000000000ULL),
+                                (unsigned int)(numero->digitos % 1000000000ULL) };
+    saida[0] = (char)('0' + numero->prefixo / 10);
+    saida[1] = (char)('0' + numero->prefixo % 10);
+    for (int m = 0; m < 2; m++) {
+        unsigned int v = metades[m];
+        for (int i = 2 + 9 * m + 8; i >= 2 + 9 * m; i--) {
+            saida[i] = (char)('0' + v % 10);
+            v /= 10;
+        }
+    }
+    return saida + NUMERO_DIGITOS;
+}
+
+/**
+ * numero_para_texto - Escreve o número em `saida` como uma string terminada em '\0'.
+ * 
+ * @numero: Número compactado.
+ * @saida: Buffer com pelo menos `NUMERO_MAX_TEXTO + 1` posições.
+ */
+void numero_para_texto(const NumeroProcesso *numero, char *saida) {
+    *numero_formata(saida, numero) = '\0';
+}
+
+/**
+ * numero_iguais - Indica se dois números compactados representam o mesmo texto.
+ * 
+ * Retorna 1 se forem iguais ou 0 caso contrário.
+ */
+int numero_iguais(const NumeroProcesso *a, const NumeroProcesso *b) {
+    if (a->prefixo != b->prefixo) {
+        return 0;
+    }
+    if (a->prefixo == NUMERO_TEXTO) {
+        return strcmp(a->texto, b->texto) == 0;
+    }
+    return a->digitos == b->digitos;
+}
+
+/**
+ * inteiro_rapido - Lê um inteiro não negativo de até 9 dígitos.
+ * 
+ * Retorna o ponteiro após o último dígito ou NULL se não houver dígitos ou se o número for
+ * longo demais (casos tratados pelo caminho geral).
+ */
+static inline const char *inteiro_rapido(const char *p, const char *fim, int *valor) {
+    int n = 0;
+
+#ifdef PARSE_SWAR
+    if (fim - p >= 16) {
+        n = conta_digitos_swar(p);
+        if (n == 8) {
+            if (digito(p[8]) <= 9) {
+                if (digito(p[9]) <= 9) {
+                    return NULL;
+                }
+                *valor = (int)(converte_digitos_swar(p, 8) * 10 + digito(p[8]));
+                return p + 9;
+            }
+        }
+        if (n == 0) {
+            return NULL;
+        }
+        *valor = (int)converte_digitos_swar(p, n);
+        return p + n;
+    }
+#endif
+    unsigned int v = 0;
+    while (p + n < fim && digito(p[n]) <= 9 && n < 10) {
+        v = v * 10 + digito(p[n]);
+        n++;
+    }
+    if (n == 0 || n > 9) {
+        return NULL;
+    }
+    *valor = (int)v;
+    return p + n;
+}
+
+// Maior lista aceita pelo caminho rápido
+#define MAX_ITENS_RAPIDO 16
+
+/**
+ * lista_rapida - Lê uma lista `{a,b}` ou `"{a,b}"` de inteiros não negativos, sem reservar memória.
+ * 
+ * @valores: Array de `MAX_ITENS_RAPIDO` posições que receberá os itens.
+ * @qtd: Ponteiro que receberá a quantidade de itens.
+ * @conteudo: Ponteiro que receberá o início do conteúdo entre chaves.
+ * @fecha: Ponteiro que receberá a posição da chave de fechamento.
+ * 
+ * Retorna o ponteiro após o campo ou NULL se o campo não tiver o formato esperado.
+ */
+static const char *lista_rapida(const char *p, const char *fim, int *valores, int *qtd,
+                                const char **conteudo, const char **fecha) {
+    int aspas = p < fim && *p == '"';
+
+    p += aspas;
+    if (p >= fim || *p != '{') {
+        return NULL;
+    }
+    *conteudo = ++p;
+    *qtd = 0;
+    if (p < fim && *p != '}') {
+        for (;;) {
+            if (*qtd == MAX_ITENS_RAPIDO || (p = inteiro_rapido(p, fim, &valores[*qtd])) == NULL) {
+                return NULL;
+            }
+            (*qtd)++;
+            if (p >= fim || *p != ',') {
+                break;
+            }
+            p++;
+        }
+    }
+    if (p >= fim || *p != '}') {
+        return NULL;
+    }
+    *fecha = p++;
+    if (aspas) {
+        if (p >= fim || *p != '"') {
+            return NULL;
+        }
+        p++;
+    }
+    return p;
+}
+
+/**
+ * guarda_lista - Copia o texto e os itens de uma lista lida por `lista_rapida`.
+ */
+static void guarda_lista(const int *valores, int qtd, const char *conteudo, const char *fecha, char *texto,
+                         size_t capacidade, int **itens, int *itens_len, Arena *arena) {
+    copia_campo(texto, capacidade, conteudo, fecha);
+    *itens = qtd > 0 ? aloca(arena, (size_t)qtd * sizeof(int)) : NULL;
+    if (qtd > 0) {
+        memcpy(*itens, valores, (size_t)qtd * sizeof(int));
+    }
+    *itens_len = qtd;
+}
+
+/**
+ * data_rapida - Decodifica `YYYY-MM-DD hh:mm:ss.mmm` em posições fixas.
+ * 
+ * Os 17 dígitos são convertidos sem desvios e validados de uma só vez (qualquer byte que não
+ * seja dígito produz um valor maior que 9), assim como os separadores.
+ * 
+ * Retorna 0 se a data tiver o formato esperado ou -1 caso contrário.
+ */
+static int data_rapida(const char *d, struct tm *data, int *milissegundos) {
+    static const unsigned char posicoes[17] = {0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18, 20, 21, 22};
+    unsigned int v[17];
+    unsigned int invalido = 0;
+
+    for (int i = 0; i < 17; i++) {
+        v[i] = digito(d[posicoes[i]]);
+        invalido |= v[i] > 9;
+    }
+    invalido |= (d[4] ^ '-') | (d[7] ^ '-') | (d[10] ^ ' ') | (d[13] ^ ':') | (d[16] ^ ':') | (d[19] ^ '.');
+    if (invalido) {
+        return -1;
+    }
+
+    data->tm_year = (int)(v[0] * 1000 + v[1] * 100 + v[2] * 10 + v[3]);
+    data->tm_mon = (int)(v[4] * 10 + v[5]);
+    data->tm_mday = (int)(v[6] * 10 + v[7]);
+    data->tm_hour = (int)(v[8] * 10 + v[9]);
+    data->tm_min = (int)(v[10] * 10 + v[11]);
+    data->tm_sec = (int)(v[12] * 10 + v[13]);
+    *milissegundos = (int)(v[14] * 100 + v[15] * 10 + v[16]);
+    return 0;
+}
+
+// Tamanhos fixos dos campos do arquivo
+#define TAMANHO_NUMERO 20
+#define TAMANHO_DATA 23
+
+/**
+ * parse_registro_rapido - Caminho rápido de `parse_registro` para o formato fixo do arquivo.
+ * 
+ * Aceita apenas linhas com id de até 9 dígitos, `numero` de 20 caracteres entre aspas, data
+ * `YYYY-MM-DD hh:mm:ss.mmm`, listas de até 16 inteiros não negativos e ano de até 9 dígitos.
+ * Os inteiros são convertidos 8 dígitos por vez (SWAR) e a data em posições fixas. Qualquer
+ * desvio do formato devolve -1 antes de reservar memória, e a linha segue pelo caminho geral.
+ * 
+ * Retorna 6 se a linha foi analisada ou -1 se ela deve ser analisada pelo caminho geral.
+ */
+static int parse_registro_rapido(const char *inicio, const char *fim, Processo *processo, Arena *arena) {
+    const char *p = inicio;
+    struct tm data;
+    int milissegundos;
+
+    // id,"numero",data,
+    p = inteiro_rapido(p, fim, &processo->id);
+    if (p == NULL || fim - p < TAMANHO_NUMERO + TAMANHO_DATA + 5 || p[0] != ',' || p[1] != '"' ||
+        p[TAMANHO_NUMERO + 2] != '"' || p[TAMANHO_NUMERO + 3] != ',' ||
+        p[TAMANHO_NUMERO + TAMANHO_DATA + 4] != ',') {
+        return -1;
+    }
+    const char *numero = p + 2;
+    const char *d = p + TAMANHO_NUMERO + 4;
+    if (!digitos_validos(numero) || memchr(d, ',', TAMANHO_DATA) != NULL ||
+        data_rapida(d, &data, &milissegundos) != 0) {
+        return -1;
+    }
+    p = d + TAMANHO_DATA + 1;
+
+    // Listas e ano são lidos por completo antes de reservar memória: a arena não tem desalocação
+    int classes[MAX_ITENS_RAPIDO], assuntos[MAX_ITENS_RAPIDO];
+    int classe_qtd, assunto_qtd;
+    const char *classe_ini, *classe_fim, *assunto_ini, *assunto_fim;
+    p = lista_rapida(p, fim, classes, &classe_qtd, &classe_ini, &classe_fim);
+    if (p == NULL || p >= fim || *p++ != ',') {
+        return -1;
+    }
+    p = lista_rapida(p, fim, assuntos, &assunto_qtd, &assunto_ini, &assunto_fim);
+    if (p == NULL || p >= fim || *p++ != ',' || inteiro_rapido(p, fim, &processo->ano_eleicao) == NULL) {
+        return -1;
+    }
+
+    guarda_lista(classes, classe_qtd, classe_ini, classe_fim, processo->classe_string,
+                 sizeof(processo->classe_string), &processo->classe, &processo->classe_len, arena);
+    guarda_lista(assuntos, assunto_qtd, assunto_ini, assunto_fim, processo->assunto_string,
+                 sizeof(processo->assunto_string), &processo->assunto, &processo->assunto_len, arena);
+    numero_compacta(numero, numero + TAMANHO_NUMERO, &processo->numero, arena);
+    memcpy(processo->data_string, d, TAMANHO_DATA);
+    processo->data_string[TAMANHO_DATA] = '\0';
+
+    processo->data = aloca(arena, sizeof(struct tm));
+    memset(processo->data, 0, sizeof(struct tm));
+    processo->data->tm_year = data.tm_year;
+    processo->data->tm_mon = data.tm_mon;
+    processo->data->tm_mday = data.tm_mday;
+    processo->data->tm_hour = data.tm_hour;
+    processo->data->tm_min = data.tm_min;
+    processo->data->tm_sec = data.tm_sec;
+    processo->timestamp = timestamp_de_data(processo->data, milissegundos);
+    return 6;
+}
+
+/**
+ * parse_registro - Analisa uma linha do CSV delimitada por `inicio` e `fim` em uma única varredura.
+ * 
+ * @inicio: Primeiro caractere da linha.
+ * @fim: Posição logo após o último caractere da linha (o '\n' não precisa estar incluído).
+ * @processo: Ponteiro para a estrutura `Processo` que será preenchida.
+ * @arena: Arena onde os arrays de classe/assunto e a data serão alocados; se NULL, usa `malloc`.
+ * 
+ * Diferente de `parse_line`, que tenta os padrões `PARSE_1`..`PARSE_4` um após o outro, este
+ * tokenizador reconhece as listas de classe e assunto com ou sem aspas na mesma passagem e não
+ * exige que a linha termine em '\0', o que permite analisar diretamente um arquivo mapeado em memória.
+ * Nenhuma memória é reservada para linhas mal formadas.
+ * 
+ * As linhas no formato fixo do arquivo passam antes por `parse_registro_rapido`; as demais
+ * (ids negativos, espaços nas listas, datas em outro formato...) seguem pelo tokenizador geral.
+ * 
+ * Retorna o número de campos analisados com sucesso (6 quando a linha é válida).
+ */
+int parse_registro(const char *inicio, const char *fim, Processo *processo, Arena *arena) {
+    if (parse_registro_rapido(inicio, fim, processo, arena) == 6) {
+        return 6;
+    }
+
+    const char *p = inicio;
+    const char *sep;
+    const char *classe_ini, *classe_fim, *assunto_ini, *assunto_fim;
+    int classe_qtd, assunto_qtd;
+
+    processo->classe = NULL;
+    processo->assunto = NULL;
+    processo->data = NULL;
+
+    // 1. id
+    p = parse_inteiro(p, fim, &processo->id);
+    if (p == NULL || p >= fim || *p != ',') {
+        return 0;
+    }
+    p++;
+
+    // 2. numero (entre aspas)
+    if (p >= fim || *p != '"') {
+        return 1;
+    }
+    p++;
+    sep = memchr(p, '"', (size_t)(fim - p));
+    if (sep == NULL || sep + 1 >= fim || sep[1] != ',') {
+        return 1;
+    }
+    const char *numero_ini = p, *numero_fim = sep;
+    p = sep + 2;
+
+    // 3. data_ajuizamento
+    sep = memchr(p, ',', (size_t)(fim - p));
+    if (sep == NULL || sep == p) {
+        return 2;
+    }
+    copia_campo(processo->data_string, sizeof(processo->data_string), p, sep);
+    p = sep + 1;
+
+    // 4. id_classe
+    p = parse_lista(p, fim, &classe_ini, &classe_fim, &classe_qtd);
+    if (p == NULL || p >= fim || *p != ',') {
+        return 3;
+    }
+    p++;
+
+    // 5. id_assunto
+    p = parse_lista(p, fim, &assunto_ini, &assunto_fim, &assunto_qtd);
+    if (p == NULL || p >= fim || *p != ',') {
+        return 4;
+    }
+    p++;
+
+    // 6. ano_eleicao
+    if (parse_inteiro(p, fim, &processo->ano_eleicao) == NULL) {
+        return 5;
+    }
+
+    // Linha válida: compacta o número e converte as listas
+    numero_compacta(numero_ini, numero_fim, &processo->numero, arena);
+    converte_lista(classe_ini, classe_fim, classe_qtd, processo->classe_string,
+                   sizeof(processo->classe_string), &processo->classe, &processo->classe_len, arena);
+    converte_lista(assunto_ini, assunto_fim, assunto_qtd, processo->assunto_string,
+                   sizeof(processo->assunto_string), &processo->assunto, &processo->assunto_len, arena);
+
+    // Converte a data para `struct tm` e timestamp (mesmos campos preenchidos por `parse_line`)
+    processo->data = aloca(arena, sizeof(struct tm));
+    memset(processo->data, 0, sizeof(struct tm));
+    int *campos_data[6] = {
+        &processo->data->tm_year,
+        &processo->data->tm_mon,
+        &processo->data->tm_mday,
+        &processo->data->tm_hour,
+        &processo->data->tm_min,
+        &processo->data->tm_sec
+    };
+    int milissegundos = 0;
+    const char *d = processo->data_string;
+    const char *d_fim = d + strlen(d);
+    for (int i = 0; i < 7 && d != NULL && d < d_fim; i++) {
+        d = parse_inteiro(d, d_fim, i < 6 ? campos_data[i] : &milissegundos);
+        if (d != NULL && d < d_fim) {
+            d++; // Pula o separador ('-', ' ', ':' ou '.')
+        }
+    }
+    processo->timestamp = timestamp_de_data(processo->data, milissegundos);
+
+    return 6;
+}
+
+/**
+ * parse_intervalo - Analisa todas as linhas entre `inicio` e `fim`, acrescentando-as ao array `processos`.
+ * 
+ * @inicio: Início do trecho (deve coincidir com o início de uma linha).
+ * @fim: Fim do trecho.
+ * @processos: Ponteiro para o array de processos, realocado conforme necessário.
+ * @count: Ponteiro para a quantidade de registros já presentes no array.
+ * @capacidade: Ponteiro para a capacidade atual do array.
+ * @arena: Arena onde os campos alocados de cada registro serão reservados.
+ * 
+ * O array cresce geometricamente, evitando uma passagem prévia apenas para contar as linhas.
+ * Linhas vazias ou mal formadas são descartadas.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se não houver memória.
+ */
+static int parse_intervalo(const char *inicio, const char *fim, Processo **processos,
+                           long unsigned int *count, long unsigned int *capacidade, Arena *arena) {
+    const char *p = inicio;
+    long unsigned int inicial = *count;
+    long long medicao = metricas_inicio();
+
+    while (p < fim) {
+        const char *nl = memchr(p, '\n', (size_t)(fim - p));
+        const char *fim_linha = nl != NULL ? nl : fim;
+
+        if (*count == *capacidade) {
+            long unsigned int nova = *capacidade > 0 ? *capacidade * 2 : 1024;
+            Processo *novo = realloc(*processos, nova * sizeof(Processo));
+            if (novo == NULL) {
+                return -1;
+            }
+            *processos = novo;
+            *capacidade = nova;
+        }
+
+        if (parse_registro(p, fim_linha, &(*processos)[*count], arena) == 6) {
+            (*count)++;
+        }
+        p = fim_linha + 1;
+    }
+    metricas_registra(METRICA_ANALISE, medicao, *count - inicial);
+    return 0;
+}
+
 /**
  * read_csv - Lê um arquivo CSV e preenche um array de estruturas `Processo` com as informações extraídas.
  * 
  * @nome_arquivo: Nome do arquivo CSV a ser lido.
  * @processos: Ponteiro para um array de estruturas `Processo` que será alocado dinamicamente e preenchido com os registros do arquivo.
+ * @arena: Arena que passa a ser dona dos campos alocados dos registros (classe, assunto e data).
  * 
- * A função lê o arquivo CSV linha por linha, ignora o cabeçalho e analisa cada linha para preencher as estruturas `Processo`.
+ * Equivale a `read_csv_stats` sem coleta de estatísticas.
  * 
  * Retorna o número de registros lidos ou 1 em caso de erro ao abrir o arquivo.
  */
-long unsigned int read_csv(const char *nome_arquivo, Processo **processos) {
-    // Abre o arquivo para leitura
-    FILE *file = fopen(nome_arquivo, "r");
-    if (file == NULL) {
+long unsigned int read_csv(const char *nome_arquivo, Processo **processos, Arena *arena) {
+    return read_csv_stats(nome_arquivo, processos, arena, NULL);
+}
+
+/**
+ * mapeia_arquivo - Abre e mapeia um arquivo inteiro em memória para leitura.
+ * 
+ * @nome_arquivo: Nome do arquivo a ser mapeado.
+ * @mapa: Ponteiro que receberá o início do mapeamento (NULL para arquivos vazios).
+ * @tamanho: Ponteiro que receberá o tamanho do arquivo em bytes.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+static int mapeia_arquivo(const char *nome_arquivo, char **mapa, size_t *tamanho) {
+    int fd = open(nome_arquivo, O_RDONLY);
+    if (fd == -1) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        return -1;
+    }
+
+    *tamanho = (size_t)st.st_size;
+    *mapa = NULL;
+    if (*tamanho > 0) {
+        *mapa = mmap(NULL, *tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (*mapa == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        madvise(*mapa, *tamanho, MADV_SEQUENTIAL);
+    }
+
+    // O mapeamento continua válido após o fechamento do descritor
+    close(fd);
+    return 0;
+}
+
+/**
+ * pula_cabecalho - Retorna o início da primeira linha de dados, após o cabeçalho.
+ */
+static const char *pula_cabecalho(const char *mapa, size_t tamanho) {
+    const char *p = memchr(mapa, '\n', tamanho);
+    return p != NULL ? p + 1 : mapa + tamanho;
+}
+
+/**
+ * ajusta_processos - Reduz o array de processos ao número exato de registros.
+ */
+static void ajusta_processos(Processo **processos, long unsigned int count, long unsigned int capacidade) {
+    if (count > 0 && count < capacidade) {
+        Processo *ajustado = realloc(*processos, count * sizeof(Processo));
+        if (ajustado != NULL) {
+            *processos = ajustado;
+        }
+    }
+}
+
+/**
+ * read_csv_stats - Lê um arquivo CSV mapeado em memória e preenche um array de estruturas `Processo`.
+ * 
+ * @nome_arquivo: Nome do arquivo CSV a ser lido.
+ * @processos: Ponteiro para um array de estruturas `Processo` que será alocado dinamicamente e preenchido com os registros do arquivo.
+ * @arena: Arena que passa a ser dona dos campos alocados dos registros (classe, assunto e data).
+ * @stats: Estrutura que receberá linhas, bytes e tempo da leitura (pode ser NULL).
+ * 
+ * O arquivo é mapeado com `mmap` e percorrido uma única vez: o cabeçalho é ignorado e cada linha
+ * é analisada por `parse_registro` diretamente sobre o mapeamento, sem cópias intermediárias.
+ * Os arrays de classe e assunto e as datas são reservados em blocos contíguos da arena; ao final,
+ * basta `arena_libera` e `free(*processos)` para liberar toda a base.
+ * 
+ * Retorna o número de registros lidos ou 1 em caso de erro ao abrir o arquivo.
+ */
+long unsigned int read_csv_stats(const char *nome_arquivo, Processo **processos, Arena *arena,
+                                 EstatisticasLeitura *stats) {
+    double inicio = agora_segundos();
+    long long medicao = metricas_inicio();
+    char *mapa;
+    size_t tamanho;
+
+    // Abre e mapeia o arquivo para leitura
+    if (mapeia_arquivo(nome_arquivo, &mapa, &tamanho) != 0) {
         printf("Erro ao abrir o arquivo.\n");
         return 1; // Retorna 1 em caso de erro
     }
-    
+
     long unsigned int count = 0;
+    long unsigned int capacidade = 0;
+    *processos = NULL;
 
-    // Variáveis para leitura de linhas
-    char *linha;
-    size_t len = 0;
+    if (mapa != NULL) {
+        const char *p = pula_cabecalho(mapa, tamanho);
+        if (parse_intervalo(p, mapa + tamanho, processos, &count, &capacidade, arena) != 0) {
+            printf("Erro ao alocar memória para os processos.\n");
+        }
+        ajusta_processos(processos, count, capacidade);
+        munmap(mapa, tamanho);
+    }
 
-    // Conta o número de linhas no arquivo
-    while (getline(&linha, &len, file) != -1) {
-        count++;
+    if (stats != NULL) {
+        stats->linhas = count;
+        stats->bytes = tamanho;
+        stats->segundos = agora_segundos() - inicio;
     }
-    count -= 1; // Subtrai 1 para ignorar o cabeçalho
+    metricas_registra(METRICA_LEITURA, medicao, count);
 
-    // Aloca memória para o array de estruturas `Processo`
-    *processos = malloc(count * sizeof(Processo));
+    return count; // Retorna o número de registros lidos
+}
+
+// Trecho do arquivo analisado por uma thread de `read_csv_paralelo`
+typedef struct {
+    const char *inicio;             // Início do trecho (sempre no início de uma linha)
+    const char *fim;                // Fim do trecho (logo após um '\n' ou fim do arquivo)
+    Processo *processos;            // Buffer local da thread
+    long unsigned int count;        // Registros analisados pela thread
+    long unsigned int capacidade;   // Capacidade do buffer local
+    Arena arena;                    // Arena local da thread
+    int erro;                       // Diferente de 0 se faltou memória
+} TrechoLeitura;
 
-    // Reinicia o ponteiro do arquivo para o início
-    rewind(file);
+/**
+ * thread_leitura - Função executada por cada thread de `read_csv_paralelo`.
+ */
+static void *thread_leitura(void *arg) {
+    TrechoLeitura *trecho = arg;
+    trecho->erro = parse_intervalo(trecho->inicio, trecho->fim, &trecho->processos,
+                                   &trecho->count, &trecho->capacidade, &trecho->arena);
+    return NULL;
+}
 
-    // Lê e ignora a primeira linha (cabeçalho)
-    getline(&linha, &len, file);
+/**
+ * read_csv_paralelo - Lê um arquivo CSV dividindo a análise entre várias threads.
+ * 
+ * @nome_arquivo: Nome do arquivo CSV a ser lido.
+ * @processos: Ponteiro para um array de estruturas `Processo` que será alocado dinamicamente e preenchido com os registros do arquivo.
+ * @num_threads: Número de threads; se menor ou igual a 0, usa o número de núcleos disponíveis.
+ * @stats: Estrutura que receberá linhas, bytes e tempo da leitura (pode ser NULL).
+ * 
+ * O corpo do arquivo é dividido em `num_threads` trechos de tamanho aproximadamente igual, cujas
+ * fronteiras são ajustadas para o início da linha seguinte. Cada thread analisa seu trecho em um
+ * buffer e uma arena próprios e, ao final, os buffers são concatenados na ordem do arquivo e as
+ * arenas locais são absorvidas por `arena`. O resultado é idêntico ao de `read_csv`.
+ * 
+ * Retorna o número de registros lidos, 1 em caso de erro ao abrir o arquivo ou 0 (com `*processos`
+ * igual a NULL) se não houver memória.
+ */
+long unsigned int read_csv_paralelo(const char *nome_arquivo, Processo **processos, Arena *arena,
+                                    int num_threads, EstatisticasLeitura *stats) {
+    double inicio = agora_segundos();
+    long long medicao = metricas_inicio();
+    char *mapa;
+    size_t tamanho;
 
-    // Lê cada linha do arquivo e preenche o array de estruturas `Processo`
-    int i = 0;
-    while (getline(&linha, &len, file) != -1) {
-        parse_line(linha, &(*processos)[i]); // Analisa a linha e preenche a estrutura
-        i++;
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_threads <= 0) {
+            num_threads = 1;
+        }
     }
 
-    // Libera a memória alocada para a linha e fecha o arquivo
-    free(linha);
-    fclose(file);
+    // Abre e mapeia o arquivo para leitura
+    if (mapeia_arquivo(nome_arquivo, &mapa, &tamanho) != 0) {
+        printf("Erro ao abrir o arquivo.\n");
+        return 1; // Retorna 1 em caso de erro
+    }
+
+    long unsigned int count = 0;
+    *processos = NULL;
+
+    if (mapa != NULL) {
+        const char *corpo = pula_cabecalho(mapa, tamanho);
+        const char *fim = mapa + tamanho;
+        size_t tamanho_corpo = (size_t)(fim - corpo);
+
+        TrechoLeitura *trechos = calloc((size_t)num_threads, sizeof(TrechoLeitura));
+        pthread_t *threads = malloc((size_t)num_threads * sizeof(pthread_t));
+        if (trechos == NULL || threads == NULL) {
+            printf("Erro ao alocar memória para a leitura paralela.\n");
+        } else {
+            // Divide o corpo em trechos alinhados ao início das linhas
+            const char *atual = corpo;
+            for (int t = 0; t < num_threads; t++) {
+                const char *limite = corpo + tamanho_corpo / (size_t)num_threads * (size_t)(t + 1);
+                if (t == num_threads - 1 || limite > fim) {
+                    limite = fim;
+                }
+                if (limite < atual) {
+                    limite = atual;
+                }
+                if (limite < fim) {
+                    const char *nl = memchr(limite, '\n', (size_t)(fim - limite));
+                    limite = nl != NULL ? nl + 1 : fim;
+                }
+                trechos[t].inicio = atual;
+                trechos[t].fim = limite;
+                arena_inicializa(&trechos[t].arena, arena->tamanho_bloco);
+                atual = limite;
+            }
+
+            // Se uma thread não puder ser criada, ela e as seguintes rodam na thread atual
+            int criadas = 0;
+            for (int t = 0; t < num_threads; t++) {
+                if (criadas == t && pthread_create(&threads[t], NULL, thread_leitura, &trechos[t]) == 0) {
+                    criadas++;
+                } else {
+                    thread_leitura(&trechos[t]);
+                }
+            }
+            for (int t = 0; t < num_threads; t++) {
+                if (t < criadas) {
+                    pthread_join(threads[t], NULL);
+                }
+                count += trechos[t].count;
+                if (trechos[t].erro != 0) {
+                    printf("Erro ao alocar memória para os processos.\n");
+                }
+            }
+
+            // Concatena os buffers locais na ordem do arquivo
+            *processos = malloc((count > 0 ? count : 1) * sizeof(Processo));
+            if (*processos == NULL) {
+                printf("Erro ao alocar memória para os processos.\n");
+                count = 0;
+            }
+            long unsigned int pos = 0;
+            for (int t = 0; t < num_threads; t++) {
+                if (*processos != NULL) {
+                    memcpy(*processos + pos, trechos[t].processos, trechos[t].count * sizeof(Processo));
+                    pos += trechos[t].count;
+                    arena_absorve(arena, &trechos[t].arena);
+                } else {
+                    arena_libera(&trechos[t].arena);
+                }
+                free(trechos[t].processos);
+            }
+        }
+
+        free(threads);
+        free(trechos);
+        munmap(mapa, tamanho);
+    }
+
+    if (stats != NULL) {
+        stats->linhas = count;
+        stats->bytes = tamanho;
+        stats->segundos = agora_segundos() - inicio;
+    }
+    metricas_registra(METRICA_LEITURA, medicao, count);
 
     return count; // Retorna o número de registros lidos
 }
 
+/**
+ * print_estatisticas_leitura - Imprime a vazão da leitura em registros/s e MB/s.
+ * 
+ * @stats: Estatísticas preenchidas por `read_csv_stats`.
+ */
+void print_estatisticas_leitura(const EstatisticasLeitura *stats) {
+    double segundos = stats->segundos > 0 ? stats->segundos : 1e-9;
+
+    printf("Leitura: %lu registros, %lu bytes em %.3f s (%.0f registros/s, %.1f MB/s)\n",
+        stats->linhas,
+        stats->bytes,
+        stats->segundos,
+        (double)stats->linhas / segundos,
+        (double)stats->bytes / segundos / (1024.0 * 1024.0));
+}
+
+/**
+ * data_para_epoch - Converte uma data do calendário civil em segundos desde 1970-01-01 00:00:00.
+ * 
+ * @ano: Ano completo (ex.: 2024).
+ * @mes: Mês de 1 a 12.
+ * @dia: Dia do mês.
+ * @hora, @minuto, @segundo: Horário do dia.
+ * 
+ * A conversão é puramente aritmética e trata a data como UTC, sem consultar o fuso horário
+ * (diferente de `mktime`). Utiliza o algoritmo `days_from_civil` de Howard Hinnant.
+ * 
+ * Retorna o número de segundos desde a época.
+ */
+long long data_para_epoch(int ano, int mes, int dia, int hora, int minuto, int segundo) {
+    long long y = ano - (mes <= 2);
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;                                         // [0, 399]
+    long long doy = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;  // [0, 365]
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                 // [0, 146096]
+    long long dias = era * 146097 + doe - 719468;
+
+    return dias * 86400 + hora * 3600 + minuto * 60 + segundo;
+}
+
+/**
+ * dias_para_data - Converte um número de dias desde 1970-01-01 na data do calendário civil.
+ * 
+ * @dias: Dias desde a época (negativo para datas anteriores).
+ * @ano: Recebe o ano completo.
+ * @mes: Recebe o mês, de 1 a 12.
+ * @dia: Recebe o dia do mês.
+ * 
+ * Inverso de `data_para_epoch` (algoritmo `civil_from_days` de Howard Hinnant).
+ */
+void dias_para_data(long long dias, int *ano, int *mes, int *dia) {
+    long long z = dias + 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long doe = z - era * 146097;                                   // [0, 146096]
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);            // [0, 365]
+    long long mp = (5 * doy + 2) / 153;                                 // [0, 11]
+
+    *dia = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *mes = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *ano = (int)(yoe + era * 400 + (*mes <= 2));
+}
+
+/**
+ * formata_inteiro - Escreve um inteiro em decimal, sem `printf`.
+ * 
+ * @valor: Valor a ser escrito.
+ * @saida: Buffer com pelo menos 11 posições livres; nenhum '\0' é acrescentado.
+ * 
+ * Retorna o ponteiro para a posição logo após o último dígito escrito.
+ */
+char *formata_inteiro(int valor, char *saida) {
+    char digitos[10];
+    int n = 0;
+    unsigned int v = (unsigned int)valor;
+
+    if (valor < 0) {
+        *saida++ = '-';
+        v = 0u - v;
+    }
+    do {
+        digitos[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    while (n > 0) {
+        *saida++ = digitos[--n];
+    }
+    return saida;
+}
+
+/**
+ * formata_timestamp - Escreve um timestamp no formato do CSV, `AAAA-MM-DD hh:mm:ss.mmm`.
+ * 
+ * @timestamp: Milissegundos desde 1970-01-01 (UTC), como em `Processo.timestamp`.
+ * @saida: Buffer com pelo menos 24 posições.
+ * 
+ * Inverso de `data_para_epoch`, com a data obtida por `dias_para_data`. Anos fora do
+ * intervalo 0000-9999 são escritos apenas com os 4 últimos dígitos.
+ */
+void formata_timestamp(long long timestamp, char *saida) {
+    long long ms = timestamp % 1000;
+    long long segundos = timestamp / 1000;
+    if (ms < 0) {
+        ms += 1000;
+        segundos--;
+    }
+    long long dias = segundos / 86400;
+    long long resto = segundos % 86400;
+    if (resto < 0) {
+        resto += 86400;
+        dias--;
+    }
+
+    int ano, mes, dia;
+    dias_para_data(dias, &ano, &mes, &dia);
+
+    int campos[7] = { ano, mes, dia, (int)(resto / 3600), (int)(resto / 60 % 60),
+                      (int)(resto % 60), (int)ms };
+    int larguras[7] = { 4, 2, 2, 2, 2, 2, 3 };
+    const char separadores[7] = { '-', '-', ' ', ':', ':', '.', '\0' };
+
+    // Escreve cada campo com zeros à esquerda, da direita para a esquerda
+    for (int c = 0; c < 7; c++) {
+        int valor = campos[c];
+        for (int d = larguras[c] - 1; d >= 0; d--) {
+            saida[d] = (char)('0' + valor % 10);
+            valor /= 10;
+        }
+        saida += larguras[c];
+        *saida++ = separadores[c];
+    }
+}
+
 /**
  * compara_data - Compara duas estruturas `Processo` com base no campo de data.
  * 
  * @a: Ponteiro para o primeiro elemento a ser comparado.
  * @b: Ponteiro para o segundo elemento a ser comparado.
  * 
- * A função compara as datas dos dois elementos fornecidos. Se uma das datas for `NULL`, 
- * o elemento correspondente será considerado "maior" ou "menor" para fins de ordenação.
+ * A função compara os timestamps calculados na leitura, sem conversões de data por comparação.
+ * A ordem resultante é decrescente: o processo mais recente vem primeiro.
  * 
  * Retorna:
- * - Um valor negativo se `a` for menor que `b`.
- * - Zero se `a` for igual a `b`.
- * - Um valor positivo se `a` for maior que `b`.
+ * - Um valor negativo se `a` for mais recente que `b`.
+ * - Zero se as datas forem iguais.
+ * - Um valor positivo se `a` for mais antigo que `b`.
  */
 int compara_data(const Processo *a, const Processo *b) {
 
-    // Verifica se algum dos campos 'data' é NULL
-    if (b->data == NULL && a->data == NULL) {
-        return 0; // Ambos são NULL, considerados iguais
-    }
-    if (b->data == NULL) {
-        return 1; // Coloca 'b' depois de 'a'
-    }
-    if (a->data == NULL) {
-        return -1; // Coloca 'a' depois de 'b'
-    }
-
-    return (int) difftime(mktime(b->data), mktime(a->data));
+    return (a->timestamp < b->timestamp) - (a->timestamp > b->timestamp);
 
 }
 
@@ -285,6 +1461,7 @@ int compara_id(const Processo *a, const Processo *b) {
  * Retorna o número de processos que possuem a classe especificada.
  */
 int count_id(Processo *processos, long unsigned int processos_size, int id_classe) {
+    long long medicao = metricas_inicio();
     int count = 0;
 
     // Itera sobre os processos no array de processos
@@ -298,6 +1475,7 @@ int count_id(Processo *processos, long unsigned int processos_size, int id_class
         }
     }
 
+    metricas_registra(METRICA_CONSULTA, medicao, processos_size);
     return count; // Retorna o número de processos encontrados
 }
 
@@ -307,44 +1485,63 @@ int count_id(Processo *processos, long unsigned int processos_size, int id_class
  * @processos: Ponteiro para o array de estruturas `Processo` que contém os processos.
  * @processos_size: Tamanho do array de estruturas `Processo`.
  * 
- * A função percorre o array de processos e identifica os assuntos únicos presentes.
- * Para cada registro, verifica se o assunto já foi contabilizado. Se não, adiciona-o
- * à lista de assuntos únicos e incrementa o contador.
+ * A função percorre o array de processos e insere cada assunto em um conjunto de inteiros
+ * (tabela hash), que descarta as repetições em tempo O(1) esperado por inserção.
  * 
- * Retorna o número de assuntos únicos encontrados.
+ * Retorna o número de assuntos únicos encontrados ou 0 se não houver memória.
  */
 long unsigned int count_assuntos(Processo *processos, long unsigned int processos_size) {
-    long unsigned int count = 0;
-    int *assuntos = malloc(processos_size * sizeof(int)); // Aloca memória suficiente para os assuntos únicos
-    int assunto_index = 0;
+    long long medicao = metricas_inicio();
+    ConjuntoInteiros assuntos;
+
+    if (conjunto_inicializa(&assuntos, 1024) != 0) {
+        return 0;
+    }
 
     // Itera sobre os processos no array de processos
     for (long unsigned int i = 0; i < processos_size; i++) {
         for (int j = 0; j < processos[i].assunto_len; j++) {
-            int assunto_atual = processos[i].assunto[j];
-            int encontrado = 0;
-
-            // Verifica se o assunto já foi adicionado
-            for (int k = 0; k < assunto_index; k++) {
-                if (assunto_atual == assuntos[k]) {
-                    encontrado = 1;
-                    break;
-                }
-            }
-
-            // Se não foi encontrado, adiciona ao array de assuntos únicos
-            if (!encontrado) {
-                assuntos[assunto_index] = assunto_atual;
-                assunto_index++;
-                count++;
+            if (conjunto_insere(&assuntos, processos[i].assunto[j]) < 0) {
+                conjunto_libera(&assuntos);
+                return 0;
             }
         }
     }
 
-    free(assuntos); // Libera a memória alocada
+    long unsigned int count = assuntos.tamanho;
+    conjunto_libera(&assuntos); // Libera a memória alocada
+    metricas_registra(METRICA_CONSULTA, medicao, processos_size);
     return count;
 }
 
+/**
+ * count_assuntos_aproximado - Estima o número de assuntos únicos com HyperLogLog.
+ * 
+ * @processos: Ponteiro para o array de estruturas `Processo` que contém os processos.
+ * @processos_size: Tamanho do array de estruturas `Processo`.
+ * @precisao: Precisão do estimador (4 a 18); 14 usa 16 KB e tem erro padrão de ~0.8%.
+ * 
+ * A memória usada é constante, independentemente do número de assuntos distintos.
+ * 
+ * Retorna a estimativa do número de assuntos únicos ou 0 se a precisão for inválida.
+ */
+long unsigned int count_assuntos_aproximado(Processo *processos, long unsigned int processos_size, int precisao) {
+    HyperLogLog hll;
+
+    if (hll_inicializa(&hll, precisao) != 0) {
+        return 0;
+    }
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        for (int j = 0; j < processos[i].assunto_len; j++) {
+            hll_adiciona(&hll, processos[i].assunto[j]);
+        }
+    }
+
+    long unsigned int estimativa = (long unsigned int)(hll_estimativa(&hll) + 0.5);
+    hll_libera(&hll);
+    return estimativa;
+}
+
 /**
  * mais_de_um_assunto - Conta o número de processos que possuem mais de um assunto associado.
  * 
@@ -356,6 +1553,7 @@ long unsigned int count_assuntos(Processo *processos, long unsigned int processo
  * Retorna o número de processos que possuem mais de um assunto.
  */
 int mais_de_um_assunto(Processo *processos, long unsigned int processos_size) {
+    long long medicao = metricas_inicio();
     int count = 0;
 
     // Itera sobre os processos no array de processos
@@ -366,6 +1564,7 @@ int mais_de_um_assunto(Processo *processos, long unsigned int processos_size) {
         }
     }
 
+    metricas_registra(METRICA_CONSULTA, medicao, processos_size);
     return count; // Retorna o número de processos encontrados
 }
 
@@ -376,9 +1575,10 @@ int mais_de_um_assunto(Processo *processos, long unsigned int processos_size) {
  * @processos_size: Tamanho do array de estruturas `Processo`.
  * @id: ID do registro cuja diferença de dias será calculada.
  * 
- * A função encontra o registro com o ID especificado, obtém sua data e calcula a diferença
- * em dias em relação à data atual. Se o ID não for encontrado ou a data for inválida, a função
- * retorna valores específicos para indicar essas condições.
+ * A função encontra o registro com o ID especificado e calcula, a partir do timestamp calculado
+ * na leitura, a diferença em dias em relação à data atual. O registro não é modificado. Se o ID
+ * não for encontrado ou a data for inválida, a função retorna valores específicos para indicar
+ * essas condições.
  * 
  * Retorna:
  * - A diferença em dias entre a data atual e a data do registro.
@@ -386,6 +1586,7 @@ int mais_de_um_assunto(Processo *processos, long unsigned int processos_size) {
  * - -2 se a data do registro for inválida.
  */
 int count_dias(Processo *processos, long unsigned int processos_size, int id) {
+    long long medicao = metricas_inicio();
     long int index = -1;
 
     // Encontra o índice do registro com o ID especificado
@@ -395,33 +1596,47 @@ int count_dias(Processo *processos, long unsigned int processos_size, int id) {
             break;
         }
     }
+    metricas_registra(METRICA_CONSULTA, medicao, index == -1 ? processos_size : (long unsigned int)index + 1);
 
     // Se o ID não foi encontrado, retorna -1
     if (index == -1) {
         return -1;
     }
 
-    // Obtém a data atual
-    time_t now = time(NULL);
+    // Obtém a data atual em milissegundos e calcula a diferença
+    return dias_em_tramitacao(&processos[index], (long long)time(NULL) * 1000);
+}
 
-    // Obtém a data do registro
-    struct tm *data_processos = processos[index].data;
-    if (data_processos == NULL) {
+/**
+ * dias_em_tramitacao - Calcula há quantos dias um processo foi ajuizado.
+ * 
+ * @processo: Processo consultado; não é modificado.
+ * @agora: Instante de referência em milissegundos desde 1970-01-01 (UTC).
+ * 
+ * Retorna a diferença em dias completos ou -2 se a data do registro for inválida.
+ */
+int dias_em_tramitacao(const Processo *processo, long long agora) {
+    // Verifica se a data do registro é válida
+    if (processo->data == NULL) {
         return -2; // Retorna -2 se a data for inválida
     }
 
-    // Ajusta os campos da estrutura `tm` para o formato correto
-    data_processos->tm_year -= 1900; // O ano é contado a partir de 1900
-    data_processos->tm_mon -= 1;     // O mês é contado a partir de 0
-
-    // Converte a data do registro para `time_t`
-    time_t data_time = mktime(data_processos);
-
-    // Calcula a diferença em segundos e converte para dias
-    double diff_seconds = difftime(now, data_time);
-    int diff_days = (int)(diff_seconds / (60 * 60 * 24));
+    // Calcula a diferença em milissegundos e converte para dias
+    return (int)((agora - processo->timestamp) / (1000LL * 60 * 60 * 24));
+}
 
-    return diff_days; // Retorna a diferença em dias
+/**
+ * quicksort_intervalo - Recursão do QuickSort; `quicksort` apenas a envolve com a medição de tempo.
+ */
+static void quicksort_intervalo(Processo *vetor, int inf, int sup, int (*compara)(const Processo *, const Processo *)) {
+    if (inf < sup) {
+        // Encontra o pivô
+        int p = partition(vetor, inf, sup, compara);
+        // Ordena os elementos antes e depois da partição
+        quicksort_intervalo(vetor, inf, p - 1, compara);
+        // quicksort(vetor, p + 1, sup, compara);
+        quicksort_intervalo(vetor, p , sup, compara);
+    }
 }
 
 /**
@@ -441,14 +1656,9 @@ int count_dias(Processo *processos, long unsigned int processos_size, int id) {
  * Retorna: Nada. O vetor é ordenado diretamente na memória.
  */
 void quicksort(Processo *vetor, int inf, int sup, int (*compara)(const Processo *, const Processo *)) {
-    if (inf < sup) {
-        // Encontra o pivô
-        int p = partition(vetor, inf, sup, compara);
-        // Ordena os elementos antes e depois da partição
-        quicksort(vetor, inf, p - 1, compara);
-        // quicksort(vetor, p + 1, sup, compara);
-        quicksort(vetor, p , sup, compara);
-    }
+    long long medicao = metricas_inicio();
+    quicksort_intervalo(vetor, inf, sup, compara);
+    metricas_registra(METRICA_ORDENACAO, medicao, sup >= inf ? (long unsigned int)(sup - inf + 1) : 0);
 }
 
 /**
@@ -6,6 +6,8 @@
 #include<string.h>
 #include<time.h>
 
+#include "arena.h"
+
 // Definições de padrões de formatação para análise de linhas CSV
 // PARSE_1: Formato básico com campos separados por vírgulas e chaves
 // PARSE_2: Formato com aspas ao redor do campo classe (multiplas classes)
@@ -16,11 +18,38 @@
 #define PARSE_3 "%d,\"%[^\"]\",%[^,],%*1[\"]{%[^}]}%*1[\"],{%[^}]},%d" // {},"{}"
 #define PARSE_4 "%d,\"%[^\"]\",%[^,],%*1[\"]{%[^}]}%*1[\"],%*1[\"]{%[^}]}%*1[\"],%d" // "{}","{}"
 
+// Cabeçalho dos CSVs exportados
+#define CABECALHO_CSV "id;numero;data_ajuizamento;id_classe;id_assunto;ano_eleicao\n"
+
+// Espaço reservado para um registro exportado (maior que qualquer linha possível)
+#define MAX_LINHA_CSV 256
+
+// Numeração única do CNJ: 20 dígitos (NNNNNNN DD AAAA J TR OOOO), sem pontuação
+#define NUMERO_DIGITOS 20
+
+// Maior texto guardado para um `numero` fora do formato (o limite do antigo campo char[30])
+#define NUMERO_MAX_TEXTO 29
+
+// Marca, em `NumeroProcesso.prefixo`, um número guardado como texto
+#define NUMERO_TEXTO 0xFFFFFFFFu
+
+// Campo `numero` compactado em 16 bytes: os 2 primeiros dígitos ficam em `prefixo` e os 18
+// últimos em `digitos` (menor que 10^18). Um número que não tenha exatamente 20 dígitos
+// continua em texto, reservado na arena do registro, para que a saída seja sempre a original.
+typedef struct {
+    union {
+        unsigned long long digitos; // 18 últimos dígitos
+        const char *texto;          // Texto original, quando `prefixo == NUMERO_TEXTO`
+    };
+    unsigned int prefixo;           // 2 primeiros dígitos (0 a 99) ou NUMERO_TEXTO
+} NumeroProcesso;
+
 // Estrutura que representa os processos de um registro no CSV
 typedef struct {
     int id;                     // ID do registro
-    char numero[30];            // Código associado ao registro
+    NumeroProcesso numero;      // Código associado ao registro (compactado na leitura)
     struct tm* data;            // Data do registro (formato estruturado)
+    long long timestamp;        // Data do registro em milissegundos desde 1970-01-01 (UTC)
     char data_string[30];       // Data do registro (formato string)
     char classe_string[30];     // Classe do registro (formato string)
     int* classe;                // Array de IDs de classe
@@ -31,17 +60,46 @@ typedef struct {
     int ano_eleicao;            // Ano da eleição associado ao registro
 } Processo;
 
-int parse_itens(char *processos, int** items, int *item_count);
+// Estatísticas de vazão coletadas durante a leitura do CSV
+typedef struct {
+    long unsigned int linhas;   // Número de registros lidos
+    long unsigned int bytes;    // Tamanho do arquivo em bytes
+    double segundos;            // Tempo total de leitura e análise
+} EstatisticasLeitura;
+
+int parse_itens(char *processos, int** items, int *item_count, Arena *arena);
 void print_processos(Processo **processos, long unsigned int offset, long unsigned int amount);
 void export_csv(const char *nome_arquivo, Processo **processos, long unsigned int offset, long unsigned int amount);
-int parse_line(const char *linha, Processo *processos);
-long unsigned int read_csv(const char *nome_arquivo, Processo **processos);
+void export_csv_indices(const char *nome_arquivo, const Processo *processos, const long unsigned int *indices,
+                        long unsigned int amount);
+int escreve_tudo(int fd, const char *dados, size_t tamanho);
+int numero_compacta(const char *inicio, const char *fim, NumeroProcesso *numero, Arena *arena);
+int numero_de_texto(const char *texto, NumeroProcesso *numero);
+char *numero_formata(char *saida, const NumeroProcesso *numero);
+void numero_para_texto(const NumeroProcesso *numero, char *saida);
+int numero_iguais(const NumeroProcesso *a, const NumeroProcesso *b);
+char *formata_registro_csv(char *p, const Processo *processo);
+int parse_line(const char *linha, Processo *processos, Arena *arena);
+int parse_registro(const char *inicio, const char *fim, Processo *processo, Arena *arena);
+long unsigned int read_csv(const char *nome_arquivo, Processo **processos, Arena *arena);
+long unsigned int read_csv_stats(const char *nome_arquivo, Processo **processos, Arena *arena,
+                                 EstatisticasLeitura *stats);
+long unsigned int read_csv_paralelo(const char *nome_arquivo, Processo **processos, Arena *arena,
+                                    int num_threads, EstatisticasLeitura *stats);
+void print_estatisticas_leitura(const EstatisticasLeitura *stats);
+double agora_segundos(void);
+long long data_para_epoch(int ano, int mes, int dia, int hora, int minuto, int segundo);
+void dias_para_data(long long dias, int *ano, int *mes, int *dia);
+void formata_timestamp(long long timestamp, char *saida);
+char *formata_inteiro(int valor, char *saida);
 int compara_data(const Processo *a, const Processo *b);
 int compara_id(const Processo *a, const Processo *b);
 int count_id(Processo *processos, long unsigned int processos_size, int id_classe);
 long unsigned int count_assuntos(Processo *processos, long unsigned int processos_size);
+long unsigned int count_assuntos_aproximado(Processo *processos, long unsigned int processos_size, int precisao);
 int mais_de_um_assunto(Processo *processos, long unsigned int processos_size);
 int count_dias(Processo *processos, long unsigned int processos_size, int id);
+int dias_em_tramitacao(const Processo *processo, long long agora);
 
 void quicksort(Processo *vetor, int inf, int sup, int (*compara)(const Processo *, const Processo *));
 int partition(Processo *vetor, int inf, int sup, int (*compara)(const Processo *, const Processo *));
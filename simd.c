@@ -0,0 +1,350 @@
+#include "simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#endif
+
+/**
+ * simd_detecta - Identifica o melhor conjunto de instruções suportado pela CPU em execução.
+ * 
+ * O resultado é calculado uma única vez. Os kernels vetoriais são compilados com atributos
+ * `target`, de modo que o binário não exige -mavx2 e continua funcionando em CPUs antigas.
+ */
+NivelSimd simd_detecta(void) {
+    static int nivel = -1;
+
+    if (nivel < 0) {
+        nivel = SIMD_ESCALAR;
+#ifdef SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            nivel = SIMD_AVX2;
+        } else if (__builtin_cpu_supports("sse4.2")) {
+            nivel = SIMD_SSE42;
+        }
+#endif
+    }
+    return (NivelSimd)nivel;
+}
+
+/**
+ * simd_nome - Nome legível de um nível.
+ */
+const char *simd_nome(NivelSimd nivel) {
+    switch (nivel) {
+        case SIMD_AVX2: return "AVX2";
+        case SIMD_SSE42: return "SSE4.2";
+        default: return "escalar";
+    }
+}
+
+/**
+ * limita_nivel - Rebaixa `nivel` para o que a CPU suporta.
+ */
+static NivelSimd limita_nivel(NivelSimd nivel) {
+    NivelSimd suportado = simd_detecta();
+    return nivel > suportado ? suportado : nivel;
+}
+
+/**
+ * registro_de - Encontra o registro que contém a posição `j` do array de valores.
+ * 
+ * Como as posições chegam em ordem crescente, a busca parte de `inicio` (o registro seguinte ao
+ * da posição anterior) com passos que dobram e termina com uma busca binária: posições densas
+ * custam O(1) e posições esparsas, O(log) da distância.
+ */
+static long unsigned int registro_de(const long unsigned int *offset, long unsigned int inicio,
+                                     long unsigned int registros, long unsigned int j) {
+    long unsigned int baixo = inicio;
+    long unsigned int passo = 1;
+
+    // Invariante: offset[baixo] <= j; procura o maior r em [inicio, registros) com offset[r] <= j
+    while (baixo + passo < registros && offset[baixo + passo] <= j) {
+        baixo += passo;
+        passo *= 2;
+    }
+    long unsigned int alto = baixo + passo < registros ? baixo + passo : registros;
+    while (alto - baixo > 1) {
+        long unsigned int meio = baixo + (alto - baixo) / 2;
+        if (offset[meio] <= j) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    return baixo;
+}
+
+// Contagem de registros distintos a partir das posições encontradas, em ordem crescente
+typedef struct {
+    const long unsigned int *offset;
+    long unsigned int registros;
+    long unsigned int atual;        // Registro da última posição
+    long unsigned int contados;     // Registros distintos contados
+    int algum;                      // Já houve alguma posição
+} ContagemRegistros;
+
+static inline void registra_posicao(ContagemRegistros *contagem, long unsigned int j) {
+    // Posições do mesmo registro são comuns (listas com vários itens): evita a busca
+    if (contagem->algum && j < contagem->offset[contagem->atual + 1]) {
+        return;
+    }
+    contagem->atual = registro_de(contagem->offset, contagem->algum ? contagem->atual + 1 : 0,
+                                  contagem->registros, j);
+    contagem->algum = 1;
+    contagem->contados++;
+}
+
+static int pertence(int valor, const int *conjunto, int tamanho_conjunto) {
+    for (int c = 0; c < tamanho_conjunto; c++) {
+        if (valor == conjunto[c]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Kernels escalares
+
+static long unsigned int conta_iguais_escalar(const int *valores, long unsigned int n, int alvo) {
+    long unsigned int count = 0;
+    for (long unsigned int i = 0; i < n; i++) {
+        count += valores[i] == alvo;
+    }
+    return count;
+}
+
+static void marca_escalar(ContagemRegistros *contagem, const int *valores, long unsigned int inicio,
+                          long unsigned int n, const int *conjunto, int tamanho_conjunto) {
+    for (long unsigned int j = inicio; j < n; j++) {
+        if (pertence(valores[j], conjunto, tamanho_conjunto)) {
+            registra_posicao(contagem, j);
+        }
+    }
+}
+
+static long unsigned int conta_tamanho_maior_escalar(const long unsigned int *offset, long unsigned int inicio,
+                                                     long unsigned int registros, long unsigned int limiar) {
+    long unsigned int count = 0;
+    for (long unsigned int i = inicio; i < registros; i++) {
+        count += offset[i + 1] - offset[i] > limiar;
+    }
+    return count;
+}
+
+#ifdef SIMD_X86
+
+// Kernels SSE4.2 (4 inteiros de 32 bits ou 2 deslocamentos de 64 bits por vetor)
+
+__attribute__((target("sse4.2")))
+static long unsigned int conta_iguais_sse42(const int *valores, long unsigned int n, int alvo) {
+    const __m128i chave = _mm_set1_epi32(alvo);
+    __m128i acumulado = _mm_setzero_si128();
+    long unsigned int count = 0;
+    long unsigned int i = 0;
+
+    // Cada igualdade vale -1 na faixa correspondente; o acumulador é esvaziado antes de transbordar
+    while (i + 4 <= n) {
+        long unsigned int fim = n - (n - i) % 4;
+        if (fim - i > ((long unsigned int)1 << 30)) {
+            fim = i + ((long unsigned int)1 << 30);
+        }
+        for (; i < fim; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(valores + i));
+            acumulado = _mm_sub_epi32(acumulado, _mm_cmpeq_epi32(v, chave));
+        }
+        unsigned int faixas[4];
+        _mm_storeu_si128((__m128i *)faixas, acumulado);
+        count += (long unsigned int)faixas[0] + faixas[1] + faixas[2] + faixas[3];
+        acumulado = _mm_setzero_si128();
+    }
+    return count + conta_iguais_escalar(valores + i, n - i, alvo);
+}
+
+__attribute__((target("sse4.2")))
+static void marca_sse42(ContagemRegistros *contagem, const int *valores, long unsigned int n,
+                        const int *conjunto, int tamanho_conjunto) {
+    __m128i chaves[SIMD_MAX_CONJUNTO];
+    for (int c = 0; c < tamanho_conjunto; c++) {
+        chaves[c] = _mm_set1_epi32(conjunto[c]);
+    }
+
+    long unsigned int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(valores + i));
+        __m128i iguais = _mm_setzero_si128();
+        for (int c = 0; c < tamanho_conjunto; c++) {
+            iguais = _mm_or_si128(iguais, _mm_cmpeq_epi32(v, chaves[c]));
+        }
+        unsigned int mascara = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(iguais));
+        while (mascara != 0) {
+            registra_posicao(contagem, i + (long unsigned int)__builtin_ctz(mascara));
+            mascara &= mascara - 1;
+        }
+    }
+    marca_escalar(contagem, valores, i, n, conjunto, tamanho_conjunto);
+}
+
+__attribute__((target("sse4.2")))
+static long unsigned int conta_tamanho_maior_sse42(const long unsigned int *offset, long unsigned int registros,
+                                                   long unsigned int limiar) {
+    const __m128i limite = _mm_set1_epi64x((long long)limiar);
+    long unsigned int count = 0;
+    long unsigned int i = 0;
+
+    // Tamanhos de listas cabem com folga em 63 bits, então a comparação com sinal é segura
+    for (; i + 2 <= registros; i += 2) {
+        __m128i inicio = _mm_loadu_si128((const __m128i *)(offset + i));
+        __m128i fim = _mm_loadu_si128((const __m128i *)(offset + i + 1));
+        __m128i maior = _mm_cmpgt_epi64(_mm_sub_epi64(fim, inicio), limite);
+        count += (long unsigned int)__builtin_popcount((unsigned int)_mm_movemask_pd(_mm_castsi128_pd(maior)));
+    }
+    return count + conta_tamanho_maior_escalar(offset, i, registros, limiar);
+}
+
+// Kernels AVX2 (8 inteiros de 32 bits ou 4 deslocamentos de 64 bits por vetor)
+
+__attribute__((target("avx2")))
+static long unsigned int conta_iguais_avx2(const int *valores, long unsigned int n, int alvo) {
+    const __m256i chave = _mm256_set1_epi32(alvo);
+    __m256i acumulado = _mm256_setzero_si256();
+    long unsigned int count = 0;
+    long unsigned int i = 0;
+
+    while (i + 8 <= n) {
+        long unsigned int fim = n - (n - i) % 8;
+        if (fim - i > ((long unsigned int)1 << 31)) {
+            fim = i + ((long unsigned int)1 << 31);
+        }
+        for (; i < fim; i += 8) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(valores + i));
+            acumulado = _mm256_sub_epi32(acumulado, _mm256_cmpeq_epi32(v, chave));
+        }
+        unsigned int faixas[8];
+        _mm256_storeu_si256((__m256i *)faixas, acumulado);
+        for (int f = 0; f < 8; f++) {
+            count += faixas[f];
+        }
+        acumulado = _mm256_setzero_si256();
+    }
+    return count + conta_iguais_escalar(valores + i, n - i, alvo);
+}
+
+__attribute__((target("avx2")))
+static void marca_avx2(ContagemRegistros *contagem, const int *valores, long unsigned int n,
+                       const int *conjunto, int tamanho_conjunto) {
+    __m256i chaves[SIMD_MAX_CONJUNTO];
+    for (int c = 0; c < tamanho_conjunto; c++) {
+        chaves[c] = _mm256_set1_epi32(conjunto[c]);
+    }
+
+    long unsigned int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(valores + i));
+        __m256i iguais = _mm256_setzero_si256();
+        for (int c = 0; c < tamanho_conjunto; c++) {
+            iguais = _mm256_or_si256(iguais, _mm256_cmpeq_epi32(v, chaves[c]));
+        }
+        unsigned int mascara = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(iguais));
+        while (mascara != 0) {
+            registra_posicao(contagem, i + (long unsigned int)__builtin_ctz(mascara));
+            mascara &= mascara - 1;
+        }
+    }
+    marca_escalar(contagem, valores, i, n, conjunto, tamanho_conjunto);
+}
+
+__attribute__((target("avx2")))
+static long unsigned int conta_tamanho_maior_avx2(const long unsigned int *offset, long unsigned int registros,
+                                                  long unsigned int limiar) {
+    const __m256i limite = _mm256_set1_epi64x((long long)limiar);
+    long unsigned int count = 0;
+    long unsigned int i = 0;
+
+    for (; i + 4 <= registros; i += 4) {
+        __m256i inicio = _mm256_loadu_si256((const __m256i *)(offset + i));
+        __m256i fim = _mm256_loadu_si256((const __m256i *)(offset + i + 1));
+        __m256i maior = _mm256_cmpgt_epi64(_mm256_sub_epi64(fim, inicio), limite);
+        count += (long unsigned int)__builtin_popcount((unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(maior)));
+    }
+    return count + conta_tamanho_maior_escalar(offset, i, registros, limiar);
+}
+
+#endif
+
+/**
+ * simd_conta_iguais - Conta os elementos de `valores` iguais a `alvo`.
+ * 
+ * @valores: Array de inteiros (por exemplo, `classe_valores` da base colunar).
+ * @n: Número de elementos.
+ * @alvo: Valor procurado.
+ * @nivel: Conjunto de instruções desejado; é rebaixado se a CPU não o suportar.
+ * 
+ * Retorna o número de ocorrências.
+ */
+long unsigned int simd_conta_iguais(const int *valores, long unsigned int n, int alvo, NivelSimd nivel) {
+    switch (limita_nivel(nivel)) {
+#ifdef SIMD_X86
+        case SIMD_AVX2: return conta_iguais_avx2(valores, n, alvo);
+        case SIMD_SSE42: return conta_iguais_sse42(valores, n, alvo);
+#endif
+        default: return conta_iguais_escalar(valores, n, alvo);
+    }
+}
+
+/**
+ * simd_conta_registros_com - Conta os registros cuja lista contém algum valor de `conjunto`.
+ * 
+ * @offset: Deslocamentos CSR (`registros + 1` posições).
+ * @registros: Número de registros.
+ * @valores: Valores concatenados das listas.
+ * @conjunto: Valores procurados.
+ * @tamanho_conjunto: Número de valores procurados (no máximo `SIMD_MAX_CONJUNTO`).
+ * @nivel: Conjunto de instruções desejado; é rebaixado se a CPU não o suportar.
+ * 
+ * O array de valores é varrido de forma contígua, comparando cada vetor com todos os valores
+ * do conjunto; só as posições encontradas são convertidas em registros (por busca binária nos
+ * deslocamentos), e cada registro é contado uma única vez.
+ * 
+ * Retorna o número de registros encontrados.
+ */
+long unsigned int simd_conta_registros_com(const long unsigned int *offset, long unsigned int registros,
+                                           const int *valores, const int *conjunto, int tamanho_conjunto,
+                                           NivelSimd nivel) {
+    ContagemRegistros contagem = {offset, registros, 0, 0, 0};
+    long unsigned int n = offset[registros];
+
+    if (tamanho_conjunto > SIMD_MAX_CONJUNTO) {
+        nivel = SIMD_ESCALAR;
+    }
+    switch (limita_nivel(nivel)) {
+#ifdef SIMD_X86
+        case SIMD_AVX2: marca_avx2(&contagem, valores, n, conjunto, tamanho_conjunto); break;
+        case SIMD_SSE42: marca_sse42(&contagem, valores, n, conjunto, tamanho_conjunto); break;
+#endif
+        default: marca_escalar(&contagem, valores, 0, n, conjunto, tamanho_conjunto); break;
+    }
+    return contagem.contados;
+}
+
+/**
+ * simd_conta_tamanho_maior - Conta os registros cuja lista tem mais de `limiar` itens.
+ * 
+ * @offset: Deslocamentos CSR (`registros + 1` posições).
+ * @registros: Número de registros.
+ * @limiar: Tamanho mínimo (exclusivo); `mais_de_um_assunto` usa 1.
+ * @nivel: Conjunto de instruções desejado; é rebaixado se a CPU não o suportar.
+ * 
+ * Retorna o número de registros com `offset[i + 1] - offset[i] > limiar`.
+ */
+long unsigned int simd_conta_tamanho_maior(const long unsigned int *offset, long unsigned int registros,
+                                           long unsigned int limiar, NivelSimd nivel) {
+    switch (limita_nivel(nivel)) {
+#ifdef SIMD_X86
+        case SIMD_AVX2: return conta_tamanho_maior_avx2(offset, registros, limiar);
+        case SIMD_SSE42: return conta_tamanho_maior_sse42(offset, registros, limiar);
+#endif
+        default: return conta_tamanho_maior_escalar(offset, 0, registros, limiar);
+    }
+}
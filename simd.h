@@ -0,0 +1,25 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stddef.h>
+
+// Conjunto de instruções usado pelos kernels de varredura
+typedef enum {
+    SIMD_ESCALAR = 0,   // C puro, disponível em qualquer arquitetura
+    SIMD_SSE42 = 1,     // Vetores de 128 bits (4 inteiros ou 2 deslocamentos)
+    SIMD_AVX2 = 2       // Vetores de 256 bits (8 inteiros ou 4 deslocamentos)
+} NivelSimd;
+
+// Maior conjunto aceito por `simd_conta_registros_com`
+#define SIMD_MAX_CONJUNTO 16
+
+NivelSimd simd_detecta(void);
+const char *simd_nome(NivelSimd nivel);
+
+long unsigned int simd_conta_iguais(const int *valores, long unsigned int n, int alvo, NivelSimd nivel);
+long unsigned int simd_conta_registros_com(const long unsigned int *offset, long unsigned int registros,
+                                           const int *valores, const int *conjunto, int tamanho_conjunto,
+                                           NivelSimd nivel);
+long unsigned int simd_conta_tamanho_maior(const long unsigned int *offset, long unsigned int registros,
+                                           long unsigned int limiar, NivelSimd nivel);
+#endif
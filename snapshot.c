@@ -0,0 +1,468 @@
+#include "snapshot.h"
+#include "metricas.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// As colunas de deslocamento são gravadas como inteiros de 64 bits
+_Static_assert(sizeof(long unsigned int) == sizeof(unsigned long long),
+               "o snapshot exige long unsigned int de 64 bits");
+
+/**
+ * alinha8 - Arredonda um tamanho para o próximo múltiplo de 8.
+ */
+static size_t alinha8(size_t tamanho) {
+    return (tamanho + 7) & ~(size_t)7;
+}
+
+/**
+ * acumula_checksum - Atualiza a soma de verificação (FNV-1a sobre palavras de 64 bits).
+ * 
+ * @checksum: Valor acumulado.
+ * @dados: Bloco com `tamanho` múltiplo de 8 bytes.
+ */
+unsigned long long acumula_checksum(unsigned long long checksum, const void *dados, size_t tamanho) {
+    const unsigned char *p = dados;
+
+    for (size_t i = 0; i < tamanho; i += 8) {
+        unsigned long long palavra;
+        memcpy(&palavra, p + i, 8);
+        checksum = (checksum ^ palavra) * 0x100000001b3ULL;
+    }
+    return checksum;
+}
+
+/**
+ * escreve_secao - Grava uma coluna completando-a com zeros até um múltiplo de 8 bytes.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro de escrita.
+ */
+static int escreve_secao(FILE *file, const void *dados, size_t tamanho, unsigned long long *checksum,
+                         unsigned long long *total) {
+    static const char zeros[8] = { 0 };
+    size_t preenchimento = alinha8(tamanho) - tamanho;
+
+    if (tamanho > 0 && fwrite(dados, 1, tamanho, file) != tamanho) {
+        return -1;
+    }
+    if (preenchimento > 0 && fwrite(zeros, 1, preenchimento, file) != preenchimento) {
+        return -1;
+    }
+
+    // A soma de verificação é calculada sobre as palavras inteiras, incluindo o preenchimento
+    size_t inteiro = tamanho - tamanho % 8;
+    *checksum = acumula_checksum(*checksum, dados, inteiro);
+    if (preenchimento > 0) {
+        unsigned char ultima[8] = { 0 };
+        memcpy(ultima, (const char *)dados + inteiro, tamanho - inteiro);
+        *checksum = acumula_checksum(*checksum, ultima, 8);
+    }
+    *total += alinha8(tamanho);
+    return 0;
+}
+
+/**
+ * dados_origem - Obtém o tamanho e a data de modificação do CSV de origem.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se o arquivo não existir.
+ */
+static int dados_origem(const char *csv_origem, unsigned long long *tamanho, long long *modificacao) {
+    struct stat st;
+
+    *tamanho = 0;
+    *modificacao = 0;
+    if (csv_origem == NULL) {
+        return 0;
+    }
+    if (stat(csv_origem, &st) == -1) {
+        return -1;
+    }
+    *tamanho = (unsigned long long)st.st_size;
+    *modificacao = (long long)st.st_mtime;
+    return 0;
+}
+
+// Campos em texto guardados como estavam no CSV, na ordem em que aparecem na coluna `texto`
+#define SNAPSHOT_CAMPOS_TEXTO 3
+
+/**
+ * campos_texto - Preenche os campos em texto de um registro, na ordem da coluna `texto`.
+ */
+static void campos_texto(const Processo *processo, const char *campos[SNAPSHOT_CAMPOS_TEXTO]) {
+    campos[0] = processo->data_string;
+    campos[1] = processo->classe_string;
+    campos[2] = processo->assunto_string;
+}
+
+/**
+ * junta_textos - Escreve os campos em texto de um registro, cada um terminado por '\0'.
+ * 
+ * @saida: Buffer de destino; se NULL, apenas mede.
+ * 
+ * Retorna o número de bytes do registro na coluna `texto`.
+ */
+static size_t junta_textos(const Processo *processo, char *saida) {
+    const char *campos[SNAPSHOT_CAMPOS_TEXTO];
+    size_t total = 0;
+
+    campos_texto(processo, campos);
+    for (int c = 0; c < SNAPSHOT_CAMPOS_TEXTO; c++) {
+        size_t tamanho = strnlen(campos[c], sizeof(processo->data_string) - 1);
+        if (saida != NULL) {
+            memcpy(saida + total, campos[c], tamanho);
+            saida[total + tamanho] = '\0';
+        }
+        total += tamanho + 1;
+    }
+    return total;
+}
+
+/**
+ * snapshot_salva - Grava a base de processos em formato binário colunar.
+ * 
+ * @nome_arquivo: Nome do snapshot a ser criado.
+ * @processos: Ponteiro para o array de estruturas `Processo`.
+ * @processos_size: Tamanho do array de estruturas `Processo`.
+ * @csv_origem: CSV de onde a base foi lida (pode ser NULL). Seu tamanho e data de modificação
+ *              são registrados no cabeçalho para que um snapshot desatualizado seja rejeitado.
+ * 
+ * O arquivo é escrito em um nome temporário e renomeado ao final, de modo que um snapshot
+ * incompleto nunca substitui um válido.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 em caso de erro.
+ */
+int snapshot_salva(const char *nome_arquivo, const Processo *processos, long unsigned int processos_size,
+                   const char *csv_origem) {
+    ProcessosColunar colunar;
+    CabecalhoSnapshot cabecalho;
+    char temporario[4096];
+
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, SNAPSHOT_MAGICA, sizeof(cabecalho.magica));
+    cabecalho.versao = SNAPSHOT_VERSAO;
+    cabecalho.tamanho_cabecalho = sizeof(CabecalhoSnapshot);
+    if (dados_origem(csv_origem, &cabecalho.tamanho_origem, &cabecalho.modificacao_origem) != 0) {
+        return -1;
+    }
+
+    if (colunar_constroi(processos, processos_size, &colunar) != 0) {
+        return -1;
+    }
+    char *numeros = calloc(processos_size > 0 ? processos_size : 1, SNAPSHOT_LARGURA_NUMERO);
+    long unsigned int *texto_offset = malloc((processos_size + 1) * sizeof(long unsigned int));
+    if (numeros == NULL || texto_offset == NULL) {
+        free(numeros);
+        free(texto_offset);
+        colunar_libera(&colunar);
+        return -1;
+    }
+    texto_offset[0] = 0;
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        numero_para_texto(&processos[i].numero, &numeros[i * SNAPSHOT_LARGURA_NUMERO]);
+        texto_offset[i + 1] = texto_offset[i] + junta_textos(&processos[i], NULL);
+    }
+    char *texto = malloc(texto_offset[processos_size] > 0 ? texto_offset[processos_size] : 1);
+    if (texto == NULL) {
+        free(numeros);
+        free(texto_offset);
+        colunar_libera(&colunar);
+        return -1;
+    }
+    for (long unsigned int i = 0; i < processos_size; i++) {
+        junta_textos(&processos[i], texto + texto_offset[i]);
+    }
+
+    cabecalho.registros = processos_size;
+    cabecalho.total_classes = colunar.classe_offset[processos_size];
+    cabecalho.total_assuntos = colunar.assunto_offset[processos_size];
+    cabecalho.total_texto = texto_offset[processos_size];
+
+    snprintf(temporario, sizeof(temporario), "%s.tmp", nome_arquivo);
+    FILE *file = fopen(temporario, "wb");
+    if (file == NULL) {
+        free(numeros);
+        free(texto_offset);
+        free(texto);
+        colunar_libera(&colunar);
+        return -1;
+    }
+
+    // Reserva o espaço do cabeçalho; ele é regravado com a soma de verificação no final
+    int erro = fwrite(&cabecalho, sizeof(cabecalho), 1, file) != 1;
+    unsigned long long checksum = 0xcbf29ce484222325ULL;
+    unsigned long long total = 0;
+    long unsigned int n = processos_size;
+
+    erro = erro || escreve_secao(file, colunar.id, n * sizeof(int), &checksum, &total);
+    erro = erro || escreve_secao(file, colunar.timestamp, n * sizeof(long long), &checksum, &total);
+    erro = erro || escreve_secao(file, colunar.ano_eleicao, n * sizeof(int), &checksum, &total);
+    erro = erro || escreve_secao(file, numeros, n * SNAPSHOT_LARGURA_NUMERO, &checksum, &total);
+    erro = erro || escreve_secao(file, colunar.classe_offset, (n + 1) * sizeof(long unsigned int), &checksum, &total);
+    erro = erro || escreve_secao(file, colunar.classe_valores, cabecalho.total_classes * sizeof(int), &checksum, &total);
+    erro = erro || escreve_secao(file, colunar.assunto_offset, (n + 1) * sizeof(long unsigned int), &checksum, &total);
+    erro = erro || escreve_secao(file, colunar.assunto_valores, cabecalho.total_assuntos * sizeof(int), &checksum, &total);
+    erro = erro || escreve_secao(file, texto_offset, (n + 1) * sizeof(long unsigned int), &checksum, &total);
+    erro = erro || escreve_secao(file, texto, cabecalho.total_texto, &checksum, &total);
+
+    cabecalho.tamanho_dados = total;
+    cabecalho.checksum = checksum;
+    erro = erro || fseek(file, 0, SEEK_SET) != 0;
+    erro = erro || fwrite(&cabecalho, sizeof(cabecalho), 1, file) != 1;
+    erro = fclose(file) != 0 || erro;
+
+    free(numeros);
+    free(texto_offset);
+    free(texto);
+    colunar_libera(&colunar);
+
+    if (erro || rename(temporario, nome_arquivo) != 0) {
+        unlink(temporario);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * snapshot_abre - Mapeia um snapshot em memória e valida seu conteúdo.
+ * 
+ * @nome_arquivo: Nome do snapshot.
+ * @csv_origem: CSV esperado como origem (pode ser NULL para não verificar).
+ * @snapshot: Estrutura que receberá o mapeamento e as colunas.
+ * 
+ * O snapshot é rejeitado se a assinatura, a versão ou os tamanhos não conferirem, se a soma de
+ * verificação não bater (arquivo corrompido) ou se o CSV de origem tiver mudado desde a gravação.
+ * Nenhum registro é analisado: as colunas apontam diretamente para o mapeamento.
+ * 
+ * Retorna 0 em caso de sucesso ou -1 se o snapshot não existir ou for inválido.
+ */
+int snapshot_abre(const char *nome_arquivo, const char *csv_origem, Snapshot *snapshot) {
+    memset(snapshot, 0, sizeof(Snapshot));
+
+    int fd = open(nome_arquivo, O_RDONLY);
+    if (fd == -1) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(CabecalhoSnapshot)) {
+        close(fd);
+        return -1;
+    }
+    size_t tamanho = (size_t)st.st_size;
+    void *mapa = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        return -1;
+    }
+    snapshot->mapa = mapa;
+    snapshot->tamanho = tamanho;
+
+    // Valida o cabeçalho
+    const CabecalhoSnapshot *cabecalho = mapa;
+    unsigned long long tamanho_origem;
+    long long modificacao_origem;
+    unsigned long long n = cabecalho->registros;
+    size_t esperado = alinha8(n * sizeof(int)) * 2 + n * sizeof(long long) + n * SNAPSHOT_LARGURA_NUMERO
+        + 2 * (n + 1) * sizeof(long unsigned int)
+        + alinha8(cabecalho->total_classes * sizeof(int)) + alinha8(cabecalho->total_assuntos * sizeof(int))
+        + (n + 1) * sizeof(long unsigned int) + alinha8(cabecalho->total_texto);
+
+    if (memcmp(cabecalho->magica, SNAPSHOT_MAGICA, sizeof(cabecalho->magica)) != 0 ||
+        cabecalho->versao != SNAPSHOT_VERSAO ||
+        cabecalho->tamanho_cabecalho != sizeof(CabecalhoSnapshot) ||
+        cabecalho->tamanho_dados != tamanho - sizeof(CabecalhoSnapshot) ||
+        cabecalho->tamanho_dados != esperado ||
+        dados_origem(csv_origem, &tamanho_origem, &modificacao_origem) != 0 ||
+        (csv_origem != NULL && (tamanho_origem != cabecalho->tamanho_origem ||
+                                modificacao_origem != cabecalho->modificacao_origem))) {
+        snapshot_fecha(snapshot);
+        return -1;
+    }
+
+    // Valida a soma de verificação
+    const char *dados = (const char *)mapa + sizeof(CabecalhoSnapshot);
+    if (acumula_checksum(0xcbf29ce484222325ULL, dados, cabecalho->tamanho_dados) != cabecalho->checksum) {
+        snapshot_fecha(snapshot);
+        return -1;
+    }
+
+    // Aponta as colunas para o mapeamento
+    ProcessosColunar *c = &snapshot->colunar;
+    c->tamanho = n;
+    c->id = (int *)dados;
+    dados += alinha8(n * sizeof(int));
+    c->timestamp = (long long *)dados;
+    dados += n * sizeof(long long);
+    c->ano_eleicao = (int *)dados;
+    dados += alinha8(n * sizeof(int));
+    snapshot->numero = dados;
+    dados += n * SNAPSHOT_LARGURA_NUMERO;
+    c->classe_offset = (long unsigned int *)dados;
+    dados += (n + 1) * sizeof(long unsigned int);
+    c->classe_valores = (int *)dados;
+    dados += alinha8(cabecalho->total_classes * sizeof(int));
+    c->assunto_offset = (long unsigned int *)dados;
+    dados += (n + 1) * sizeof(long unsigned int);
+    c->assunto_valores = (int *)dados;
+    dados += alinha8(cabecalho->total_assuntos * sizeof(int));
+    snapshot->texto_offset = (const long unsigned int *)dados;
+    dados += (n + 1) * sizeof(long unsigned int);
+    snapshot->texto = dados;
+
+    // Verifica se os deslocamentos são consistentes com os tamanhos das listas
+    if (c->classe_offset[n] != cabecalho->total_classes || c->assunto_offset[n] != cabecalho->total_assuntos ||
+        snapshot->texto_offset[n] != cabecalho->total_texto) {
+        snapshot_fecha(snapshot);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * snapshot_fecha - Desfaz o mapeamento de um snapshot aberto.
+ */
+void snapshot_fecha(Snapshot *snapshot) {
+    if (snapshot->mapa != NULL) {
+        munmap(snapshot->mapa, snapshot->tamanho);
+    }
+    memset(snapshot, 0, sizeof(Snapshot));
+}
+
+/**
+ * copia_texto - Copia um campo da coluna `texto` para um campo de tamanho fixo do registro.
+ * 
+ * @p: Início do campo; a cópia nunca passa de `fim`, mesmo sem o '\0'.
+ * 
+ * Retorna o início do campo seguinte.
+ */
+static const char *copia_texto(const char *p, const char *fim, char *saida, size_t capacidade) {
+    size_t tamanho = strnlen(p, (size_t)(fim - p));
+    size_t copiado = tamanho < capacidade - 1 ? tamanho : capacidade - 1;
+
+    memcpy(saida, p, copiado);
+    saida[copiado] = '\0';
+    return p + tamanho + (tamanho < (size_t)(fim - p));
+}
+
+/**
+ * data_de_timestamp - Preenche os campos de `struct tm` como `parse_line` (ano completo, mês de 1 a 12).
+ */
+static void data_de_timestamp(long long timestamp, struct tm *data) {
+    long long segundos = timestamp / 1000 - (timestamp % 1000 < 0);
+    long long dias = segundos / 86400;
+    long long resto = segundos % 86400;
+    if (resto < 0) {
+        resto += 86400;
+        dias--;
+    }
+
+    memset(data, 0, sizeof(struct tm));
+    dias_para_data(dias, &data->tm_year, &data->tm_mon, &data->tm_mday);
+    data->tm_hour = (int)(resto / 3600);
+    data->tm_min = (int)(resto / 60 % 60);
+    data->tm_sec = (int)(resto % 60);
+}
+
+/**
+ * snapshot_para_processos - Reconstrói o array de `Processo` a partir de um snapshot aberto.
+ * 
+ * @snapshot: Snapshot aberto com `snapshot_abre`.
+ * @processos: Ponteiro para o array que será alocado e preenchido.
+ * @arena: Arena que passa a ser dona dos campos alocados dos registros.
+ * 
+ * Os campos em texto são copiados exatamente como estavam no CSV, de modo que um registro em forma
+ * não canônica (espaços nas listas, data com 'T') não muda depois da recarga. As listas de classes
+ * e assuntos e as datas são reservadas em um único bloco da arena cada; nenhum campo é analisado ou
+ * formatado, mas cada registro ainda é montado uma vez. O snapshot pode ser fechado depois.
+ * 
+ * Retorna o número de registros ou 0 se não houver memória.
+ */
+long unsigned int snapshot_para_processos(const Snapshot *snapshot, Processo **processos, Arena *arena) {
+    const ProcessosColunar *c = &snapshot->colunar;
+    long unsigned int n = c->tamanho;
+
+    *processos = malloc((n > 0 ? n : 1) * sizeof(Processo));
+    int *classes = arena_aloca(arena, (c->classe_offset[n] > 0 ? c->classe_offset[n] : 1) * sizeof(int));
+    int *assuntos = arena_aloca(arena, (c->assunto_offset[n] > 0 ? c->assunto_offset[n] : 1) * sizeof(int));
+    struct tm *datas = arena_aloca(arena, (n > 0 ? n : 1) * sizeof(struct tm));
+    if (*processos == NULL || classes == NULL || assuntos == NULL || datas == NULL) {
+        free(*processos);
+        *processos = NULL;
+        return 0;
+    }
+    memcpy(classes, c->classe_valores, c->classe_offset[n] * sizeof(int));
+    memcpy(assuntos, c->assunto_valores, c->assunto_offset[n] * sizeof(int));
+
+    for (long unsigned int i = 0; i < n; i++) {
+        Processo *p = &(*processos)[i];
+        long unsigned int classe_len = c->classe_offset[i + 1] - c->classe_offset[i];
+        long unsigned int assunto_len = c->assunto_offset[i + 1] - c->assunto_offset[i];
+
+        p->id = c->id[i];
+        p->ano_eleicao = c->ano_eleicao[i];
+        p->timestamp = c->timestamp[i];
+        const char *numero = &snapshot->numero[i * SNAPSHOT_LARGURA_NUMERO];
+        numero_compacta(numero, numero + strnlen(numero, SNAPSHOT_LARGURA_NUMERO), &p->numero, arena);
+
+        p->classe_len = (int)classe_len;
+        p->classe = classe_len > 0 ? &classes[c->classe_offset[i]] : NULL;
+        p->assunto_len = (int)assunto_len;
+        p->assunto = assunto_len > 0 ? &assuntos[c->assunto_offset[i]] : NULL;
+
+        const char *texto = snapshot->texto + snapshot->texto_offset[i];
+        const char *fim = snapshot->texto + snapshot->texto_offset[i + 1];
+        if (snapshot->texto_offset[i + 1] < snapshot->texto_offset[i] ||
+            snapshot->texto_offset[i + 1] > snapshot->texto_offset[n]) {
+            fim = texto;
+        }
+        texto = copia_texto(texto, fim, p->data_string, sizeof(p->data_string));
+        texto = copia_texto(texto, fim, p->classe_string, sizeof(p->classe_string));
+        copia_texto(texto, fim, p->assunto_string, sizeof(p->assunto_string));
+
+        p->data = &datas[i];
+        data_de_timestamp(p->timestamp, p->data);
+    }
+    return n;
+}
+
+/**
+ * carrega_base - Carrega a base a partir do snapshot ou, se ele for inválido, do CSV.
+ * 
+ * @csv: Nome do arquivo CSV.
+ * @nome_snapshot: Nome do snapshot correspondente.
+ * @processos: Ponteiro para o array que será alocado e preenchido.
+ * @arena: Arena que passa a ser dona dos campos alocados dos registros.
+ * @num_threads: Threads usadas na leitura do CSV (ver `read_csv_paralelo`).
+ * @stats: Estrutura que receberá linhas, bytes e tempo da carga (pode ser NULL).
+ * 
+ * Quando o snapshot não existe, está corrompido ou é mais antigo que o CSV, o CSV é lido
+ * normalmente e um novo snapshot é gravado para as próximas execuções.
+ * 
+ * Retorna o número de registros lidos ou 1 em caso de erro ao abrir o CSV.
+ */
+long unsigned int carrega_base(const char *csv, const char *nome_snapshot, Processo **processos, Arena *arena,
+                               int num_threads, EstatisticasLeitura *stats) {
+    double inicio = agora_segundos();
+    long long medicao = metricas_inicio();
+    Snapshot snapshot;
+
+    if (snapshot_abre(nome_snapshot, csv, &snapshot) == 0) {
+        long unsigned int count = snapshot_para_processos(&snapshot, processos, arena);
+        metricas_registra(METRICA_LEITURA, medicao, count);
+        if (stats != NULL) {
+            stats->linhas = count;
+            stats->bytes = snapshot.tamanho;
+            stats->segundos = agora_segundos() - inicio;
+        }
+        snapshot_fecha(&snapshot);
+        return count;
+    }
+
+    *processos = NULL;
+    long unsigned int count = read_csv_paralelo(csv, processos, arena, num_threads, stats);
+    if (*processos != NULL && snapshot_salva(nome_snapshot, *processos, count, csv) != 0) {
+        printf("Erro ao gravar o snapshot %s.\n", nome_snapshot);
+    }
+    return count;
+}
@@ -0,0 +1,51 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "processo.h"
+#include "colunar.h"
+
+// Identificação e versão do formato binário
+#define SNAPSHOT_MAGICA "PROCSNAP"
+#define SNAPSHOT_VERSAO 2
+
+// Largura fixa da coluna `numero` no arquivo
+#define SNAPSHOT_LARGURA_NUMERO 32
+
+// Cabeçalho do snapshot (inteiros na ordem de bytes da máquina que o gerou).
+// Após o cabeçalho vêm as colunas, cada uma alinhada a 8 bytes:
+// id, timestamp, ano_eleicao, numero, classe_offset, classe_valores, assunto_offset, assunto_valores,
+// texto_offset e texto. O registro i tem em texto[texto_offset[i], texto_offset[i+1]) os textos originais
+// de data_string, classe_string e assunto_string, cada um terminado por '\0'.
+typedef struct {
+    char magica[8];                         // SNAPSHOT_MAGICA (sem '\0')
+    unsigned int versao;                    // SNAPSHOT_VERSAO
+    unsigned int tamanho_cabecalho;         // sizeof(CabecalhoSnapshot)
+    unsigned long long registros;           // Número de registros
+    unsigned long long total_classes;       // Tamanho de classe_valores
+    unsigned long long total_assuntos;      // Tamanho de assunto_valores
+    unsigned long long total_texto;         // Tamanho de texto, em bytes
+    unsigned long long tamanho_origem;      // Tamanho do CSV de origem (0 se desconhecido)
+    long long modificacao_origem;           // Data de modificação do CSV de origem
+    unsigned long long tamanho_dados;       // Bytes após o cabeçalho
+    unsigned long long checksum;            // Soma de verificação dos bytes após o cabeçalho
+} CabecalhoSnapshot;
+
+// Snapshot aberto: as colunas apontam diretamente para o arquivo mapeado em memória
+typedef struct {
+    void *mapa;                             // Início do mapeamento
+    size_t tamanho;                         // Tamanho do mapeamento
+    ProcessosColunar colunar;               // Colunas (somente leitura; não usar `colunar_libera`)
+    const char *numero;                     // registros * SNAPSHOT_LARGURA_NUMERO bytes
+    const long unsigned int *texto_offset;  // registros + 1 posições
+    const char *texto;                      // Textos originais de cada registro
+} Snapshot;
+
+unsigned long long acumula_checksum(unsigned long long checksum, const void *dados, size_t tamanho);
+int snapshot_salva(const char *nome_arquivo, const Processo *processos, long unsigned int processos_size,
+                   const char *csv_origem);
+int snapshot_abre(const char *nome_arquivo, const char *csv_origem, Snapshot *snapshot);
+void snapshot_fecha(Snapshot *snapshot);
+long unsigned int snapshot_para_processos(const Snapshot *snapshot, Processo **processos, Arena *arena);
+long unsigned int carrega_base(const char *csv, const char *nome_snapshot, Processo **processos, Arena *arena,
+                               int num_threads, EstatisticasLeitura *stats);
+#endif